@@ -268,6 +268,14 @@ else
   endif
 endif
 
+EEPROM_WRITE_CACHE_ENABLE ?= no
+ifeq ($(strip $(EEPROM_WRITE_CACHE_ENABLE)), yes)
+  ifeq ($(filter $(EEPROM_DRIVER),i2c spi transient),)
+    $(call CATASTROPHIC_ERROR,Invalid EEPROM_WRITE_CACHE_ENABLE,EEPROM_WRITE_CACHE_ENABLE is only supported by the i2c, spi and transient EEPROM drivers)
+  endif
+  OPT_DEFS += -DEEPROM_WRITE_CACHE_ENABLE
+endif
+
 VALID_WEAR_LEVELING_DRIVER_TYPES := custom embedded_flash spi_flash rp2040_flash legacy
 WEAR_LEVELING_DRIVER ?= none
 ifneq ($(strip $(WEAR_LEVELING_DRIVER)),none)
@@ -326,6 +334,7 @@ ifeq ($(strip $(RGBLIGHT_ENABLE)), yes)
         $(call CATASTROPHIC_ERROR,Invalid RGBLIGHT_DRIVER,RGBLIGHT_DRIVER="$(RGBLIGHT_DRIVER)" is not a valid RGB type)
     else
         COMMON_VPATH += $(QUANTUM_DIR)/rgblight
+        COMMON_VPATH += $(QUANTUM_DIR)/lighting
         POST_CONFIG_H += $(QUANTUM_DIR)/rgblight/rgblight_post_config.h
         OPT_DEFS += -DRGBLIGHT_ENABLE
         SRC += $(QUANTUM_DIR)/color.c
@@ -363,6 +372,8 @@ endif
     COMMON_VPATH += $(QUANTUM_DIR)/led_matrix
     COMMON_VPATH += $(QUANTUM_DIR)/led_matrix/animations
     COMMON_VPATH += $(QUANTUM_DIR)/led_matrix/animations/runners
+    COMMON_VPATH += $(QUANTUM_DIR)/lighting
+    COMMON_VPATH += $(QUANTUM_DIR)/lighting/runners
     POST_CONFIG_H += $(QUANTUM_DIR)/led_matrix/post_config.h
     SRC += $(QUANTUM_DIR)/process_keycode/process_backlight.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix.c
@@ -429,6 +440,8 @@ endif
     COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix
     COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix/animations
     COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix/animations/runners
+    COMMON_VPATH += $(QUANTUM_DIR)/lighting
+    COMMON_VPATH += $(QUANTUM_DIR)/lighting/runners
     POST_CONFIG_H += $(QUANTUM_DIR)/rgb_matrix/post_config.h
     SRC += $(QUANTUM_DIR)/color.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix.c
@@ -546,6 +559,14 @@ ifneq ($(strip $(VARIABLE_TRACE)),no)
     endif
 endif
 
+ifeq ($(strip $(IDLE_SLEEP_ENABLE)), yes)
+    ifneq ($(PLATFORM_KEY),chibios)
+        $(call CATASTROPHIC_ERROR,Invalid IDLE_SLEEP_ENABLE,IDLE_SLEEP_ENABLE is only supported on ChibiOS)
+    endif
+    SRC += $(PLATFORM_COMMON_DIR)/idle.c
+    OPT_DEFS += -DIDLE_SLEEP_ENABLE
+endif
+
 ifeq ($(strip $(SLEEP_LED_ENABLE)), yes)
     SRC += $(PLATFORM_COMMON_DIR)/sleep_led.c
     OPT_DEFS += -DSLEEP_LED_ENABLE
@@ -77,3 +77,207 @@ void eeprom_update_dword(uint32_t *addr, uint32_t value) {
         eeprom_write_dword(addr, value);
     }
 }
+
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+/*
+    Write-back cache.
+
+    Writes are coalesced into RAM pages, tracking which bytes are dirty. Pages
+    are flushed to the backend from eeprom_driver_task(), one at a time and
+    only once the backend reports that it's no longer busy with a previous
+    write, so the caller never has to wait for the EEPROM's write cycle.
+    Reads are serviced from the backend, with any dirty bytes overlaid on top.
+*/
+
+#    include "timer.h"
+#    include "util.h"
+
+typedef struct eeprom_cache_page_t {
+    uintptr_t address;                                       // page-aligned offset within the EEPROM
+    uint32_t  sequence;                                      // when the page was first dirtied, oldest is flushed first
+    uint16_t  dirty_count;                                   // number of dirty bytes, page is free if zero
+    uint8_t   dirty[(EEPROM_WRITE_CACHE_PAGE_SIZE + 7) / 8]; // bitmap of dirty bytes
+    uint8_t   data[EEPROM_WRITE_CACHE_PAGE_SIZE];
+} eeprom_cache_page_t;
+
+static eeprom_cache_page_t cache_pages[EEPROM_WRITE_CACHE_PAGE_COUNT];
+static uint32_t            cache_sequence   = 0;
+static uint32_t            cache_last_flush = 0;
+
+static inline bool cache_byte_is_dirty(const eeprom_cache_page_t *page, uint16_t offset) {
+    return (page->dirty[offset / 8] & (1 << (offset % 8))) != 0;
+}
+
+static eeprom_cache_page_t *cache_find_page(uintptr_t page_address) {
+    for (int i = 0; i < EEPROM_WRITE_CACHE_PAGE_COUNT; ++i) {
+        if (cache_pages[i].dirty_count > 0 && cache_pages[i].address == page_address) {
+            return &cache_pages[i];
+        }
+    }
+    return NULL;
+}
+
+static eeprom_cache_page_t *cache_oldest_page(void) {
+    eeprom_cache_page_t *oldest = NULL;
+    for (int i = 0; i < EEPROM_WRITE_CACHE_PAGE_COUNT; ++i) {
+        if (cache_pages[i].dirty_count > 0 && (!oldest || (int32_t)(cache_pages[i].sequence - oldest->sequence) < 0)) {
+            oldest = &cache_pages[i];
+        }
+    }
+    return oldest;
+}
+
+static void cache_flush_page(eeprom_cache_page_t *page) {
+    // Work out the extent of the dirty bytes
+    uint16_t first = 0, last = EEPROM_WRITE_CACHE_PAGE_SIZE - 1;
+    while (!cache_byte_is_dirty(page, first)) {
+        ++first;
+    }
+    while (!cache_byte_is_dirty(page, last)) {
+        --last;
+    }
+    uint16_t length = last - first + 1;
+
+    // Fill in any clean bytes in between from the backend, so the whole extent can be written in one go
+    if (length != page->dirty_count) {
+        uint8_t fill[EEPROM_WRITE_CACHE_PAGE_SIZE];
+        eeprom_driver_backend_read_block(&fill[first], (const void *)(page->address + first), length);
+        for (uint16_t i = first; i <= last; ++i) {
+            if (!cache_byte_is_dirty(page, i)) {
+                page->data[i] = fill[i];
+            }
+        }
+    }
+
+    eeprom_driver_backend_write_block(&page->data[first], (void *)(page->address + first), length);
+    memset(page->dirty, 0, sizeof(page->dirty));
+    page->dirty_count = 0;
+}
+
+static eeprom_cache_page_t *cache_allocate_page(uintptr_t page_address) {
+    eeprom_cache_page_t *page = NULL;
+    for (int i = 0; i < EEPROM_WRITE_CACHE_PAGE_COUNT; ++i) {
+        if (cache_pages[i].dirty_count == 0) {
+            page = &cache_pages[i];
+            break;
+        }
+    }
+
+    // No free pages, so the oldest page has to be written out immediately
+    if (!page) {
+        page = cache_oldest_page();
+        cache_flush_page(page);
+    }
+
+    page->address  = page_address;
+    page->sequence = cache_sequence++;
+    return page;
+}
+
+__attribute__((weak)) bool eeprom_driver_backend_is_busy(void) {
+    return false;
+}
+
+void eeprom_driver_init(void) {
+    memset(cache_pages, 0, sizeof(cache_pages));
+    eeprom_driver_backend_init();
+}
+
+void eeprom_driver_erase(void) {
+    // Pending writes are discarded, as they'd be erased anyway
+    memset(cache_pages, 0, sizeof(cache_pages));
+    eeprom_driver_backend_erase();
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    uint8_t * dst     = (uint8_t *)buf;
+    uintptr_t address = (uintptr_t)addr;
+
+    // Only go to the backend if the cache can't satisfy the whole read
+    bool   covered   = true;
+    size_t remaining = len;
+    for (uintptr_t p = address; covered && remaining > 0;) {
+        uint16_t             offset = p % EEPROM_WRITE_CACHE_PAGE_SIZE;
+        uint16_t             count  = MIN(remaining, (size_t)(EEPROM_WRITE_CACHE_PAGE_SIZE - offset));
+        eeprom_cache_page_t *page   = cache_find_page(p - offset);
+        for (uint16_t i = 0; i < count; ++i) {
+            if (!page || !cache_byte_is_dirty(page, offset + i)) {
+                covered = false;
+                break;
+            }
+        }
+        p += count;
+        remaining -= count;
+    }
+
+    if (!covered) {
+        eeprom_driver_backend_read_block(buf, addr, len);
+    }
+
+    // Overlay any pending writes
+    remaining = len;
+    for (uintptr_t p = address; remaining > 0;) {
+        uint16_t             offset = p % EEPROM_WRITE_CACHE_PAGE_SIZE;
+        uint16_t             count  = MIN(remaining, (size_t)(EEPROM_WRITE_CACHE_PAGE_SIZE - offset));
+        eeprom_cache_page_t *page   = cache_find_page(p - offset);
+        if (page) {
+            for (uint16_t i = 0; i < count; ++i) {
+                if (cache_byte_is_dirty(page, offset + i)) {
+                    dst[p - address + i] = page->data[offset + i];
+                }
+            }
+        }
+        p += count;
+        remaining -= count;
+    }
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *src     = (const uint8_t *)buf;
+    uintptr_t      address = (uintptr_t)addr;
+
+    for (uintptr_t p = address; len > 0;) {
+        uint16_t             offset = p % EEPROM_WRITE_CACHE_PAGE_SIZE;
+        uint16_t             count  = MIN(len, (size_t)(EEPROM_WRITE_CACHE_PAGE_SIZE - offset));
+        eeprom_cache_page_t *page   = cache_find_page(p - offset);
+        if (!page) {
+            page = cache_allocate_page(p - offset);
+        }
+
+        for (uint16_t i = 0; i < count; ++i) {
+            page->data[offset + i] = src[p - address + i];
+            if (!cache_byte_is_dirty(page, offset + i)) {
+                page->dirty[(offset + i) / 8] |= 1 << ((offset + i) % 8);
+                page->dirty_count++;
+            }
+        }
+        p += count;
+        len -= count;
+    }
+}
+
+void eeprom_driver_task(void) {
+    if (timer_elapsed32(cache_last_flush) < EEPROM_WRITE_CACHE_FLUSH_INTERVAL) {
+        return;
+    }
+
+    eeprom_cache_page_t *page = cache_oldest_page();
+    if (!page || eeprom_driver_backend_is_busy()) {
+        return;
+    }
+
+    cache_flush_page(page);
+    cache_last_flush = timer_read32();
+}
+
+void eeprom_driver_flush(void) {
+    eeprom_cache_page_t *page;
+    while ((page = cache_oldest_page()) != NULL) {
+        cache_flush_page(page);
+    }
+}
+
+bool eeprom_driver_is_dirty(void) {
+    return cache_oldest_page() != NULL;
+}
+#endif // EEPROM_WRITE_CACHE_ENABLE
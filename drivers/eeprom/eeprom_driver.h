@@ -16,7 +16,65 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 #include "eeprom.h"
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+/*
+    The number of pages held by the write-back cache. Writes are coalesced in
+    RAM and flushed to the EEPROM one page at a time from eeprom_driver_task().
+    Writing to an uncached page whilst all pages are dirty forces a synchronous
+    flush of the oldest page.
+*/
+#    ifndef EEPROM_WRITE_CACHE_PAGE_COUNT
+#        define EEPROM_WRITE_CACHE_PAGE_COUNT 8
+#    endif
+
+/*
+    The size of each cached page, in bytes. Defaults to the page size of the
+    EEPROM if known, as a flush can then never span multiple EEPROM pages.
+*/
+#    ifndef EEPROM_WRITE_CACHE_PAGE_SIZE
+#        if defined(EXTERNAL_EEPROM_PAGE_SIZE)
+#            define EEPROM_WRITE_CACHE_PAGE_SIZE EXTERNAL_EEPROM_PAGE_SIZE
+#        elif defined(TRANSIENT_EEPROM_PAGE_SIZE)
+#            define EEPROM_WRITE_CACHE_PAGE_SIZE TRANSIENT_EEPROM_PAGE_SIZE
+#        else
+#            define EEPROM_WRITE_CACHE_PAGE_SIZE 32
+#        endif
+#    endif
+
+/*
+    The minimum amount of time, in milliseconds, between background page
+    flushes.
+*/
+#    ifndef EEPROM_WRITE_CACHE_FLUSH_INTERVAL
+#        define EEPROM_WRITE_CACHE_FLUSH_INTERVAL 10
+#    endif
+
+void eeprom_driver_task(void);
+void eeprom_driver_flush(void);
+bool eeprom_driver_is_dirty(void);
+
+/*
+    Backends supporting the write-back cache define EEPROM_DRIVER_BACKEND before
+    including this file, which renames their implementations so they sit
+    underneath the cache in eeprom_driver.c.
+*/
+#    ifdef EEPROM_DRIVER_BACKEND
+#        define eeprom_driver_init eeprom_driver_backend_init
+#        define eeprom_driver_erase eeprom_driver_backend_erase
+#        define eeprom_read_block eeprom_driver_backend_read_block
+#        define eeprom_write_block eeprom_driver_backend_write_block
+#    endif
+
+void eeprom_driver_backend_init(void);
+void eeprom_driver_backend_erase(void);
+void eeprom_driver_backend_read_block(void *buf, const void *addr, size_t len);
+void eeprom_driver_backend_write_block(const void *buf, void *addr, size_t len);
+bool eeprom_driver_backend_is_busy(void);
+#endif // EEPROM_WRITE_CACHE_ENABLE
@@ -38,6 +38,10 @@
 #include "eeprom.h"
 #include "eeprom_i2c.h"
 
+// Sits underneath the write-back cache in eeprom_driver.c, if enabled
+#define EEPROM_DRIVER_BACKEND
+#include "eeprom_driver.h"
+
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
@@ -53,6 +57,39 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+#    include "timer.h"
+
+// Whether the EEPROM may still be within its write cycle, and which address was last written
+static bool      write_pending      = false;
+static uintptr_t write_pending_addr = 0;
+
+bool eeprom_driver_backend_is_busy(void) {
+    if (!write_pending) {
+        return false;
+    }
+
+    // The EEPROM doesn't acknowledge its address until the write cycle has completed
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    fill_target_address(complete_packet, (const void *)write_pending_addr);
+    if (i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(write_pending_addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 10) == I2C_STATUS_SUCCESS) {
+        write_pending = false;
+    }
+    return write_pending;
+}
+
+static void eeprom_i2c_wait_while_busy(void) {
+    uint32_t start = timer_read32();
+    while (eeprom_driver_backend_is_busy()) {
+        // Give up on acknowledge polling after the worst-case write time, as per the original behaviour
+        if (timer_elapsed32(start) > EXTERNAL_EEPROM_WRITE_TIME) {
+            write_pending = false;
+            break;
+        }
+    }
+}
+#endif // EEPROM_WRITE_CACHE_ENABLE
+
 void eeprom_driver_init(void) {
     i2c_init();
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -82,6 +119,10 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
     fill_target_address(complete_packet, addr);
 
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+    eeprom_i2c_wait_while_busy();
+#endif
+
     i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
     i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
 
@@ -124,8 +165,16 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
         dprintf("\n");
 #endif // DEBUG_EEPROM_OUTPUT
 
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+        // Rather than sleeping after each page, poll for the previous write cycle to complete before starting the next
+        eeprom_i2c_wait_while_busy();
+        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
+        write_pending      = (EXTERNAL_EEPROM_WRITE_TIME) > 0;
+        write_pending_addr = target_addr;
+#else
         i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
         wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+#endif
 
         read_buf += write_length;
         target_addr += write_length;
@@ -37,6 +37,10 @@
 #include "eeprom.h"
 #include "eeprom_spi.h"
 
+// Sits underneath the write-back cache in eeprom_driver.c, if enabled
+#define EEPROM_DRIVER_BACKEND
+#include "eeprom_driver.h"
+
 #define CMD_WREN 6
 #define CMD_WRDI 4
 #define CMD_RDSR 5
@@ -88,6 +92,20 @@ static void spi_eeprom_transmit_address(uintptr_t addr) {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+bool eeprom_driver_backend_is_busy(void) {
+    if (!spi_eeprom_start()) {
+        spi_stop();
+        return true;
+    }
+
+    spi_write(CMD_RDSR);
+    spi_status_t response = spi_read();
+    spi_stop();
+    return response < 0 || (response & SR_WIP);
+}
+#endif // EEPROM_WRITE_CACHE_ENABLE
+
 void eeprom_driver_init(void) {
     spi_init();
 }
@@ -17,8 +17,16 @@
 #include <stdint.h>
 #include <string.h>
 
+// Sits underneath the write-back cache in eeprom_driver.c, if enabled
+#define EEPROM_DRIVER_BACKEND
 #include "eeprom_driver.h"
 #include "eeprom_transient.h"
+#include "util.h"
+
+#if (TRANSIENT_EEPROM_WRITE_TIME) > 0
+#    include "timer.h"
+#    include "wait.h"
+#endif
 
 __attribute__((aligned(4))) static uint8_t transientBuffer[TRANSIENT_EEPROM_SIZE] = {0};
 
@@ -30,11 +38,40 @@ size_t clamp_length(intptr_t offset, size_t len) {
     return len;
 }
 
+#if (TRANSIENT_EEPROM_WRITE_TIME) > 0
+// Simulates the write cycle of a real EEPROM, which is unresponsive until the write completes
+static bool     write_in_progress = false;
+static uint32_t write_start       = 0;
+
+static bool transient_is_busy(void) {
+    if (write_in_progress && timer_elapsed32(write_start) >= (TRANSIENT_EEPROM_WRITE_TIME)) {
+        write_in_progress = false;
+    }
+    return write_in_progress;
+}
+
+static void transient_wait_while_busy(void) {
+    while (transient_is_busy()) {
+        wait_ms(1);
+    }
+}
+
+static void transient_begin_write(void) {
+    write_in_progress = true;
+    write_start       = timer_read32();
+}
+#else
+#    define transient_is_busy() false
+#    define transient_wait_while_busy()
+#    define transient_begin_write()
+#endif
+
 void eeprom_driver_init(void) {
     eeprom_driver_erase();
 }
 
 void eeprom_driver_erase(void) {
+    transient_wait_while_busy();
     memset(transientBuffer, 0x00, TRANSIENT_EEPROM_SIZE);
 }
 
@@ -42,15 +79,32 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     intptr_t offset = (intptr_t)addr;
     memset(buf, 0x00, len);
     len = clamp_length(offset, len);
+    transient_wait_while_busy();
     if (len > 0) {
         memcpy(buf, &transientBuffer[offset], len);
     }
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    intptr_t offset = (intptr_t)addr;
-    len             = clamp_length(offset, len);
-    if (len > 0) {
-        memcpy(&transientBuffer[offset], buf, len);
+    const uint8_t *src    = (const uint8_t *)buf;
+    intptr_t       offset = (intptr_t)addr;
+    len                   = clamp_length(offset, len);
+    while (len > 0) {
+        size_t write_length = MIN(len, (size_t)(TRANSIENT_EEPROM_PAGE_SIZE - (offset % TRANSIENT_EEPROM_PAGE_SIZE)));
+        transient_wait_while_busy();
+        memcpy(&transientBuffer[offset], src, write_length);
+        transient_begin_write();
+#ifndef EEPROM_WRITE_CACHE_ENABLE
+        transient_wait_while_busy();
+#endif
+        src += write_length;
+        offset += write_length;
+        len -= write_length;
     }
 }
+
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+bool eeprom_driver_backend_is_busy(void) {
+    return transient_is_busy();
+}
+#endif
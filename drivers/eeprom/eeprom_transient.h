@@ -23,3 +23,19 @@
 #    include "eeconfig.h"
 #    define TRANSIENT_EEPROM_SIZE (((EECONFIG_SIZE + 3) / 4) * 4) // based off eeconfig's current usage, aligned to 4-byte sizes, to deal with LTO
 #endif
+
+/*
+    The simulated write cycle time of the transient EEPROM, in milliseconds.
+    Each page written leaves the EEPROM busy for this long, as per a real
+    external EEPROM. Defaults to zero, i.e. writes complete immediately.
+*/
+#ifndef TRANSIENT_EEPROM_WRITE_TIME
+#    define TRANSIENT_EEPROM_WRITE_TIME 0
+#endif
+
+/*
+    The simulated page size of the transient EEPROM, in bytes.
+*/
+#ifndef TRANSIENT_EEPROM_PAGE_SIZE
+#    define TRANSIENT_EEPROM_PAGE_SIZE 32
+#endif
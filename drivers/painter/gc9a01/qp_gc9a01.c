@@ -106,9 +106,11 @@ const tft_panel_dc_reset_painter_driver_vtable_t gc9a01_driver_vtable = {
             .palette_convert = qp_tft_panel_palette_convert_rgb565_swapped,
             .append_pixels   = qp_tft_panel_append_pixels_rgb565,
             .append_pixdata  = qp_tft_panel_append_pixdata,
+            .scroll          = qp_tft_panel_scroll,
         },
     .num_window_bytes   = 2,
     .swap_window_coords = false,
+    .gram_height        = 240,
     .opcodes =
         {
             .display_on         = GC9A01_CMD_DISPLAY_ON,
@@ -116,6 +118,8 @@ const tft_panel_dc_reset_painter_driver_vtable_t gc9a01_driver_vtable = {
             .set_column_address = GC9A01_SET_COL_ADDR,
             .set_row_address    = GC9A01_SET_PAGE_ADDR,
             .enable_writes      = GC9A01_SET_MEM,
+            .set_scroll_area    = GC9A01_SET_VSCROLL,
+            .set_scroll_start   = GC9A01_SET_VSCROLL_ADDR,
         },
 };
 
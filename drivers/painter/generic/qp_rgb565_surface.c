@@ -55,31 +55,66 @@ static inline void increment_pixdata_location(rgb565_surface_painter_device_t *s
     }
 }
 
+static inline void mark_dirty(rgb565_surface_painter_device_t *surface, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    // Maintain dirty region
+    if (surface->dirty_l > left) {
+        surface->dirty_l = left;
+    }
+    if (surface->dirty_r < right) {
+        surface->dirty_r = right;
+    }
+    if (surface->dirty_t > top) {
+        surface->dirty_t = top;
+    }
+    if (surface->dirty_b < bottom) {
+        surface->dirty_b = bottom;
+    }
+
+    // Always dirty after a modification
+    surface->is_dirty = true;
+}
+
 static inline void setpixel(rgb565_surface_painter_device_t *surface, uint16_t x, uint16_t y, uint16_t rgb565) {
     // Skip messing with the dirty info if the original value already matches
     if (surface->buffer[y * surface->base.panel_width + x] != rgb565) {
-        // Maintain dirty region
-        if (surface->dirty_l > x) {
-            surface->dirty_l = x;
-        }
-        if (surface->dirty_r < x) {
-            surface->dirty_r = x;
-        }
-        if (surface->dirty_t > y) {
-            surface->dirty_t = y;
-        }
-        if (surface->dirty_b < y) {
-            surface->dirty_b = y;
-        }
-
-        // Always dirty after a setpixel
-        surface->is_dirty = true;
+        mark_dirty(surface, x, y, x, y);
 
         // Update the pixel data in the buffer
         surface->buffer[y * surface->base.panel_width + x] = rgb565;
     }
 }
 
+// Two pixels at a time, allowed to alias the uint16_t framebuffer
+typedef uint32_t __attribute__((__may_alias__)) rgb565_pair_t;
+
+// Fills a horizontal run of pixels, returning whether any of them changed
+static inline bool fill_span(uint16_t *target, uint16_t count, uint16_t rgb565) {
+    uint16_t changed = 0;
+
+    // Align to a 32-bit boundary so that the bulk of the span can be written a word at a time
+    if (count > 0 && ((uintptr_t)target & 2)) {
+        changed |= *target ^ rgb565;
+        *target++ = rgb565;
+        --count;
+    }
+
+    rgb565_pair_t *target32  = (rgb565_pair_t *)target;
+    rgb565_pair_t  pair      = ((uint32_t)rgb565 << 16) | rgb565;
+    rgb565_pair_t  changed32 = 0;
+    for (uint16_t i = 0; i < count / 2; ++i) {
+        changed32 |= target32[i] ^ pair;
+        target32[i] = pair;
+    }
+
+    // Trailing pixel, if any
+    if (count & 1) {
+        changed |= target[count - 1] ^ rgb565;
+        target[count - 1] = rgb565;
+    }
+
+    return changed || changed32;
+}
+
 static inline void append_pixel(rgb565_surface_painter_device_t *surface, uint16_t rgb565) {
     setpixel(surface, surface->pixdata_x, surface->pixdata_y, rgb565);
     increment_pixdata_location(surface);
@@ -145,6 +180,60 @@ static bool qp_rgb565_surface_pixdata(painter_device_t device, const void *pixel
     return true;
 }
 
+// Fill a region with a single native pixel
+static bool qp_rgb565_surface_fill(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, const void *native_pixel) {
+    painter_driver_t *               driver  = (painter_driver_t *)device;
+    rgb565_surface_painter_device_t *surface = (rgb565_surface_painter_device_t *)driver;
+
+    // Clip to the surface
+    if (left >= driver->panel_width || top >= driver->panel_height) {
+        return true;
+    }
+    right  = QP_MIN(right, driver->panel_width - 1);
+    bottom = QP_MIN(bottom, driver->panel_height - 1);
+
+    uint16_t rgb565  = *(const uint16_t *)native_pixel;
+    bool     changed = false;
+    for (uint16_t y = top; y <= bottom; ++y) {
+        changed |= fill_span(&surface->buffer[y * driver->panel_width + left], right - left + 1, rgb565);
+    }
+
+    if (changed) {
+        mark_dirty(surface, left, top, right, bottom);
+    }
+    return true;
+}
+
+// Copy a region to another location within the surface
+static bool qp_rgb565_surface_copy(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint16_t dest_x, uint16_t dest_y) {
+    painter_driver_t *               driver  = (painter_driver_t *)device;
+    rgb565_surface_painter_device_t *surface = (rgb565_surface_painter_device_t *)driver;
+
+    // Clip both the source and destination to the surface
+    if (left >= driver->panel_width || top >= driver->panel_height || dest_x >= driver->panel_width || dest_y >= driver->panel_height) {
+        return true;
+    }
+    uint16_t w = QP_MIN(right - left + 1, QP_MIN(driver->panel_width - left, driver->panel_width - dest_x));
+    uint16_t h = QP_MIN(bottom - top + 1, QP_MIN(driver->panel_height - top, driver->panel_height - dest_y));
+
+    // Walk the rows in whichever direction avoids overwriting source rows before they've been copied
+    bool changed = false;
+    for (uint16_t i = 0; i < h; ++i) {
+        uint16_t  row = (dest_y > top) ? (h - 1 - i) : i;
+        uint16_t *src = &surface->buffer[(top + row) * driver->panel_width + left];
+        uint16_t *dst = &surface->buffer[(dest_y + row) * driver->panel_width + dest_x];
+        if (memcmp(src, dst, w * sizeof(uint16_t)) != 0) {
+            memmove(dst, src, w * sizeof(uint16_t));
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        mark_dirty(surface, dest_x, dest_y, dest_x + w - 1, dest_y + h - 1);
+    }
+    return true;
+}
+
 // Pixel colour conversion
 static bool qp_rgb565_surface_palette_convert_rgb565_swapped(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
     for (int16_t i = 0; i < palette_size; ++i) {
@@ -180,6 +269,8 @@ const painter_driver_vtable_t rgb565_surface_driver_vtable = {
     .palette_convert = qp_rgb565_surface_palette_convert_rgb565_swapped,
     .append_pixels   = qp_rgb565_surface_append_pixels_rgb565,
     .append_pixdata  = qp_rgb565_surface_append_pixdata,
+    .fill            = qp_rgb565_surface_fill,
+    .copy            = qp_rgb565_surface_copy,
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -230,6 +321,35 @@ painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_hei
     return NULL;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Direct framebuffer access
+
+void *qp_rgb565_surface_get_buffer(painter_device_t surface) {
+    painter_driver_t *driver = (painter_driver_t *)surface;
+    if (!driver || driver->driver_vtable != &rgb565_surface_driver_vtable) {
+        return NULL;
+    }
+    return ((rgb565_surface_painter_device_t *)driver)->buffer;
+}
+
+bool qp_rgb565_surface_mark_dirty(painter_device_t surface, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    painter_driver_t *driver = (painter_driver_t *)surface;
+    if (!driver || driver->driver_vtable != &rgb565_surface_driver_vtable) {
+        return false;
+    }
+
+    uint16_t l = QP_MIN(left, right);
+    uint16_t r = QP_MIN(QP_MAX(left, right), driver->panel_width - 1);
+    uint16_t t = QP_MIN(top, bottom);
+    uint16_t b = QP_MIN(QP_MAX(top, bottom), driver->panel_height - 1);
+    if (l > r || t > b) {
+        return false;
+    }
+
+    mark_dirty((rgb565_surface_painter_device_t *)driver, l, t, r, b);
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Drawing routine to copy out the dirty region and send it to another device
 
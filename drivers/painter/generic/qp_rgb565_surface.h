@@ -39,4 +39,24 @@ painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_hei
  * @return whether the draw operation completed successfully
  */
 bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y);
+
+/**
+ * Retrieves the framebuffer backing an RGB565 surface, allowing for it to be rendered into directly.
+ *
+ * @param surface[in] the surface to query
+ * @return pointer to the framebuffer, or NULL if the device is not an RGB565 surface
+ */
+void *qp_rgb565_surface_get_buffer(painter_device_t surface);
+
+/**
+ * Marks a region of an RGB565 surface as dirty, after its framebuffer has been modified directly.
+ *
+ * @param surface[in] the surface to update
+ * @param left[in] the left-most x-coordinate of the modified region
+ * @param top[in] the top-most y-coordinate of the modified region
+ * @param right[in] the right-most x-coordinate of the modified region
+ * @param bottom[in] the bottom-most y-coordinate of the modified region
+ * @return whether the surface was updated
+ */
+bool qp_rgb565_surface_mark_dirty(painter_device_t surface, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 #endif // QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
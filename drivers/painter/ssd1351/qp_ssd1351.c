@@ -59,6 +59,21 @@ __attribute__((weak)) bool qp_ssd1351_init(painter_device_t device, painter_rota
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Scrolling
+
+// The SSD1351 has no fixed scroll areas, so only whole-panel scrolling is supported by moving the display start line.
+static bool qp_ssd1351_scroll(painter_device_t device, uint16_t top_fixed, uint16_t bottom_fixed, uint16_t scroll_offset) {
+    tft_panel_dc_reset_painter_device_t *driver = (tft_panel_dc_reset_painter_device_t *)device;
+    if (top_fixed != 0 || bottom_fixed != 0) {
+        return false;
+    }
+
+    uint16_t start_line = (driver->base.rotation == QP_ROTATION_0 || driver->base.rotation == QP_ROTATION_90) ? driver->base.panel_height : 0;
+    qp_comms_command_databyte(device, SSD1351_STARTLINE, (start_line + (scroll_offset % driver->base.panel_height)) & 0x7F);
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Driver vtable
 
@@ -74,6 +89,7 @@ const tft_panel_dc_reset_painter_driver_vtable_t ssd1351_driver_vtable = {
             .palette_convert = qp_tft_panel_palette_convert_rgb565_swapped,
             .append_pixels   = qp_tft_panel_append_pixels_rgb565,
             .append_pixdata  = qp_tft_panel_append_pixdata,
+            .scroll          = qp_ssd1351_scroll,
         },
     .num_window_bytes   = 1,
     .swap_window_coords = true,
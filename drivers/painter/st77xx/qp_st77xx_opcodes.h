@@ -30,9 +30,11 @@
 #define ST77XX_SET_MEM 0x2C          // Set memory
 #define ST77XX_GET_MEM 0x2E          // Get memory
 #define ST77XX_SET_PARTIAL_AREA 0x30 // Set partial area
+#define ST77XX_SET_VSCROLL 0x33      // Set vertical scroll def
 #define ST77XX_CMD_TEARING_OFF 0x34  // Tearing line disabled
 #define ST77XX_CMD_TEARING_ON 0x35   // Tearing line enabled
 #define ST77XX_SET_MADCTL 0x36       // Set mem access ctl
+#define ST77XX_SET_VSCROLL_ADDR 0x37 // Set vscroll start addr
 #define ST77XX_CMD_IDLE_OFF 0x38     // Exit idle mode
 #define ST77XX_CMD_IDLE_ON 0x39      // Enter idle mode
 #define ST77XX_SET_PIX_FMT 0x3A      // Set pixel format
@@ -85,6 +85,35 @@ bool qp_tft_panel_pixdata(painter_device_t device, const void *pixel_data, uint3
     return true;
 }
 
+// Hardware vertical scrolling, using the standard MIPI DCS scroll area/start address commands
+bool qp_tft_panel_scroll(painter_device_t device, uint16_t top_fixed, uint16_t bottom_fixed, uint16_t scroll_offset) {
+    painter_driver_t *                          driver = (painter_driver_t *)device;
+    tft_panel_dc_reset_painter_driver_vtable_t *vtable = (tft_panel_dc_reset_painter_driver_vtable_t *)driver->driver_vtable;
+
+    // The scroll areas must cover all of the controller's frame memory, not just the visible rows. Offsets are applied
+    // before any coordinate swap, so in sideways rotations it's the x offset which moves the panel along the GRAM rows.
+    bool     sideways    = driver->rotation == QP_ROTATION_90 || driver->rotation == QP_ROTATION_270;
+    uint16_t row_offset  = sideways ? driver->offset_x : driver->offset_y;
+    uint16_t gram_height = vtable->gram_height ? vtable->gram_height : driver->panel_height + row_offset;
+    if (row_offset + driver->panel_height > gram_height) {
+        qp_dprintf("qp_tft_panel_scroll: fail (panel does not fit within GRAM)\n");
+        return false;
+    }
+
+    // Any GRAM rows outside the panel are folded into the fixed areas
+    uint16_t top_area    = row_offset + top_fixed;
+    uint16_t scroll_area = driver->panel_height - top_fixed - bottom_fixed;
+    uint16_t bottom_area = gram_height - top_area - scroll_area;
+    uint16_t start_line  = top_area + (scroll_offset % scroll_area);
+
+    uint8_t area_buf[6] = {top_area >> 8, top_area & 0xFF, scroll_area >> 8, scroll_area & 0xFF, bottom_area >> 8, bottom_area & 0xFF};
+    qp_comms_command_databuf(device, vtable->opcodes.set_scroll_area, area_buf, sizeof(area_buf));
+
+    uint8_t start_buf[2] = {start_line >> 8, start_line & 0xFF};
+    qp_comms_command_databuf(device, vtable->opcodes.set_scroll_start, start_buf, sizeof(start_buf));
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Convert supplied palette entries into their native equivalents
 
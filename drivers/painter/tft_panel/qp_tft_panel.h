@@ -21,6 +21,10 @@ typedef struct tft_panel_dc_reset_painter_driver_vtable_t {
     // Whether or not the x/y coords should be swapped on 90/270 rotation
     bool swap_window_coords;
 
+    // Number of rows of frame memory in the controller's native orientation; only required if qp_tft_panel_scroll is
+    // used on panels smaller than the controller's frame memory
+    uint16_t gram_height;
+
     // Opcodes for normal display operation
     struct {
         uint8_t display_on;
@@ -28,6 +32,8 @@ typedef struct tft_panel_dc_reset_painter_driver_vtable_t {
         uint8_t set_column_address;
         uint8_t set_row_address;
         uint8_t enable_writes;
+        uint8_t set_scroll_area;  // only required if qp_tft_panel_scroll is used
+        uint8_t set_scroll_start; // only required if qp_tft_panel_scroll is used
     } opcodes;
 } tft_panel_dc_reset_painter_driver_vtable_t;
 
@@ -53,6 +59,7 @@ bool qp_tft_panel_clear(painter_device_t device);
 bool qp_tft_panel_flush(painter_device_t device);
 bool qp_tft_panel_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 bool qp_tft_panel_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
+bool qp_tft_panel_scroll(painter_device_t device, uint16_t top_fixed, uint16_t bottom_fixed, uint16_t scroll_offset);
 
 bool qp_tft_panel_palette_convert_rgb565_swapped(painter_device_t device, int16_t palette_size, qp_pixel_t *palette);
 bool qp_tft_panel_palette_convert_rgb888(painter_device_t device, int16_t palette_size, qp_pixel_t *palette);
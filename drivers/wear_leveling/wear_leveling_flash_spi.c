@@ -41,6 +41,29 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+bool backing_store_erase_range(uint32_t address, size_t length) {
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    _Static_assert((WEAR_LEVELING_BANK_SIZE) % (EXTERNAL_FLASH_BLOCK_SIZE) == 0, "Dual-bank wear-leveling requires each bank to be a multiple of EXTERNAL_FLASH_BLOCK_SIZE");
+
+    bool     ret    = true;
+    uint32_t offset = (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address;
+    for (uint32_t i = 0; i < length; i += (EXTERNAL_FLASH_BLOCK_SIZE)) {
+        flash_status_t status = flash_erase_block(offset + i);
+        if (status != FLASH_STATUS_SUCCESS) {
+            ret = false;
+            break;
+        }
+    }
+
+    bs_dprintf("Backing store range erase took %ldms to complete\n", ((long)(timer_read32() - start)));
+    return ret;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
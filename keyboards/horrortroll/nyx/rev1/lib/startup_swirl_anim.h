@@ -105,7 +105,7 @@ static void swirl_set_color(HSV hsv) {
     traverse_matrix();
 
     if (!(top <= bottom && left <= right)) {
-        eeprom_read_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config));
+        eeconfig_read_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config));
         rgb_matrix_mode_noeeprom(rgb_matrix_config.mode);
         return;
     }
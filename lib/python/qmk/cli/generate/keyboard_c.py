@@ -3,6 +3,7 @@
 from milc import cli
 
 from qmk.info import info_json
+from qmk.led_geometry import DEFAULT_CENTER, geometry_lines, neighbor_lines
 from qmk.commands import dump_lines
 from qmk.keyboard import keyboard_completer, keyboard_folder
 from qmk.path import normpath
@@ -52,11 +53,41 @@ def _gen_led_config(info_data):
     lines.append(f'  {{ {", ".join(pos)} }},')
     lines.append(f'  {{ {", ".join(flags)} }},')
     lines.append('};')
+    if config_type == 'rgb_matrix':
+        lines.extend(_gen_led_geometry(info_data, config_type))
+        lines.extend(_gen_led_neighbors(info_data, config_type))
     lines.append('#endif')
 
     return lines
 
 
+def _gen_led_geometry(info_data, config_type):
+    """Precompute the distances and angles the effects would otherwise work out for every LED on every frame
+    """
+    led_layout = info_data[config_type]['layout']
+    center = tuple(info_data[config_type].get('center_point', DEFAULT_CENTER))
+    points = [(led_data.get('x', 0), led_data.get('y', 0)) for led_data in led_layout]
+
+    return geometry_lines(center, points)
+
+
+def _gen_led_neighbors(info_data, config_type):
+    """List the keys around each LED that the typing heatmap warms up when it is pressed
+    """
+    cols = info_data['matrix_size']['cols']
+    rows = info_data['matrix_size']['rows']
+
+    led_layout = info_data[config_type]['layout']
+    points = [(led_data.get('x', 0), led_data.get('y', 0)) for led_data in led_layout]
+    matrix = [[None] * cols for _ in range(rows)]
+    for index, led_data in enumerate(led_layout):
+        if 'matrix' in led_data:
+            row, col = led_data['matrix']
+            matrix[row][col] = index
+
+    return neighbor_lines(matrix, points)
+
+
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate keyboard.c for.')
@@ -0,0 +1,134 @@
+"""Packs Quantum Painter images and fonts into a single binary for external flash.
+"""
+import re
+import struct
+import datetime
+from qmk.path import normpath
+from qmk.painter import render_license
+from milc import cli
+
+# Pack layout, all values little-endian:
+#   header:  magic "QPAK", uint16 version, uint16 asset count
+#   index:   per asset -- uint32 offset from start of pack, uint32 length, uint8 type, 3 bytes reserved
+#   data:    each asset's raw QGF/QFF data, aligned to pack_alignment
+pack_magic = b'QPAK'
+pack_version = 1
+pack_alignment = 4
+pack_header = struct.Struct('<4sHH')
+pack_index_entry = struct.Struct('<IIB3x')
+
+# Asset types, as determined by the magic within the leading descriptor block of each file
+asset_types = {
+    b'QGF': (0, 'image'),
+    b'QFF': (1, 'font'),
+}
+
+header_file_template = """\
+{license}
+#pragma once
+
+// Quantum Painter asset pack -- load assets using qp_load_image_flash() / qp_load_font_flash()
+#define QP_ASSET_PACK_ADDRESS 0x{base_address:08X}
+#define QP_ASSET_PACK_SIZE {pack_size}
+#define QP_ASSET_PACK_COUNT {asset_count}
+
+{asset_defines}
+"""
+
+
+def _asset_type(data):
+    # Both QGF and QFF files start with a 5-byte block header, followed by the 3-byte magic
+    if len(data) >= 8:
+        return asset_types.get(bytes(data[5:8]))
+    return None
+
+
+def _align(value):
+    return (value + pack_alignment - 1) & ~(pack_alignment - 1)
+
+
+@cli.argument('-o', '--output', required=True, help='Specify output binary file.')
+@cli.argument('-b', '--base-address', default='0', help='Address in external flash that the pack will be written to. Defaults to 0.')
+@cli.argument('-H', '--header', default='', help='Optionally write a C header containing the flash address of each asset.')
+@cli.argument('inputs', nargs='+', arg_only=True, help='Raw QGF/QFF files to pack, as generated using --raw.')
+@cli.subcommand('Packs Quantum Painter images and fonts into a binary for external flash')
+def painter_pack_assets(cli):
+    """Packs raw QGF images and QFF fonts into a single binary suitable for programming into external flash.
+
+    The binary starts with an index of all contained assets, followed by the asset data. Assets can then be loaded on the keyboard using `qp_load_image_flash()` and `qp_load_font_flash()`, using the addresses written to the optional header file.
+    """
+    try:
+        base_address = int(cli.args.base_address, 0)
+    except ValueError:
+        cli.log.error('Invalid base address: %s' % cli.args.base_address)
+        return False
+
+    # Read and classify each of the inputs
+    assets = []
+    for input_file in cli.args.inputs:
+        input_file = normpath(input_file)
+        if not input_file.exists():
+            cli.log.error('Input file %s does not exist!' % input_file)
+            return False
+
+        data = input_file.read_bytes()
+        asset_type = _asset_type(data)
+        if asset_type is None:
+            cli.log.error('Input file %s is not a raw QGF or QFF file!' % input_file)
+            return False
+
+        assets.append({
+            'name': re.sub(r"[^a-zA-Z0-9]", "_", input_file.stem).upper(),
+            'file': input_file,
+            'data': data,
+            'type': asset_type,
+        })
+
+    if len(assets) > 0xFFFF:
+        cli.log.error('Too many assets to pack (%d)' % len(assets))
+        return False
+
+    # Lay out the data after the index
+    offset = _align(pack_header.size + pack_index_entry.size * len(assets))
+    for asset in assets:
+        asset['offset'] = offset
+        offset = _align(offset + len(asset['data']))
+
+    # Build the pack
+    pack = bytearray(offset)
+    pack_header.pack_into(pack, 0, pack_magic, pack_version, len(assets))
+    for i, asset in enumerate(assets):
+        pack_index_entry.pack_into(pack, pack_header.size + pack_index_entry.size * i, asset['offset'], len(asset['data']), asset['type'][0])
+        pack[asset['offset']:asset['offset'] + len(asset['data'])] = asset['data']
+
+    output_file = normpath(cli.args.output)
+    with open(output_file, 'wb') as output:
+        print(f"Writing {output_file}...")
+        output.write(pack)
+
+    for asset in assets:
+        cli.log.info('%-6s %s @ 0x%08X (%d bytes)' % (asset['type'][1], asset['file'].name, base_address + asset['offset'], len(asset['data'])))
+
+    if cli.args.header:
+        asset_defines = []
+        for asset in assets:
+            asset_defines.append(f"#define QP_ASSET_{asset['name']}_ADDRESS 0x{base_address + asset['offset']:08X} // {asset['type'][1]}, from {asset['file'].name}")
+            asset_defines.append(f"#define QP_ASSET_{asset['name']}_LENGTH {len(asset['data'])}")
+
+        subs = {
+            'generated_type': 'asset pack',
+            'generator_command': f'qmk painter-pack-assets -o {output_file.name} {" ".join(a["file"].name for a in assets)}',
+            'year': datetime.date.today().strftime("%Y"),
+        }
+        header_text = header_file_template.format(
+            license=render_license(subs),
+            base_address=base_address,
+            pack_size=len(pack),
+            asset_count=len(assets),
+            asset_defines='\n'.join(asset_defines),
+        )
+
+        header_file = normpath(cli.args.header)
+        with open(header_file, 'w') as header:
+            print(f"Writing {header_file}...")
+            header.write(header_text)
@@ -0,0 +1,164 @@
+"""Precomputed LED geometry for the RGB matrix effects.
+
+The values are computed exactly as the firmware does at run time, using the same integer approximations from lib8tion,
+so that effects render identically whether or not they use the tables.
+"""
+
+# Default centre point, matching `k_rgb_matrix_center` and `k_led_matrix_center`
+DEFAULT_CENTER = (112, 32)
+
+# Default `RGB_MATRIX_TYPING_HEATMAP_SPREAD`, the furthest a key press warms up the keys around it
+HEATMAP_SPREAD = 40
+
+# Matrix positions without an LED, matching `NO_LED`
+NO_LED = 255
+
+
+def _trunc_div(a, b):
+    """Integer division that truncates towards zero, as in C.
+    """
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+def sqrt16(x):
+    """Port of lib8tion's `sqrt16()`, including its 16-bit argument.
+    """
+    x &= 0xFFFF
+    if x <= 1:
+        return x
+
+    low = 1
+    hi = 255 if x > 7904 else (x >> 5) + 8
+    while True:
+        mid = (low + hi) >> 1
+        if (mid * mid) & 0xFFFF > x:
+            hi = mid - 1
+        else:
+            if mid == 255:
+                return 255
+            low = mid + 1
+        if hi < low:
+            break
+
+    return low - 1
+
+
+def atan2_8(dy, dx):
+    """Port of lib8tion's `atan2_8()`.
+    """
+    if dy == 0:
+        return 0 if dx >= 0 else 128
+
+    abs_y = abs(dy)
+    if dx >= 0:
+        a = 32 - _trunc_div(32 * (dx - abs_y), dx + abs_y)
+    else:
+        a = 96 - _trunc_div(32 * (dx + abs_y), abs_y - dx)
+
+    # int8_t in the firmware
+    a = ((a + 128) & 0xFF) - 128
+    return (-a if dy < 0 else a) & 0xFF
+
+
+def distance(a, b):
+    """Distance between two points, as computed by the effects.
+    """
+    dx = a[0] - b[0]
+    dy = a[1] - b[1]
+    return sqrt16(dx * dx + dy * dy)
+
+
+def fletcher16(values):
+    """Fletcher-16 over a sequence of bytes.
+    """
+    sum1 = 0
+    sum2 = 0
+    for value in values:
+        sum1 = (sum1 + value) % 255
+        sum2 = (sum2 + sum1) % 255
+    return (sum2 << 8) | sum1
+
+
+def checksum(center, points):
+    """Fletcher-16 over the centre and LED positions, which the firmware recomputes to make sure the tables match.
+    """
+    return fletcher16([*center, *[v for point in points for v in point]])
+
+
+def matrix_checksum(matrix):
+    """Fletcher-16 over the LED index at each matrix position, row by row.
+
+    Each index is offset by one, wrapping `NO_LED` around to zero, as Fletcher-16 can't tell 0 and 255 apart.
+    """
+    return fletcher16([((NO_LED if led is None else led) + 1) & 0xFF for row in matrix for led in row])
+
+
+def polar(center, points):
+    """Distance and angle of each LED from the centre.
+    """
+    return [(distance(point, center), atan2_8(point[1] - center[1], point[0] - center[0])) for point in points]
+
+
+def led_distances(points):
+    """Distances between every pair of LEDs, as the lower triangle of the distance matrix without its diagonal.
+    """
+    return [distance(points[a], points[b]) for a in range(len(points)) for b in range(a)]
+
+
+def geometry_lines(center, points):
+    """C definitions of the RGB matrix distance and angle tables for a layout, as emitted into keyboard.c.
+
+    The tables are kept in flash, and each is only compiled in when an effect that reads it is enabled.
+    """
+    lines = []
+    lines.append(f'const uint16_t k_led_geometry_checksum PROGMEM = 0x{checksum(center, points):04X};')
+    lines.append('#ifdef RGB_MATRIX_LED_POLAR_ENABLED')
+    lines.append(f'const led_polar_t g_led_polar[] PROGMEM = {{ {", ".join(f"{{{dist}, {angle}}}" for dist, angle in polar(center, points))} }};')
+    lines.append('#endif')
+    lines.append('#ifdef RGB_MATRIX_LED_DISTANCE_TABLE')
+    lines.append(f'const uint8_t g_led_distance[] PROGMEM = {{ {", ".join(str(dist) for dist in led_distances(points)) or "0"} }};')
+    lines.append('#endif')
+
+    return lines
+
+
+def neighbors(matrix, points, radius=HEATMAP_SPREAD):
+    """For each LED, the matrix positions of the LEDs within `radius` of it, along with their distance.
+
+    Positions are listed row by row, in the order the heatmap would otherwise visit them.
+    """
+    keys = [(row, col, led) for row, leds in enumerate(matrix) for col, led in enumerate(leds) if led is not None]
+
+    lists = []
+    for point in points:
+        nearby = []
+        for row, col, led in keys:
+            dist = distance(point, points[led])
+            if dist <= radius:
+                nearby.append((row, col, dist))
+        lists.append(nearby)
+
+    return lists
+
+
+def neighbor_lines(matrix, points):
+    """C definitions of the typing heatmap's neighbor lists for a layout, as emitted into keyboard.c.
+
+    The lists are kept in flash, as they can run to several kilobytes on a full size layout.
+    `matrix` holds the LED index at each matrix position, or None where there is no LED.
+    """
+    index = [0]
+    entries = []
+    for nearby in neighbors(matrix, points):
+        entries.extend(f'{{{row}, {col}, {dist}}}' for row, col, dist in nearby)
+        index.append(len(entries))
+
+    lines = []
+    lines.append(f'#if defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && (!defined(RGB_MATRIX_TYPING_HEATMAP_SPREAD) || RGB_MATRIX_TYPING_HEATMAP_SPREAD <= {HEATMAP_SPREAD})')
+    lines.append(f'const uint16_t k_led_neighbor_checksum PROGMEM = 0x{matrix_checksum(matrix):04X};')
+    lines.append(f'const uint16_t g_led_neighbor_index[] PROGMEM = {{ {", ".join(str(offset) for offset in index)} }};')
+    lines.append(f'const led_neighbor_t g_led_neighbors[] PROGMEM = {{ {", ".join(entries) or "{0, 0, 0}"} }};')
+    lines.append('#endif')
+
+    return lines
@@ -0,0 +1,87 @@
+from math import atan2, hypot, pi
+
+from qmk.led_geometry import DEFAULT_CENTER, sqrt16, atan2_8, checksum, matrix_checksum, polar, led_distances, geometry_lines, neighbors, neighbor_lines
+
+
+def test_led_geometry_sqrt16():
+    assert [sqrt16(x) for x in (0, 1, 2, 3, 4, 15, 16, 17, 13568, 65025)] == [0, 1, 1, 1, 2, 3, 4, 4, 116, 255]
+
+    # Squared distances over 16 bits wrap, as they do in the firmware
+    assert sqrt16(65536 + 100) == 10
+
+
+def test_led_geometry_atan2_8():
+    assert atan2_8(0, 10) == 0
+    assert atan2_8(10, 0) == 64
+    assert atan2_8(0, -10) == 128
+    assert atan2_8(-10, 0) == 192
+    assert atan2_8(-5, -7) == 155
+    assert atan2_8(10, 3) == 49
+
+    # Close enough to the real thing that the effects look the same
+    for dy in range(-64, 65, 8):
+        for dx in range(-112, 113, 16):
+            if dx or dy:
+                exact = atan2(dy, dx) * 128 / pi % 256
+                error = abs(atan2_8(dy, dx) - exact)
+                assert min(error, 256 - error) < 12
+
+
+def test_led_geometry_polar():
+    points = [(112, 32), (0, 0), (224, 64), (112, 0)]
+
+    assert polar(DEFAULT_CENTER, points) == [(0, 0), (116, 143), (116, 15), (32, 192)]
+    for (dist, _), (x, y) in zip(polar(DEFAULT_CENTER, points), points):
+        assert abs(dist - hypot(x - 112, y - 32)) < 1
+
+
+def test_led_geometry_led_distances():
+    points = [(0, 0), (3, 4), (6, 8), (0, 10)]
+
+    # Lower triangle of the distance matrix, a row at a time
+    assert led_distances(points) == [5, 10, 5, 10, 6, 6]
+    assert led_distances(points[:1]) == []
+
+
+def test_led_geometry_checksum():
+    assert checksum(DEFAULT_CENTER, []) == 0x0190
+    assert checksum(DEFAULT_CENTER, [(0, 0)]) != checksum(DEFAULT_CENTER, [(0, 1)])
+    # Unlike a plain sum, swapping two LEDs changes the checksum
+    assert checksum(DEFAULT_CENTER, [(1, 2), (3, 4)]) != checksum(DEFAULT_CENTER, [(3, 4), (1, 2)])
+
+
+def test_led_geometry_neighbors():
+    # Two rows of three keys, with an extra LED that isn't on the matrix
+    points = [(0, 0), (20, 0), (60, 0), (0, 30), (20, 30), (60, 30), (10, 15)]
+    matrix = [[0, 1, 2], [3, 4, None]]
+
+    lists = neighbors(matrix, points, radius=40)
+    assert lists[0] == [(0, 0, 0), (0, 1, 20), (1, 0, 30), (1, 1, 36)]
+    assert lists[2] == [(0, 1, 40), (0, 2, 0)]
+    # LEDs that aren't on the matrix still warm up the keys around them, but are never warmed up themselves
+    assert lists[6] == [(0, 0, 18), (0, 1, 18), (1, 0, 18), (1, 1, 18)]
+    assert all(col != 2 or row != 1 for nearby in lists for row, col, _ in nearby)
+
+
+def test_led_geometry_matrix_checksum():
+    assert matrix_checksum([[0, 1], [2, None]]) != matrix_checksum([[1, 0], [2, None]])
+    # LED 0 and NO_LED are told apart
+    assert matrix_checksum([[0, None]]) != matrix_checksum([[None, 0]])
+
+
+def test_led_geometry_geometry_lines():
+    lines = geometry_lines(DEFAULT_CENTER, [(0, 0), (3, 4)])
+
+    assert lines[0] == f'const uint16_t k_led_geometry_checksum PROGMEM = 0x{checksum(DEFAULT_CENTER, [(0, 0), (3, 4)]):04X};'
+    assert lines[1:4] == ['#ifdef RGB_MATRIX_LED_POLAR_ENABLED', 'const led_polar_t g_led_polar[] PROGMEM = { {116, 143}, {112, 142} };', '#endif']
+    assert lines[4:] == ['#ifdef RGB_MATRIX_LED_DISTANCE_TABLE', 'const uint8_t g_led_distance[] PROGMEM = { 5 };', '#endif']
+
+
+def test_led_geometry_neighbor_lines():
+    points = [(0, 0), (20, 0), (100, 0)]
+    matrix = [[0, 1, None], [None, None, 2]]
+
+    lines = neighbor_lines(matrix, points)
+    assert lines[1] == f'const uint16_t k_led_neighbor_checksum PROGMEM = 0x{matrix_checksum(matrix):04X};'
+    assert lines[2] == 'const uint16_t g_led_neighbor_index[] PROGMEM = { 0, 2, 4, 5 };'
+    assert lines[3] == 'const led_neighbor_t g_led_neighbors[] PROGMEM = { {0, 0, 0}, {0, 1, 20}, {0, 0, 20}, {0, 1, 0}, {1, 2, 0} };'
@@ -0,0 +1,93 @@
+from collections import deque
+
+from qmk.via_stream import ViaStreamClient, ViaStreamError, crc16
+from qmk.via_stream import ID_DYNAMIC_KEYMAP_GET_BUFFER_STREAM, ID_DYNAMIC_KEYMAP_SET_BUFFER_STREAM, ID_DYNAMIC_KEYMAP_STREAM_DATA
+from qmk.via_stream import STREAM_OK, STREAM_INVALID_RANGE, REPORT_SIZE
+
+
+class FakeKeyboard:
+    """Minimal stand-in for the firmware side of the streamed transfer.
+    """
+    def __init__(self, size=320):
+        self.keymap = bytearray(size)
+        self.reports = deque()
+        self.writes = 0
+        self.stream = None
+        self.corrupt_crc = False
+
+    def _trailer(self, command_id, offset, size, status, crc):
+        return bytes([command_id, offset >> 8, offset & 0xFF, size >> 8, size & 0xFF, status, crc >> 8, crc & 0xFF]).ljust(REPORT_SIZE, b'\0')
+
+    def write(self, data):
+        assert data[0] == 0 and len(data) == REPORT_SIZE + 1
+        report = data[1:]
+        self.writes += 1
+
+        if report[0] == ID_DYNAMIC_KEYMAP_STREAM_DATA:
+            offset, size, position = self.stream
+            chunk = min(REPORT_SIZE - 2, size - position)
+            self.keymap[offset + position:offset + position + chunk] = report[2:2 + chunk]
+            position += chunk
+            self.stream = (offset, size, position)
+            if position == size:
+                crc = crc16(self.keymap[offset:offset + size])
+                self.reports.append(self._trailer(ID_DYNAMIC_KEYMAP_SET_BUFFER_STREAM, offset, size, STREAM_OK, crc))
+            return
+
+        offset = (report[1] << 8) | report[2]
+        size = (report[3] << 8) | report[4]
+        valid = size > 0 and offset + size <= len(self.keymap)
+        status = STREAM_OK if valid else STREAM_INVALID_RANGE
+
+        if report[0] == ID_DYNAMIC_KEYMAP_GET_BUFFER_STREAM and valid:
+            data = self.keymap[offset:offset + size]
+            for sequence, position in enumerate(range(0, size, REPORT_SIZE - 2)):
+                chunk = bytes(data[position:position + REPORT_SIZE - 2])
+                self.reports.append(bytes([ID_DYNAMIC_KEYMAP_STREAM_DATA, sequence]) + chunk.ljust(REPORT_SIZE - 2, b'\0'))
+            crc = crc16(data) ^ (1 if self.corrupt_crc else 0)
+            self.reports.append(self._trailer(report[0], offset, size, status, crc))
+        else:
+            self.stream = (offset, size, 0)
+            self.reports.append(self._trailer(report[0], offset, size, status, 0))
+
+    def read(self, size, timeout):
+        return self.reports.popleft() if self.reports else b''
+
+
+def test_via_stream_crc16():
+    assert crc16(b'123456789') == 0x29B1
+
+
+def test_via_stream_round_trip():
+    keyboard = FakeKeyboard()
+    client = ViaStreamClient(keyboard)
+    data = bytes((i * 7) & 0xFF for i in range(300))
+
+    client.write_keymap_buffer(10, data)
+    assert keyboard.keymap[10:310] == data
+    # One header plus back-to-back data reports, with no per-report round trips
+    assert keyboard.writes == 1 + 10
+
+    assert client.read_keymap_buffer(10, 300) == data
+
+
+def test_via_stream_invalid_range():
+    client = ViaStreamClient(FakeKeyboard())
+
+    try:
+        client.read_keymap_buffer(300, 100)
+        assert False, 'expected ViaStreamError'
+    except ViaStreamError as e:
+        assert 'invalid range' in str(e)
+
+
+def test_via_stream_crc_mismatch():
+    keyboard = FakeKeyboard()
+    keyboard.corrupt_crc = True
+    client = ViaStreamClient(keyboard)
+
+    try:
+        client.read_keymap_buffer(0, 64)
+        assert False, 'expected ViaStreamError'
+    except ViaStreamError as e:
+        assert 'CRC' in str(e)
@@ -0,0 +1,134 @@
+"""Host side of the VIA streamed keymap transfer.
+
+Reads and writes an arbitrary range of a keyboard's dynamic keymap using back-to-back raw HID reports, rather than one
+request/response round trip per report. See `quantum/via.c` for the firmware side of the protocol.
+"""
+from binascii import crc_hqx
+
+RAW_HID_USAGE_PAGE = 0xFF60
+RAW_HID_USAGE = 0x61
+REPORT_SIZE = 32
+
+ID_GET_PROTOCOL_VERSION = 0x01
+ID_DYNAMIC_KEYMAP_GET_BUFFER_STREAM = 0x16
+ID_DYNAMIC_KEYMAP_SET_BUFFER_STREAM = 0x17
+ID_DYNAMIC_KEYMAP_STREAM_DATA = 0x18
+ID_UNHANDLED = 0xFF
+
+STREAM_OK = 0x00
+STREAM_INVALID_RANGE = 0x01
+STREAM_BAD_SEQUENCE = 0x02
+
+STREAM_STATUS_NAMES = {
+    STREAM_OK: 'ok',
+    STREAM_INVALID_RANGE: 'invalid range',
+    STREAM_BAD_SEQUENCE: 'bad sequence',
+}
+
+
+class ViaStreamError(Exception):
+    """Raised when a streamed transfer fails or its data does not verify.
+    """
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as computed by the firmware over the transferred keymap bytes.
+    """
+    return crc_hqx(bytes(data), crc)
+
+
+def open_device(vid, pid):
+    """Opens the raw HID interface of the first keyboard matching the supplied VID and PID.
+    """
+    import hid
+
+    for info in hid.enumerate(vid, pid):
+        if info['usage_page'] == RAW_HID_USAGE_PAGE and info['usage'] == RAW_HID_USAGE:
+            return hid.Device(path=info['path'])
+
+    raise ViaStreamError(f'No raw HID interface found for {vid:04x}:{pid:04x}')
+
+
+class ViaStreamClient:
+    """Streams dynamic keymap data to and from a keyboard.
+
+    `device` needs `write(data)` and `read(size, timeout)` methods, as provided by `hid.Device`.
+    """
+    def __init__(self, device, report_size=REPORT_SIZE, timeout=1000):
+        self.device = device
+        self.report_size = report_size
+        self.timeout = timeout
+
+    @property
+    def payload_size(self):
+        return self.report_size - 2
+
+    def _send(self, data):
+        report = bytes(data).ljust(self.report_size, b'\0')
+        # The leading zero is the report ID, which raw HID doesn't use
+        self.device.write(b'\0' + report)
+
+    def _receive(self):
+        report = bytes(self.device.read(self.report_size, self.timeout))
+        if len(report) != self.report_size:
+            raise ViaStreamError('Timed out waiting for the keyboard')
+        return report
+
+    @staticmethod
+    def _header(command_id, offset, size):
+        return bytes([command_id, offset >> 8, offset & 0xFF, size >> 8, size & 0xFF])
+
+    def _check_trailer(self, report, command_id, offset, size):
+        if report[0] == ID_UNHANDLED:
+            raise ViaStreamError('Keyboard does not support streamed keymap transfers')
+
+        if report[:5] != self._header(command_id, offset, size):
+            raise ViaStreamError(f'Unexpected report 0x{report[0]:02x}')
+
+        status = report[5]
+        if status != STREAM_OK:
+            raise ViaStreamError(f'Transfer failed: {STREAM_STATUS_NAMES.get(status, hex(status))}')
+
+        return (report[6] << 8) | report[7]
+
+    def read_keymap_buffer(self, offset, size):
+        """Reads `size` bytes of the dynamic keymap, starting at `offset`.
+        """
+        self._send(self._header(ID_DYNAMIC_KEYMAP_GET_BUFFER_STREAM, offset, size))
+
+        data = bytearray()
+        sequence = 0
+        while len(data) < size:
+            report = self._receive()
+            if report[0] != ID_DYNAMIC_KEYMAP_STREAM_DATA:
+                # An error is reported by the trailer, without any data reports
+                self._check_trailer(report, ID_DYNAMIC_KEYMAP_GET_BUFFER_STREAM, offset, size)
+                raise ViaStreamError('Transfer ended early')
+
+            if report[1] != sequence:
+                raise ViaStreamError(f'Expected data report {sequence}, received {report[1]}')
+
+            data += report[2:2 + min(self.payload_size, size - len(data))]
+            sequence = (sequence + 1) & 0xFF
+
+        crc = self._check_trailer(self._receive(), ID_DYNAMIC_KEYMAP_GET_BUFFER_STREAM, offset, size)
+        if crc != crc16(data):
+            raise ViaStreamError('CRC mismatch on received data')
+
+        return bytes(data)
+
+    def write_keymap_buffer(self, offset, data):
+        """Writes `data` to the dynamic keymap, starting at `offset`.
+        """
+        data = bytes(data)
+
+        self._send(self._header(ID_DYNAMIC_KEYMAP_SET_BUFFER_STREAM, offset, len(data)))
+        self._check_trailer(self._receive(), ID_DYNAMIC_KEYMAP_SET_BUFFER_STREAM, offset, len(data))
+
+        for sequence, position in enumerate(range(0, len(data), self.payload_size)):
+            chunk = data[position:position + self.payload_size]
+            self._send(bytes([ID_DYNAMIC_KEYMAP_STREAM_DATA, sequence & 0xFF]) + chunk)
+
+        crc = self._check_trailer(self._receive(), ID_DYNAMIC_KEYMAP_SET_BUFFER_STREAM, offset, len(data))
+        if crc != crc16(data):
+            raise ViaStreamError('CRC mismatch on written data')
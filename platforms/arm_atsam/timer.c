@@ -30,6 +30,15 @@ uint32_t timer_elapsed32(uint32_t tlast) {
     return TIMER_DIFF_32(timer_read32(), tlast);
 }
 
+// Only a millisecond clock is available
+uint32_t timer_read_us(void) {
+    return (uint32_t)ms_clk * 1000;
+}
+
+uint32_t timer_elapsed_us(uint32_t tlast) {
+    return TIMER_DIFF_32(timer_read_us(), tlast);
+}
+
 void timer_clear(void) {
     set_time(0);
 }
@@ -134,6 +134,47 @@ inline uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(t, last);
 }
 
+#ifdef __AVR_ATmega32A__
+#    define TIMER_COMPARE_FLAGS TIFR
+#    define TIMER_COMPARE_FLAG OCF0
+#elif defined(__AVR_ATtiny85__)
+#    define TIMER_COMPARE_FLAGS TIFR
+#    define TIMER_COMPARE_FLAG OCF0A
+#else
+#    define TIMER_COMPARE_FLAGS TIFR0
+#    define TIMER_COMPARE_FLAG OCF0A
+#endif
+
+/** \brief timer read us
+ *
+ * Combines the millisecond count with the position of Timer0 within the
+ * current millisecond.
+ */
+uint32_t timer_read_us(void) {
+    uint32_t t;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        t   = timer_count;
+        raw = TIMER_RAW;
+        // The counter may have wrapped around with the interrupt still pending
+        if (TIMER_COMPARE_FLAGS & _BV(TIMER_COMPARE_FLAG)) {
+            t++;
+            raw = TIMER_RAW;
+        }
+    }
+
+    return t * 1000 + (uint32_t)raw * 1000 / (TIMER_RAW_TOP + 1);
+}
+
+/** \brief timer elapsed us
+ *
+ * Microseconds since a timer_read_us() value, wrapping after about 71 minutes.
+ */
+uint32_t timer_elapsed_us(uint32_t last) {
+    return TIMER_DIFF_32(timer_read_us(), last);
+}
+
 // excecuted once per 1ms.(excess for just timer count?)
 #ifndef __AVR_ATmega32A__
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMPA_vect
@@ -20,10 +20,38 @@
 
 static pin_t currentSlavePin = NO_PIN;
 
+// The thread waiting in spi_wait() for an asynchronous transfer, if any
+static thread_reference_t waitingThread = NULL;
+
+// What's left of an asynchronous transfer, sent a DMA-sized chunk at a time
+static const uint8_t *asyncData      = NULL;
+static uint32_t       asyncRemaining = 0;
+
+static void spi_send_next_chunk_i(void) {
+    uint16_t       length = (asyncRemaining > UINT16_MAX) ? UINT16_MAX : asyncRemaining;
+    const uint8_t *data   = asyncData;
+
+    asyncData += length;
+    asyncRemaining -= length;
+    spiStartSendI(&SPI_DRIVER, length, data);
+}
+
+static void spi_complete_cb(SPIDriver *spip) {
+    osalSysLockFromISR();
+    if (asyncRemaining > 0) {
+        // Chain the next chunk; spiStartSendI() expects a ready driver and leaves it active, so spi_wait() keeps waiting
+        spip->state = SPI_READY;
+        spi_send_next_chunk_i();
+    } else {
+        osalThreadResumeI(&waitingThread, MSG_OK);
+    }
+    osalSysUnlockFromISR();
+}
+
 #if defined(K20x) || defined(KL2x) || defined(RP2040)
-static SPIConfig spiConfig = {NULL, 0, 0, 0};
+static SPIConfig spiConfig = {spi_complete_cb, 0, 0, 0};
 #else
-static SPIConfig spiConfig = {false, NULL, 0, 0, 0, 0};
+static SPIConfig spiConfig = {false, spi_complete_cb, 0, 0, 0, 0};
 #endif
 
 __attribute__((weak)) void spi_init(void) {
@@ -277,6 +305,27 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint32_t length) {
+    if (length == 0) {
+        return SPI_STATUS_SUCCESS;
+    }
+    osalSysLock();
+    asyncData      = data;
+    asyncRemaining = length;
+    spi_send_next_chunk_i();
+    osalSysUnlock();
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_wait(void) {
+    // The state is only checked with the system locked, so the completion callback can't slip in before the thread suspends
+    osalSysLock();
+    while (SPI_DRIVER.state == SPI_ACTIVE) {
+        osalThreadSuspendS(&waitingThread);
+    }
+    osalSysUnlock();
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
@@ -284,6 +333,7 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
 
 void spi_stop(void) {
     if (currentSlavePin != NO_PIN) {
+        spi_wait();
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         currentSlavePin = NO_PIN;
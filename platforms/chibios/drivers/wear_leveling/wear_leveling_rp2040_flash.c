@@ -187,6 +187,24 @@ bool backing_store_erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+bool backing_store_erase_range(uint32_t address, size_t length) {
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    // Ensure each bank can be erased without disturbing the other.
+    _Static_assert((WEAR_LEVELING_BANK_SIZE) % (FLASH_SECTOR_SIZE) == 0, "Dual-bank wear-leveling requires each bank to be a multiple of FLASH_SECTOR_SIZE");
+
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + address, length);
+    restore_interrupts(interrupts);
+
+    bs_dprintf("Backing store range erase took %ldms to complete\n", ((long)(timer_read32() - start)));
+    return true;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
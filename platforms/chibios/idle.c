@@ -0,0 +1,29 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+
+#include "idle.h"
+
+#define IDLE_WAKEUP_EVENT EVENT_MASK(0)
+
+static thread_t *main_thread = NULL;
+
+void idle_sleep_us(uint32_t duration) {
+    if (main_thread == NULL) {
+        main_thread = chThdGetSelfX();
+    }
+
+    // A pending wakeup is consumed here without sleeping
+    chEvtWaitAnyTimeout(IDLE_WAKEUP_EVENT, TIME_US2I(duration));
+}
+
+void idle_wakeup(void) {
+    if (main_thread == NULL) {
+        return;
+    }
+
+    syssts_t sts = chSysGetStatusAndLockX();
+    chEvtSignalI(main_thread, IDLE_WAKEUP_EVENT);
+    chSysRestoreStatusX(sts);
+}
@@ -5,6 +5,11 @@
 static uint32_t ticks_offset = 0;
 static uint32_t last_ticks   = 0;
 static uint32_t ms_offset    = 0;
+#if 1000000 % CH_CFG_ST_FREQUENCY != 0
+static uint32_t us_ticks     = 0;
+static uint32_t us_count     = 0;
+static uint32_t us_remainder = 0;
+#endif
 #if CH_CFG_ST_RESOLUTION < 32
 static uint32_t last_systime = 0;
 static uint32_t overflow     = 0;
@@ -105,3 +110,31 @@ uint16_t timer_elapsed(uint16_t last) {
 uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(timer_read32(), last);
 }
+
+uint32_t timer_read_us(void) {
+#if 1000000 % CH_CFG_ST_FREQUENCY == 0
+    // Every tick is a whole number of microseconds, and the 32-bit wrap around of both counts lines up
+    chSysLock();
+    uint32_t ticks = get_system_time_ticks();
+    chSysUnlock();
+
+    return ticks * (1000000 / CH_CFG_ST_FREQUENCY);
+#else
+    // Convert only the ticks since the last call and carry the remainder over, so that the count stays exact and
+    // monotonic.  This must be called at least once every 2**32 ticks.
+    chSysLock();
+    uint32_t ticks  = get_system_time_ticks();
+    uint64_t scaled = (uint64_t)(ticks - us_ticks) * 1000000 + us_remainder;
+    us_ticks        = ticks;
+    us_count += (uint32_t)(scaled / CH_CFG_ST_FREQUENCY);
+    us_remainder     = (uint32_t)(scaled % CH_CFG_ST_FREQUENCY);
+    uint32_t us_copy = us_count;
+    chSysUnlock();
+
+    return us_copy;
+#endif
+}
+
+uint32_t timer_elapsed_us(uint32_t last) {
+    return TIMER_DIFF_32(timer_read_us(), last);
+}
@@ -0,0 +1,20 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Puts the main loop to sleep for up to `duration` microseconds, returning as soon as
+ * `idle_wakeup()` is called. A wakeup that comes in before the sleep has
+ * started cuts the next sleep short instead of being lost.
+ */
+void idle_sleep_us(uint32_t duration);
+
+/**
+ * Wakes up the main loop, for anything it needs to handle without waiting for the
+ * next scan, such as USB traffic or a matrix interrupt. Safe to call from interrupt
+ * handlers.
+ */
+void idle_wakeup(void);
@@ -18,5 +18,5 @@
 #include <inttypes.h>
 
 void wait_ms(uint32_t ms);
-#define wait_us(us) wait_ms(us / 1000)
+void wait_us(uint32_t us);
 #define waitInputPinDelay()
@@ -17,21 +17,21 @@
 #include "timer.h"
 #include <stdatomic.h>
 
-static atomic_uint_least32_t current_time = 0;
+static atomic_uint_least64_t current_time_us = 0;
 
 void timer_init(void) {
-    current_time = 0;
+    current_time_us = 0;
 }
 
 void timer_clear(void) {
-    current_time = 0;
+    current_time_us = 0;
 }
 
 uint16_t timer_read(void) {
-    return current_time & 0xFFFF;
+    return timer_read32() & 0xFFFF;
 }
 uint32_t timer_read32(void) {
-    return current_time;
+    return current_time_us / 1000;
 }
 uint16_t timer_elapsed(uint16_t last) {
     return TIMER_DIFF_16(timer_read(), last);
@@ -40,13 +40,26 @@ uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(timer_read32(), last);
 }
 
+uint32_t timer_read_us(void) {
+    return current_time_us;
+}
+uint32_t timer_elapsed_us(uint32_t last) {
+    return TIMER_DIFF_32(timer_read_us(), last);
+}
+
 void set_time(uint32_t t) {
-    current_time = t;
+    current_time_us = (uint64_t)t * 1000;
 }
 void advance_time(uint32_t ms) {
-    current_time += ms;
+    current_time_us += (uint64_t)ms * 1000;
+}
+void advance_time_us(uint32_t us) {
+    current_time_us += us;
 }
 
 void wait_ms(uint32_t ms) {
     advance_time(ms);
 }
+void wait_us(uint32_t us) {
+    advance_time_us(us);
+}
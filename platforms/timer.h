@@ -43,9 +43,15 @@ uint32_t timer_read32(void);
 uint16_t timer_elapsed(uint16_t last);
 uint32_t timer_elapsed32(uint32_t last);
 
+// Microsecond clock for measuring short intervals, as fine as the platform's timer allows. It wraps around roughly every
+// 71 minutes, so only the difference between two readings is meaningful.
+uint32_t timer_read_us(void);
+uint32_t timer_elapsed_us(uint32_t last);
+
 // Utility functions to check if a future time has expired & autmatically handle time wrapping if checked / reset frequently (half of max value)
 #define timer_expired(current, future) ((uint16_t)(current - future) < UINT16_MAX / 2)
 #define timer_expired32(current, future) ((uint32_t)(current - future) < UINT32_MAX / 2)
+#define timer_expired_us(current, future) timer_expired32(current, future)
 
 // Use an appropriate timer integer size based on architecture (16-bit will overflow sooner)
 #if FAST_TIMER_T_SIZE < 32
@@ -54,6 +54,20 @@ int retro_tapping_counter = 0;
 #    include "process_auto_shift.h"
 #endif
 
+// When the next tick event is due, as a 32-bit timer value so that a deadline
+// stays in the past however long the keyboard task was not running for.
+static bool     tick_scheduled = true;
+static bool     tick_running   = false;
+static uint32_t tick_deadline  = 0;
+
+#ifdef DEBUG_ACTION_EXEC_COUNT
+static uint32_t action_exec_count = 0;
+
+uint32_t get_action_exec_count(void) {
+    return action_exec_count;
+}
+#endif
+
 #ifdef HOLD_ON_OTHER_KEY_PRESS_PER_KEY
 __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) {
     return false;
@@ -66,11 +80,61 @@ __attribute__((weak)) bool get_retro_tapping(uint16_t keycode, keyrecord_t *reco
 }
 #endif
 
+/** \brief Schedules a tick event
+ *
+ * Asks for a tick event to be generated no earlier than the supplied time. Anything
+ * driven by ticks needs to do so after each tick it receives, as any tick clears the
+ * schedule, and whenever it starts waiting for a timeout.
+ */
+void action_schedule_tick(uint16_t time) {
+    const uint32_t now   = timer_read32();
+    int16_t        delay = (int16_t)(time - (uint16_t)now);
+    if (delay < 0) {
+        delay = 0;
+    }
+    // At most one tick per millisecond
+    if (delay == 0 && tick_running) {
+        delay = 1;
+    }
+
+    if (!tick_scheduled || (!timer_expired32(now, tick_deadline) && tick_deadline - now > (uint32_t)delay)) {
+        tick_deadline  = now + delay;
+        tick_scheduled = true;
+    }
+}
+
+/** \brief Whether a scheduled tick event is due
+ */
+bool action_tick_due(void) {
+    return tick_scheduled && timer_expired32(timer_read32(), tick_deadline);
+}
+
+/** \brief Milliseconds until the next tick event is due
+ *
+ * UINT32_MAX if none is scheduled.
+ */
+uint32_t action_tick_remaining(void) {
+    if (!tick_scheduled) {
+        return UINT32_MAX;
+    }
+    const uint32_t now = timer_read32();
+    return timer_expired32(now, tick_deadline) ? 0 : tick_deadline - now;
+}
+
 /** \brief Called to execute an action.
  *
  * FIXME: Needs documentation.
  */
 void action_exec(keyevent_t event) {
+#ifdef DEBUG_ACTION_EXEC_COUNT
+    action_exec_count++;
+#endif
+
+    if (IS_NOEVENT(event)) {
+        tick_scheduled = false;
+        tick_running   = true;
+    }
+
     if (IS_EVENT(event)) {
         ac_dprintf("\n---- action_exec: start -----\n");
         ac_dprintf("EVENT: ");
@@ -109,6 +173,7 @@ void action_exec(keyevent_t event) {
             clear_oneshot_swaphands();
         }
 #        endif
+        schedule_oneshot_timeouts();
 #    endif
     }
 #endif
@@ -132,6 +197,8 @@ void action_exec(keyevent_t event) {
         dprintln();
     }
 #endif
+
+    tick_running = false;
 }
 
 #ifdef SWAP_HANDS_ENABLE
@@ -925,7 +992,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
         // Force a new key press if the key is already pressed
         // without this, keys with the same keycode, but different
         // modifiers will be reported incorrectly, see issue #1708
-        if (is_key_pressed(keyboard_report, code)) {
+        if (has_key(code)) {
             del_key(code);
             send_keyboard_report();
         }
@@ -58,6 +58,15 @@ typedef struct {
 /* Execute action per keyevent */
 void action_exec(keyevent_t event);
 
+/* Tick event scheduling */
+void     action_schedule_tick(uint16_t time);
+bool     action_tick_due(void);
+uint32_t action_tick_remaining(void);
+
+#ifdef DEBUG_ACTION_EXEC_COUNT
+uint32_t get_action_exec_count(void);
+#endif
+
 /* action for key */
 action_t action_for_key(uint8_t layer, keypos_t key);
 action_t action_for_keycode(uint16_t keycode);
@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
@@ -20,8 +21,8 @@
 #    else
 #        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)) && tapping_key.keycode == r->keycode)
 #    endif
-#    define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
-#    define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_QUICK_TAP_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
+#    define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < tapping_key_config.tapping_term)
+#    define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < tapping_key_config.quick_tap_term)
 
 #    ifdef DYNAMIC_TAPPING_TERM_ENABLE
 uint16_t g_tapping_term = TAPPING_TERM;
@@ -64,7 +65,25 @@ static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+// Per-key settings of the tapping key, looked up once when it is pressed
+// rather than on every event and tick while its outcome is undecided.
+static struct {
+    uint16_t keycode;
+    uint16_t tapping_term;
+    uint16_t quick_tap_term;
+    bool     permissive_hold;
+    bool     hold_on_other_key_press;
+    bool     retro_tapping;
+} tapping_key_config = {};
+
+// Whether reprocessing the waiting buffer would have the same outcome as last
+// time, so that only the passing of time can change the state machine.
+static bool tapping_settled = true;
+
 static bool process_tapping(keyrecord_t *record);
+static void tapping_key_start(keyrecord_t *record);
+static bool tapping_deadline_elapsed(uint16_t time);
+static void tapping_schedule_tick(uint16_t time);
 static bool waiting_buffer_enq(keyrecord_t record);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
@@ -78,6 +97,12 @@ static void debug_waiting_buffer(void);
  * FIXME: Needs doc
  */
 void action_tapping_process(keyrecord_t record) {
+    // Nothing can change on a tick until a deadline has passed
+    if (!IS_EVENT(record.event) && tapping_settled && !tapping_deadline_elapsed(record.event.time)) {
+        tapping_schedule_tick(record.event.time);
+        return;
+    }
+
     if (process_tapping(&record)) {
         if (IS_EVENT(record.event)) {
             ac_dprintf("processed: ");
@@ -98,40 +123,41 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
+    tapping_settled = true;
     for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+        keyrecord_t previous = tapping_key;
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
             ac_dprintf("\n\n");
         } else {
+            // The event stays in the buffer -- if it changed the tapping
+            // state, it needs another look on the next tick
+            tapping_settled = memcmp(&previous, &tapping_key, sizeof(keyrecord_t)) == 0;
             break;
         }
     }
+    tapping_schedule_tick(timer_read());
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     }
 }
 
 /* Some conditionally defined helper macros to keep process_tapping more
- * readable. The conditional definition of tapping_keycode and all the
- * conditional uses of it are hidden inside macros named TAP_...
+ * readable. The per-key settings of the tapping key are looked up by
+ * tapping_key_start(), and all the conditional uses of them are hidden
+ * inside macros named TAP_...
  */
-#    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
-#        define TAP_DEFINE_KEYCODE const uint16_t tapping_keycode = get_record_keycode(&tapping_key, false)
-#    else
-#        define TAP_DEFINE_KEYCODE
-#    endif
-
 #    if defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)
 #        ifdef RETRO_TAPPING_PER_KEY
-#            define TAP_GET_RETRO_TAPPING get_retro_tapping(tapping_keycode, &tapping_key)
+#            define TAP_GET_RETRO_TAPPING tapping_key_config.retro_tapping
 #        else
 #            define TAP_GET_RETRO_TAPPING true
 #        endif
 #        define MAYBE_RETRO_SHIFTING(ev) (TAP_GET_RETRO_TAPPING && (RETRO_SHIFT + 0) != 0 && TIMER_DIFF_16((ev).time, tapping_key.event.time) < (RETRO_SHIFT + 0))
-#        define TAP_IS_LT IS_QK_LAYER_TAP(tapping_keycode)
-#        define TAP_IS_MT IS_QK_MOD_TAP(tapping_keycode)
-#        define TAP_IS_RETRO IS_RETRO(tapping_keycode)
+#        define TAP_IS_LT IS_QK_LAYER_TAP(tapping_key_config.keycode)
+#        define TAP_IS_MT IS_QK_MOD_TAP(tapping_key_config.keycode)
+#        define TAP_IS_RETRO IS_RETRO(tapping_key_config.keycode)
 #    else
 #        define TAP_GET_RETRO_TAPPING false
 #        define MAYBE_RETRO_SHIFTING(ev) false
@@ -141,7 +167,7 @@ void action_tapping_process(keyrecord_t record) {
 #    endif
 
 #    ifdef PERMISSIVE_HOLD_PER_KEY
-#        define TAP_GET_PERMISSIVE_HOLD get_permissive_hold(tapping_keycode, &tapping_key)
+#        define TAP_GET_PERMISSIVE_HOLD tapping_key_config.permissive_hold
 #    elif defined(PERMISSIVE_HOLD)
 #        define TAP_GET_PERMISSIVE_HOLD true
 #    else
@@ -149,13 +175,80 @@ void action_tapping_process(keyrecord_t record) {
 #    endif
 
 #    ifdef HOLD_ON_OTHER_KEY_PRESS_PER_KEY
-#        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS get_hold_on_other_key_press(tapping_keycode, &tapping_key)
+#        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS tapping_key_config.hold_on_other_key_press
 #    elif defined(HOLD_ON_OTHER_KEY_PRESS)
 #        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS true
 #    else
 #        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS false
 #    endif
 
+/** \brief Start tapping key
+ *
+ * Makes the supplied key press the tapping key, and looks up its per-key settings.
+ */
+static void tapping_key_start(keyrecord_t *record) {
+    tapping_key = *record;
+
+#    if defined(TAPPING_TERM_PER_KEY) || defined(QUICK_TAP_TERM_PER_KEY) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
+    const uint16_t keycode = get_record_keycode(&tapping_key, false);
+#    else
+    const uint16_t keycode = KC_NO;
+#    endif
+    tapping_key_config.keycode        = keycode;
+    tapping_key_config.tapping_term   = GET_TAPPING_TERM(keycode, &tapping_key);
+    tapping_key_config.quick_tap_term = GET_QUICK_TAP_TERM(keycode, &tapping_key);
+#    ifdef PERMISSIVE_HOLD_PER_KEY
+    tapping_key_config.permissive_hold = get_permissive_hold(keycode, &tapping_key);
+#    endif
+#    ifdef HOLD_ON_OTHER_KEY_PRESS_PER_KEY
+    tapping_key_config.hold_on_other_key_press = get_hold_on_other_key_press(keycode, &tapping_key);
+#    endif
+#    if defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT) && defined(RETRO_TAPPING_PER_KEY)
+    tapping_key_config.retro_tapping = get_retro_tapping(keycode, &tapping_key);
+#    endif
+}
+
+/** \brief Tapping deadline elapsed
+ *
+ * Whether a tick at the supplied time could change the state of the tapping key,
+ * i.e. it has run past its tapping term without a decision having been made.
+ */
+static bool tapping_deadline_elapsed(uint16_t time) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        return false;
+    }
+
+    const keyevent_t tick = {.time = time};
+    if (WITHIN_TAPPING_TERM(tick) || MAYBE_RETRO_SHIFTING(tick)) {
+        return false;
+    }
+
+    // A tap which was already counted only ends with the next key event
+    return !(tapping_key.event.pressed && tapping_key.tap.count > 0);
+}
+
+/** \brief Tapping schedule tick
+ *
+ * Asks for the next tick event at the time the tapping key could next change
+ * state, so that no ticks are generated while it can't.
+ */
+static void tapping_schedule_tick(uint16_t time) {
+    if (!tapping_settled) {
+        action_schedule_tick(time);
+        return;
+    }
+    if (IS_NOEVENT(tapping_key.event)) {
+        return;
+    }
+
+    const keyevent_t tick = {.time = time};
+    if (WITHIN_TAPPING_TERM(tick)) {
+        action_schedule_tick(tapping_key.event.time + tapping_key_config.tapping_term);
+    } else if (MAYBE_RETRO_SHIFTING(tick) || tapping_deadline_elapsed(time)) {
+        action_schedule_tick(time);
+    }
+}
+
 /** \brief Tapping
  *
  * Rule: Tap key is typed(pressed and released) within TAPPING_TERM.
@@ -174,7 +267,7 @@ bool process_tapping(keyrecord_t *keyp) {
             // the currently pressed key is a tapping key, therefore transition
             // into the "pressed" tapping key state
             ac_dprintf("Tapping: Start(Press tap key).\n");
-            tapping_key = *keyp;
+            tapping_key_start(keyp);
             process_record_tap_hint(&tapping_key);
             waiting_buffer_scan_tap();
             debug_tapping_key();
@@ -187,8 +280,6 @@ bool process_tapping(keyrecord_t *keyp) {
         return true;
     }
 
-    TAP_DEFINE_KEYCODE;
-
     // process "pressed" tapping key state
     if (tapping_key.event.pressed) {
         if (WITHIN_TAPPING_TERM(event) || MAYBE_RETRO_SHIFTING(event)) {
@@ -326,7 +417,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     } else {
                         ac_dprintf("Tapping: Start while last tap(1).\n");
                     }
-                    tapping_key = *keyp;
+                    tapping_key_start(keyp);
                     waiting_buffer_scan_tap();
                     debug_tapping_key();
                     return true;
@@ -374,7 +465,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     } else {
                         ac_dprintf("Tapping: Start while last timeout tap(1).\n");
                     }
-                    tapping_key = *keyp;
+                    tapping_key_start(keyp);
                     waiting_buffer_scan_tap();
                     debug_tapping_key();
                     return true;
@@ -401,17 +492,17 @@ bool process_tapping(keyrecord_t *keyp) {
                         if (keyp->tap.count < 15) keyp->tap.count += 1;
                         ac_dprintf("Tapping: Tap press(%u)\n", keyp->tap.count);
                         process_record(keyp);
-                        tapping_key = *keyp;
+                        tapping_key_start(keyp);
                         debug_tapping_key();
                         return true;
                     }
                     // FIX: start new tap again
-                    tapping_key = *keyp;
+                    tapping_key_start(keyp);
                     return true;
                 } else if (is_tap_record(keyp)) {
                     // Sequential tap can be interfered with other tap key.
                     ac_dprintf("Tapping: Start with interfering other tap.\n");
-                    tapping_key = *keyp;
+                    tapping_key_start(keyp);
                     waiting_buffer_scan_tap();
                     debug_tapping_key();
                     return true;
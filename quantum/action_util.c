@@ -17,10 +17,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "report.h"
 #include "debug.h"
+#include "action.h"
 #include "action_util.h"
 #include "action_layer.h"
 #include "timer.h"
 #include "keycode_config.h"
+#include "util.h"
 #include <string.h>
 
 extern keymap_config_t keymap_config;
@@ -36,9 +38,120 @@ static uint8_t suppressed_mods    = 0;
 // report_keyboard_t keyboard_report = {};
 report_keyboard_t *keyboard_report = &(report_keyboard_t){};
 
-extern inline void add_key(uint8_t key);
-extern inline void del_key(uint8_t key);
-extern inline void clear_keys(void);
+// Every key which is currently pressed, as a bitset indexed by keycode. The
+// keys of keyboard_report are built from this when it is sent, in whichever of
+// the 6KRO and NKRO formats is in use.
+static uint8_t pressed_keys[256 / 8] = {0};
+// Keys pressed since they were last added to a 6KRO report, including any
+// which didn't fit, so that they can take the place of a released key.
+static uint8_t added_keys[256 / 8] = {0};
+static bool    keys_changed        = false;
+static bool    report_nkro         = false;
+
+#define KEY_BIT_IS_SET(bits, key) ((bits)[(key) >> 3] & (1 << ((key)&7)))
+#define KEY_BIT_SET(bits, key) ((bits)[(key) >> 3] |= (1 << ((key)&7)))
+#define KEY_BIT_CLEAR(bits, key) ((bits)[(key) >> 3] &= ~(1 << ((key)&7)))
+
+/** \brief Adds a key to the keyboard report, the next time it is sent
+ */
+void add_key(uint8_t key) {
+    if (key == KC_NO || KEY_BIT_IS_SET(pressed_keys, key)) {
+        return;
+    }
+    KEY_BIT_SET(pressed_keys, key);
+    KEY_BIT_SET(added_keys, key);
+    keys_changed = true;
+}
+
+/** \brief Removes a key from the keyboard report, the next time it is sent
+ */
+void del_key(uint8_t key) {
+    if (!KEY_BIT_IS_SET(pressed_keys, key)) {
+        return;
+    }
+    KEY_BIT_CLEAR(pressed_keys, key);
+    KEY_BIT_CLEAR(added_keys, key);
+    keys_changed = true;
+}
+
+/** \brief Removes all keys from the keyboard report, the next time it is sent
+ */
+void clear_keys(void) {
+    memset(pressed_keys, 0, sizeof(pressed_keys));
+    memset(added_keys, 0, sizeof(added_keys));
+    keys_changed = true;
+}
+
+/** \brief Whether a key has been added to the keyboard report
+ */
+bool has_key(uint8_t key) {
+    return key != KC_NO && KEY_BIT_IS_SET(pressed_keys, key);
+}
+
+/** \brief Updates the keys of the keyboard report from the keys which are pressed
+ *
+ * Keys stay in the same slot of a 6KRO report while they are held, and new keys
+ * fill the empty slots as add_key_byte() would place them.
+ */
+static void update_report_keys(void) {
+    bool nkro = false;
+#ifdef NKRO_ENABLE
+    nkro = keyboard_protocol && keymap_config.nkro;
+#endif
+
+    if (nkro != report_nkro) {
+        // The formats overlap, so start the new one over from scratch
+        report_nkro = nkro;
+        memset(keyboard_report->keys, 0, sizeof(keyboard_report->keys));
+#ifdef NKRO_ENABLE
+        memset(keyboard_report->nkro.bits, 0, sizeof(keyboard_report->nkro.bits));
+#endif
+        memcpy(added_keys, pressed_keys, sizeof(added_keys));
+        keys_changed = true;
+    }
+
+    if (!keys_changed) {
+        return;
+    }
+    keys_changed = false;
+
+#ifdef NKRO_ENABLE
+    if (nkro) {
+        memcpy(keyboard_report->nkro.bits, pressed_keys, MIN(sizeof(keyboard_report->nkro.bits), sizeof(pressed_keys)));
+        return;
+    }
+#endif
+
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        const uint8_t key = keyboard_report->keys[i];
+        if (key != KC_NO && !KEY_BIT_IS_SET(pressed_keys, key)) {
+            del_key_byte(keyboard_report, key);
+        }
+    }
+
+    for (uint8_t i = 0; i < sizeof(added_keys); i++) {
+        if (!added_keys[i]) {
+            continue;
+        }
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (added_keys[i] & (1 << bit)) {
+                add_key_byte(keyboard_report, i << 3 | bit);
+            }
+        }
+    }
+
+#ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
+    // Older keys pushed out of the ring stay out
+    memset(added_keys, 0, sizeof(added_keys));
+#else
+    // Anything still left over didn't fit, and is tried again after the next change
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i] != KC_NO) {
+            KEY_BIT_CLEAR(added_keys, keyboard_report->keys[i]);
+        }
+    }
+#endif
+}
 
 #ifndef NO_ACTION_ONESHOT
 static uint8_t oneshot_mods        = 0;
@@ -119,6 +232,22 @@ inline bool     has_oneshot_swaphands_timed_out(void) {
     return TIMER_DIFF_16(timer_read(), oneshot_swaphands_time) >= ONESHOT_TIMEOUT && (swap_hands_oneshot == SHO_ACTIVE);
 }
 #        endif
+
+/** \brief Schedules a tick event for each oneshot state which can time out
+ */
+void schedule_oneshot_timeouts(void) {
+    if (oneshot_mods) {
+        action_schedule_tick(oneshot_time + ONESHOT_TIMEOUT);
+    }
+    if (get_oneshot_layer_state() && !(get_oneshot_layer_state() & ONESHOT_TOGGLED)) {
+        action_schedule_tick(oneshot_layer_time + ONESHOT_TIMEOUT);
+    }
+#        ifdef SWAP_HANDS_ENABLE
+    if (swap_hands_oneshot == SHO_ACTIVE) {
+        action_schedule_tick(oneshot_swaphands_time + ONESHOT_TIMEOUT);
+    }
+#        endif
+}
 #    endif
 
 #    ifdef SWAP_HANDS_ENABLE
@@ -137,6 +266,9 @@ void set_oneshot_swaphands(void) {
 void release_oneshot_swaphands(void) {
     if (swap_hands_oneshot == SHO_PRESSED) {
         swap_hands_oneshot = SHO_ACTIVE;
+#        if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+        schedule_oneshot_timeouts();
+#        endif
     }
     if (swap_hands_oneshot == SHO_USED) {
         clear_oneshot_swaphands();
@@ -172,6 +304,7 @@ void set_oneshot_layer(uint8_t layer, uint8_t state) {
         layer_on(layer);
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
         oneshot_layer_time = timer_read();
+        schedule_oneshot_timeouts();
 #    endif
         oneshot_layer_changed_kb(get_oneshot_layer());
     } else {
@@ -257,6 +390,8 @@ bool is_oneshot_enabled(void) {
  * FIXME: needs doc
  */
 void send_keyboard_report(void) {
+    update_report_keys();
+
     keyboard_report->mods = real_mods;
     keyboard_report->mods |= weak_mods;
 
@@ -402,10 +537,11 @@ uint8_t get_oneshot_mods(void) {
 
 void add_oneshot_mods(uint8_t mods) {
     if ((oneshot_mods & mods) != mods) {
+        oneshot_mods |= mods;
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
         oneshot_time = timer_read();
+        schedule_oneshot_timeouts();
 #    endif
-        oneshot_mods |= mods;
         oneshot_mods_changed_kb(mods);
     }
 }
@@ -427,10 +563,11 @@ void del_oneshot_mods(uint8_t mods) {
 void set_oneshot_mods(uint8_t mods) {
     if (keymap_config.oneshot_enable) {
         if (oneshot_mods != mods) {
+            oneshot_mods = mods;
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
             oneshot_time = timer_read();
+            schedule_oneshot_timeouts();
 #    endif
-            oneshot_mods = mods;
             oneshot_mods_changed_kb(mods);
         }
     }
@@ -30,17 +30,10 @@ extern report_keyboard_t *keyboard_report;
 void send_keyboard_report(void);
 
 /* key */
-inline void add_key(uint8_t key) {
-    add_key_to_report(keyboard_report, key);
-}
-
-inline void del_key(uint8_t key) {
-    del_key_from_report(keyboard_report, key);
-}
-
-inline void clear_keys(void) {
-    clear_keys_from_report(keyboard_report);
-}
+void add_key(uint8_t key);
+void del_key(uint8_t key);
+void clear_keys(void);
+bool has_key(uint8_t key);
 
 /* modifier */
 uint8_t get_mods(void);
@@ -79,6 +72,7 @@ bool    is_oneshot_layer_active(void);
 uint8_t get_oneshot_layer_state(void);
 bool    has_oneshot_layer_timed_out(void);
 bool    has_oneshot_swaphands_timed_out(void);
+void    schedule_oneshot_timeouts(void);
 
 void oneshot_locked_mods_changed_user(uint8_t mods);
 void oneshot_locked_mods_changed_kb(uint8_t mods);
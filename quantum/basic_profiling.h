@@ -21,15 +21,17 @@
         });
 */
 
-#if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
-#    define TIMESTAMP_GETTER TCNT0
-#elif defined(PROTOCOL_CHIBIOS)
-#    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
-#elif defined(PROTOCOL_ARM_ATSAM)
-#    error arm_atsam not currently supported
-#else
-#    error Unknown protocol in use
-#endif
+#ifndef TIMESTAMP_GETTER
+#    if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
+#        define TIMESTAMP_GETTER TCNT0
+#    elif defined(PROTOCOL_CHIBIOS)
+#        define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
+#    else
+// No cycle counter available, fall back to the microsecond timer
+#        include "timer.h"
+#        define TIMESTAMP_GETTER timer_read_us()
+#    endif
+#endif // TIMESTAMP_GETTER
 
 #ifndef CONSOLE_ENABLE
 // Can't do anything if we don't have console output enabled.
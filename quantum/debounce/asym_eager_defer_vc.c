@@ -0,0 +1,132 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Asymmetric per-key algorithm, using vertical counters.
+After pressing a key, it immediately changes state, with no further state changes
+accepted until DEBOUNCE milliseconds have occurred. After releasing a key, that
+state is pushed after no changes occur for DEBOUNCE milliseconds.
+
+Behaves exactly like asym_eager_defer_pk, but each bit of the per-key counters is
+stored in its own matrix_row_t, so a whole row of counters is updated with a few
+bitwise operations instead of one key at a time, and without allocating any memory.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 127ms
+#if DEBOUNCE > 127
+#    undef DEBOUNCE
+#    define DEBOUNCE 127
+#endif
+
+#if DEBOUNCE > 0
+#    include "vertical_counter.h"
+
+static matrix_row_t counters[DEBOUNCE_COUNTER_BITS][MATRIX_ROWS];
+static matrix_row_t pressed[MATRIX_ROWS];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         matrix_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        vertical_counter_set(counters, row, ~(matrix_row_t)0, 0);
+        pressed[row] = 0;
+    }
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed || matrix_need_update) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        transfer_matrix_values(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t expired = vertical_counter_subtract(counters, row, elapsed_time);
+
+        // key-down: eager
+        if (expired & pressed[row]) {
+            matrix_need_update = true;
+        }
+
+        // key-up: defer
+        matrix_row_t released = expired & ~pressed[row];
+        if (released) {
+            matrix_row_t cooked_next = (cooked[row] & ~released) | (raw[row] & released);
+            cooked_changed |= cooked_next ^ cooked[row];
+            cooked[row] = cooked_next;
+        }
+
+        counters_need_update |= vertical_counter_active(counters, row) != 0;
+    }
+}
+
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_need_update = false;
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta  = raw[row] ^ cooked[row];
+        matrix_row_t active = vertical_counter_active(counters, row);
+        matrix_row_t start  = delta & ~active;
+
+        if (start) {
+            vertical_counter_set(counters, row, start, DEBOUNCE);
+            pressed[row]         = (pressed[row] & ~start) | (raw[row] & start);
+            counters_need_update = true;
+
+            // key-down: eager
+            if (start & raw[row]) {
+                cooked[row] ^= start & raw[row];
+                cooked_changed = true;
+            }
+        }
+
+        // key-up: defer
+        vertical_counter_set(counters, row, ~delta & active & ~pressed[row], 0);
+    }
+}
+
+#else
+#    include "none.c"
+#endif
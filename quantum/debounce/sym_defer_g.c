@@ -25,8 +25,22 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 #endif
 
 #if DEBOUNCE > 0
-static bool         debouncing = false;
-static fast_timer_t debouncing_time;
+// Where the timer is cheap enough, time from the change itself rather than from the start of the millisecond it
+// happened in, which would shorten the debounce time by up to a millisecond
+#    if FAST_TIMER_T_SIZE < 32
+#        define DEBOUNCE_TIME DEBOUNCE
+#        define debounce_timer_read() timer_read_fast()
+#        define debounce_timer_elapsed(last) timer_elapsed_fast(last)
+typedef fast_timer_t debounce_timer_t;
+#    else
+#        define DEBOUNCE_TIME (DEBOUNCE * 1000UL)
+#        define debounce_timer_read() timer_read_us()
+#        define debounce_timer_elapsed(last) timer_elapsed_us(last)
+typedef uint32_t debounce_timer_t;
+#    endif
+
+static bool             debouncing = false;
+static debounce_timer_t debouncing_time;
 
 void debounce_init(uint8_t num_rows) {}
 
@@ -35,10 +49,10 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 
     if (changed) {
         debouncing      = true;
-        debouncing_time = timer_read_fast();
+        debouncing_time = debounce_timer_read();
     }
 
-    if (debouncing && timer_elapsed_fast(debouncing_time) >= DEBOUNCE) {
+    if (debouncing && debounce_timer_elapsed(debouncing_time) >= DEBOUNCE_TIME) {
         if (memcmp(cooked, raw, sizeof(matrix_row_t) * num_rows) != 0) {
             memcpy(cooked, raw, sizeof(matrix_row_t) * num_rows);
             cooked_changed = true;
@@ -0,0 +1,90 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdio>
+
+extern "C" {
+#include "debounce.h"
+#include "matrix.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+/* Scans of a whole matrix of keys being pressed and released, with contact bounce
+ * on each change, at a 4kHz scan rate. The same pattern is used for every
+ * algorithm and matrix width, so the results can be compared directly. */
+class DebounceBenchmark : public ::testing::Test {
+   protected:
+    static const int scans = 200000;
+
+    matrix_row_t raw[MATRIX_ROWS]    = {0};
+    matrix_row_t cooked[MATRIX_ROWS] = {0};
+    uint32_t     seed                = 1;
+
+    uint32_t next_random() {
+        seed = seed * 1103515245 + 12345;
+        return seed >> 16;
+    }
+
+    bool scan(int i) {
+        bool changed = false;
+
+        /* A key changes every few scans, then bounces for the next few */
+        if (i % 4 == 0) {
+            uint32_t key = next_random();
+            raw[key % MATRIX_ROWS] ^= (matrix_row_t)1 << ((key / MATRIX_ROWS) % MATRIX_COLS);
+            changed = true;
+        } else if (i % 4 == 1 && next_random() % 2) {
+            uint32_t key = next_random();
+            raw[key % MATRIX_ROWS] ^= (matrix_row_t)1 << ((key / MATRIX_ROWS) % MATRIX_COLS);
+            changed = true;
+        }
+
+        if (i % 4 == 3) {
+            advance_time(1);
+        }
+        return debounce(raw, cooked, MATRIX_ROWS, changed);
+    }
+};
+
+TEST_F(DebounceBenchmark, keys_settle) {
+    unsigned changes = 0;
+
+    set_time(1000);
+    debounce_init(MATRIX_ROWS);
+    for (int i = 0; i < scans; i++) {
+        changes += scan(i);
+    }
+
+    /* Once the keys are left alone, the debounced state catches up with them */
+    for (int i = 0; i < 1000; i++) {
+        advance_time(1);
+        debounce(raw, cooked, MATRIX_ROWS, false);
+    }
+    debounce_free();
+
+    EXPECT_GT(changes, 0u);
+    for (int row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(raw[row], cooked[row]) << "row " << row;
+    }
+}
+
+/* Not a pass/fail test; run with --gtest_also_run_disabled_tests to compare algorithms */
+TEST_F(DebounceBenchmark, DISABLED_scan_cost) {
+    set_time(1000);
+    debounce_init(MATRIX_ROWS);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < scans; i++) {
+        scan(i);
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / scans;
+    printf("%dx%d matrix: %.1fns per scan\n", MATRIX_ROWS, MATRIX_COLS, elapsed);
+
+    debounce_free();
+}
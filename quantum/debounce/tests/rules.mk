@@ -23,11 +23,19 @@ debounce_sym_defer_g_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_g.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_g_tests.cpp
 
+debounce_sym_defer_g_us_DEFS := $(DEBOUNCE_COMMON_DEFS) -DFAST_TIMER_T_SIZE=32
+debounce_sym_defer_g_us_SRC := $(debounce_sym_defer_g_SRC)
+
 debounce_sym_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
 
+debounce_sym_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
+
 debounce_sym_defer_pr_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_defer_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pr.c \
@@ -47,3 +55,35 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+debounce_asym_eager_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_asym_eager_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/asym_eager_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+DEBOUNCE_BENCHMARK_SRC := $(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+debounce_sym_defer_pk_benchmark_8_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=8 -DDEBOUNCE=5
+debounce_sym_defer_pk_benchmark_8_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c
+
+debounce_sym_defer_pk_benchmark_16_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=16 -DDEBOUNCE=5
+debounce_sym_defer_pk_benchmark_16_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c
+
+debounce_sym_defer_pk_benchmark_32_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=32 -DDEBOUNCE=5
+debounce_sym_defer_pk_benchmark_32_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c
+
+debounce_sym_defer_vc_benchmark_8_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=8 -DDEBOUNCE=5
+debounce_sym_defer_vc_benchmark_8_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c
+
+debounce_sym_defer_vc_benchmark_16_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=16 -DDEBOUNCE=5
+debounce_sym_defer_vc_benchmark_16_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c
+
+debounce_sym_defer_vc_benchmark_32_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=32 -DDEBOUNCE=5
+debounce_sym_defer_vc_benchmark_32_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c
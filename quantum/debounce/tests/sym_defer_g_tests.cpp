@@ -236,3 +236,36 @@ TEST_F(DebounceTest, OneKeyDelayedScan4) {
     time_jumps_ = true;
     runEvents();
 }
+
+#if FAST_TIMER_T_SIZE >= 32
+extern "C" {
+#    include "debounce.h"
+
+void set_time(uint32_t t);
+void advance_time_us(uint32_t us);
+}
+
+TEST(DebounceSubMillisecond, TimedFromTheChange) {
+    matrix_row_t raw[MATRIX_ROWS]    = {0};
+    matrix_row_t cooked[MATRIX_ROWS] = {0};
+
+    debounce_init(MATRIX_ROWS);
+    set_time(7777);
+
+    /* Change late in a millisecond */
+    advance_time_us(900);
+    raw[0] = 1;
+    EXPECT_FALSE(debounce(raw, cooked, MATRIX_ROWS, true));
+
+    /* DEBOUNCE milliseconds have been counted, but not that long has passed */
+    advance_time_us(DEBOUNCE * 1000 - 500);
+    EXPECT_FALSE(debounce(raw, cooked, MATRIX_ROWS, false));
+    EXPECT_EQ(cooked[0], 0);
+
+    advance_time_us(500);
+    EXPECT_TRUE(debounce(raw, cooked, MATRIX_ROWS, false));
+    EXPECT_EQ(cooked[0], 1);
+
+    debounce_free();
+}
+#endif
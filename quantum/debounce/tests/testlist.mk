@@ -1,7 +1,16 @@
 TEST_LIST += \
 	debounce_sym_defer_g \
+	debounce_sym_defer_g_us \
 	debounce_sym_defer_pk \
+	debounce_sym_defer_vc \
 	debounce_sym_defer_pr \
 	debounce_sym_eager_pk \
 	debounce_sym_eager_pr \
-	debounce_asym_eager_defer_pk
+	debounce_asym_eager_defer_pk \
+	debounce_asym_eager_defer_vc \
+	debounce_sym_defer_pk_benchmark_8 \
+	debounce_sym_defer_pk_benchmark_16 \
+	debounce_sym_defer_pk_benchmark_32 \
+	debounce_sym_defer_vc_benchmark_8 \
+	debounce_sym_defer_vc_benchmark_16 \
+	debounce_sym_defer_vc_benchmark_32
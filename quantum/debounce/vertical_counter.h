@@ -0,0 +1,86 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Vertical counters for the debounce algorithms: bit n of every counter in a row is
+kept in counters[n][row], so that a whole row of counters can be updated at once.
+A counter of zero is not counting.
+*/
+
+#pragma once
+
+#include "matrix.h"
+
+#if DEBOUNCE < 2
+#    define DEBOUNCE_COUNTER_BITS 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_COUNTER_BITS 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_COUNTER_BITS 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_COUNTER_BITS 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_COUNTER_BITS 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_COUNTER_BITS 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_COUNTER_BITS 7
+#else
+#    define DEBOUNCE_COUNTER_BITS 8
+#endif
+
+/** \brief The counters in a row that are counting */
+static inline matrix_row_t vertical_counter_active(matrix_row_t counters[][MATRIX_ROWS], uint8_t row) {
+    matrix_row_t active = 0;
+    for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+        active |= counters[bit][row];
+    }
+    return active;
+}
+
+/** \brief Sets the counters selected by mask to value */
+static inline void vertical_counter_set(matrix_row_t counters[][MATRIX_ROWS], uint8_t row, matrix_row_t mask, uint8_t value) {
+    for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+        if (value & (1 << bit)) {
+            counters[bit][row] |= mask;
+        } else {
+            counters[bit][row] &= ~mask;
+        }
+    }
+}
+
+/** \brief Counts down every counter in a row by amount
+ *
+ * \return The counters that reached zero, which stop counting
+ */
+static inline matrix_row_t vertical_counter_subtract(matrix_row_t counters[][MATRIX_ROWS], uint8_t row, uint8_t amount) {
+    matrix_row_t active = vertical_counter_active(counters, row);
+    if (!active) {
+        return 0;
+    }
+    if (amount >= DEBOUNCE) {
+        // No counter starts any higher than DEBOUNCE
+        vertical_counter_set(counters, row, active, 0);
+        return active;
+    }
+
+    // Ripple-borrow subtraction, one bit of every counter at a time
+    matrix_row_t borrow    = 0;
+    matrix_row_t remaining = 0;
+    for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+        matrix_row_t value = counters[bit][row];
+        if (amount & (1 << bit)) {
+            counters[bit][row] = ~(value ^ borrow);
+            borrow             = ~value | borrow;
+        } else {
+            counters[bit][row] = value ^ borrow;
+            borrow             = ~value & borrow;
+        }
+        remaining |= counters[bit][row];
+    }
+
+    // Counters that went to zero or below have expired, and those that weren't counting stay at zero
+    matrix_row_t expired = active & (borrow | ~remaining);
+    vertical_counter_set(counters, row, expired | ~active, 0);
+    return expired;
+}
@@ -14,6 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
@@ -21,6 +23,7 @@
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "util.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -101,6 +104,14 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+// Size of the RAM window macros are streamed through when being sent
+#ifndef DYNAMIC_KEYMAP_MACRO_WINDOW_SIZE
+#    define DYNAMIC_KEYMAP_MACRO_WINDOW_SIZE 16
+#endif
+
+// The window has to hold the longest token, a 7 byte delay, and its length and position are uint8_t
+_Static_assert(DYNAMIC_KEYMAP_MACRO_WINDOW_SIZE >= 7 && DYNAMIC_KEYMAP_MACRO_WINDOW_SIZE <= 255, "DYNAMIC_KEYMAP_MACRO_WINDOW_SIZE must be between 7 and 255");
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -167,32 +178,24 @@ void dynamic_keymap_reset(void) {
     }
 }
 
-void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+// Number of bytes of the supplied buffer range which fall within the dynamic keymap
+static uint16_t dynamic_keymap_buffer_length(uint16_t offset, uint16_t size) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
+    if (offset >= dynamic_keymap_eeprom_size) {
+        return 0;
     }
+    return MIN(size, dynamic_keymap_eeprom_size - offset);
+}
+
+void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t length = dynamic_keymap_buffer_length(offset, size);
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), length);
+    memset(data + length, 0x00, size - length);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    uint16_t length = dynamic_keymap_buffer_length(offset, size);
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), length);
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -219,30 +222,74 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
     return DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
 }
 
-void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
+// Start offset of each macro within the buffer, so sending a macro doesn't
+// need to scan past all of the ones before it. Rebuilt on the next send after
+// the buffer is modified.
+static uint16_t macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT];
+static uint8_t  macro_offsets_count = 0;
+static bool     macro_offsets_valid = false;
+
+// Streams the macro buffer from EEPROM through a small RAM window
+typedef struct {
+    uint16_t offset; // buffer offset of window[0]
+    uint8_t  length;
+    uint8_t  position;
+    uint8_t  window[DYNAMIC_KEYMAP_MACRO_WINDOW_SIZE];
+} macro_reader_t;
+
+static void macro_reader_init(macro_reader_t *reader, uint16_t offset) {
+    reader->offset   = offset;
+    reader->length   = 0;
+    reader->position = 0;
+}
+
+// Returns the next byte of the buffer, or a null once past its end
+static uint8_t macro_reader_next(macro_reader_t *reader) {
+    if (reader->position == reader->length) {
+        reader->offset += reader->length;
+        if (reader->offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+            return 0;
         }
-        source++;
-        target++;
+        reader->length   = MIN(sizeof(reader->window), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - reader->offset);
+        reader->position = 0;
+        eeprom_read_block(reader->window, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + reader->offset), reader->length);
     }
+    return reader->window[reader->position++];
 }
 
-void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
+static void dynamic_keymap_macro_build_index(void) {
+    macro_reader_t reader;
+    macro_reader_init(&reader, 0);
+
+    bool at_start       = true;
+    macro_offsets_count = 0;
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE && macro_offsets_count < DYNAMIC_KEYMAP_MACRO_COUNT; offset++) {
+        if (at_start) {
+            macro_offsets[macro_offsets_count++] = offset;
         }
-        source++;
-        target++;
+        at_start = macro_reader_next(&reader) == 0;
     }
+    macro_offsets_valid = true;
+}
+
+// Number of bytes of the supplied buffer range which fall within the macro buffer
+static uint16_t dynamic_keymap_macro_buffer_length(uint16_t offset, uint16_t size) {
+    if (offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        return 0;
+    }
+    return MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset);
+}
+
+void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t length = dynamic_keymap_macro_buffer_length(offset, size);
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), length);
+    memset(data + length, 0x00, size - length);
+}
+
+void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t length = dynamic_keymap_macro_buffer_length(offset, size);
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), length);
+    macro_offsets_valid = false;
 }
 
 void dynamic_keymap_macro_reset(void) {
@@ -252,6 +299,55 @@ void dynamic_keymap_macro_reset(void) {
         eeprom_update_byte(p, 0);
         ++p;
     }
+    macro_offsets_valid = false;
+}
+
+// Reads the next send_string token of a macro into token, returning its length.
+// Returns 0 at the end of the macro, or if the token is truncated.
+static uint8_t dynamic_keymap_macro_read_token(macro_reader_t *reader, char *token) {
+    uint8_t length = 0;
+
+    token[length] = macro_reader_next(reader);
+    // Stop at the null terminator of this macro string
+    if (token[length++] == 0) {
+        return 0;
+    }
+    if (token[0] == SS_QMK_PREFIX) {
+        // Get the code
+        token[length] = macro_reader_next(reader);
+        // Unexpected null, abort.
+        if (token[length++] == 0) {
+            return 0;
+        }
+        if (token[1] == SS_TAP_CODE || token[1] == SS_DOWN_CODE || token[1] == SS_UP_CODE) {
+            // Get the keycode
+            token[length] = macro_reader_next(reader);
+            // Unexpected null, abort.
+            if (token[length++] == 0) {
+                return 0;
+            }
+        } else if (token[1] == SS_DELAY_CODE) {
+            // Get the number and '|'
+            // At most this is 4 digits plus '|'
+            while (1) {
+                token[length] = macro_reader_next(reader);
+                // Unexpected null, abort
+                if (token[length] == 0) {
+                    return 0;
+                }
+                // Found '|', send it
+                if (token[length++] == '|') {
+                    break;
+                }
+                // If haven't found '|' by the 5th character then
+                // number too big, abort
+                if (length == 7) {
+                    return 0;
+                }
+            }
+        }
+    }
+    return length;
 }
 
 void dynamic_keymap_macro_send(uint8_t id) {
@@ -268,73 +364,36 @@ void dynamic_keymap_macro_send(uint8_t id) {
         return;
     }
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then there is
-        // no Nth macro in the buffer.
-        if (p == end) {
-            return;
-        }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
-        }
-        ++p;
+    if (!macro_offsets_valid) {
+        dynamic_keymap_macro_build_index();
     }
+    // There is no Nth macro in the buffer.
+    if (id >= macro_offsets_count) {
+        return;
+    }
+
+    macro_reader_t reader;
+    macro_reader_init(&reader, macro_offsets[id]);
 
-    // Send the macro string by making a temporary string.
-    char data[8] = {0};
+    // Whole tokens are collected into a temporary string, which is sent
+    // whenever the next token doesn't fit.
+    char    data[DYNAMIC_KEYMAP_MACRO_WINDOW_SIZE + 1];
+    char    token[8];
+    uint8_t length = 0;
+    uint8_t token_length;
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
-    while (1) {
-        data[0] = eeprom_read_byte(p++);
-        data[1] = 0;
-        // Stop at the null terminator of this macro string
-        if (data[0] == 0) {
-            break;
+    while ((token_length = dynamic_keymap_macro_read_token(&reader, token)) > 0) {
+        if (length + token_length > DYNAMIC_KEYMAP_MACRO_WINDOW_SIZE) {
+            data[length] = 0;
+            send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
+            length = 0;
         }
-        if (data[0] == SS_QMK_PREFIX) {
-            // Get the code
-            data[1] = eeprom_read_byte(p++);
-            // Unexpected null, abort.
-            if (data[1] == 0) {
-                return;
-            }
-            if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
-                // Get the keycode
-                data[2] = eeprom_read_byte(p++);
-                // Unexpected null, abort.
-                if (data[2] == 0) {
-                    return;
-                }
-                // Null terminate
-                data[3] = 0;
-            } else if (data[1] == SS_DELAY_CODE) {
-                // Get the number and '|'
-                // At most this is 4 digits plus '|'
-                uint8_t i = 2;
-                while (1) {
-                    data[i] = eeprom_read_byte(p++);
-                    // Unexpected null, abort
-                    if (data[i] == 0) {
-                        return;
-                    }
-                    // Found '|', send it
-                    if (data[i] == '|') {
-                        data[i + 1] = 0;
-                        break;
-                    }
-                    // If haven't found '|' by i==6 then
-                    // number too big, abort
-                    if (i == 6) {
-                        return;
-                    }
-                    ++i;
-                }
-            }
-        }
-        send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
+        memcpy(&data[length], token, token_length);
+        length += token_length;
     }
+
+    // Send whatever is left, including when a truncated token ended the macro early
+    data[length] = 0;
+    send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
 }
@@ -4,6 +4,7 @@
 #include "eeprom.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "timer.h"
 
 #if defined(EEPROM_DRIVER)
 #    include "eeprom_driver.h"
@@ -19,6 +20,161 @@ void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 #endif
 
+/*
+ * Staging area for the eeconfig region of EEPROM.
+ *
+ * The whole region is mirrored in RAM on first access. Updates only touch the mirror and mark the changed bytes as
+ * dirty; contiguous runs of dirty bytes are then committed together once no further changes have been made for
+ * EECONFIG_COMMIT_DELAY milliseconds, or immediately via eeconfig_flush() on suspend and shutdown.
+ */
+static struct {
+    uint8_t  data[(EECONFIG_SIZE)];
+    uint8_t  dirty[((EECONFIG_SIZE) + 7) / 8];
+    uint32_t last_change;
+    bool     loaded;
+    bool     pending;
+} eeconfig_stage;
+
+static void eeconfig_stage_load(void) {
+    if (!eeconfig_stage.loaded) {
+        eeprom_read_block(eeconfig_stage.data, (const void *)0, sizeof(eeconfig_stage.data));
+        memset(eeconfig_stage.dirty, 0, sizeof(eeconfig_stage.dirty));
+        eeconfig_stage.loaded  = true;
+        eeconfig_stage.pending = false;
+    }
+}
+
+#if defined(EEPROM_DRIVER)
+// Discards the mirror, for use after the underlying EEPROM has been erased
+static void eeconfig_stage_invalidate(void) {
+    eeconfig_stage.loaded  = false;
+    eeconfig_stage.pending = false;
+}
+#endif
+
+// Number of bytes of the supplied range which fall within the staging area
+static size_t eeconfig_stage_length(uintptr_t offset, size_t size) {
+    if (offset >= (EECONFIG_SIZE)) {
+        return 0;
+    }
+    return (offset + size > (EECONFIG_SIZE)) ? (EECONFIG_SIZE) - offset : size;
+}
+
+/** \brief eeconfig read block
+ *
+ * Reads from the staging area, falling back to EEPROM for anything outside of the eeconfig region.
+ */
+void eeconfig_read_block(void *buf, const void *addr, size_t size) {
+    uintptr_t offset = (uintptr_t)addr;
+    size_t    staged = eeconfig_stage_length(offset, size);
+    if (staged > 0) {
+        eeconfig_stage_load();
+        memcpy(buf, &eeconfig_stage.data[offset], staged);
+    }
+    if (staged < size) {
+        eeprom_read_block((uint8_t *)buf + staged, (const void *)(offset + staged), size - staged);
+    }
+}
+
+/** \brief eeconfig update block
+ *
+ * Stages the supplied data, to be committed to EEPROM by eeconfig_task() or eeconfig_flush(). Anything outside of the
+ * eeconfig region is written to EEPROM directly.
+ */
+void eeconfig_update_block(const void *buf, void *addr, size_t size) {
+    uintptr_t      offset = (uintptr_t)addr;
+    size_t         staged = eeconfig_stage_length(offset, size);
+    const uint8_t *p      = buf;
+    if (staged > 0) {
+        eeconfig_stage_load();
+        for (size_t i = 0; i < staged; ++i) {
+            if (eeconfig_stage.data[offset + i] != p[i]) {
+                eeconfig_stage.data[offset + i] = p[i];
+                eeconfig_stage.dirty[(offset + i) / 8] |= 1 << ((offset + i) % 8);
+                eeconfig_stage.pending     = true;
+                eeconfig_stage.last_change = timer_read32();
+            }
+        }
+    }
+    if (staged < size) {
+        eeprom_update_block(p + staged, (void *)(offset + staged), size - staged);
+    }
+}
+
+uint8_t eeconfig_read_byte(const uint8_t *addr) {
+    uint8_t val;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+uint16_t eeconfig_read_word(const uint16_t *addr) {
+    uint16_t val;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+uint32_t eeconfig_read_dword(const uint32_t *addr) {
+    uint32_t val;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+void eeconfig_update_byte(uint8_t *addr, uint8_t val) {
+    eeconfig_update_block(&val, addr, sizeof(val));
+}
+
+void eeconfig_update_word(uint16_t *addr, uint16_t val) {
+    eeconfig_update_block(&val, addr, sizeof(val));
+}
+
+void eeconfig_update_dword(uint32_t *addr, uint32_t val) {
+    eeconfig_update_block(&val, addr, sizeof(val));
+}
+
+/** \brief eeconfig is dirty
+ *
+ * Whether there are staged changes which have not yet been committed to EEPROM.
+ */
+bool eeconfig_is_dirty(void) {
+    return eeconfig_stage.pending;
+}
+
+/** \brief eeconfig flush
+ *
+ * Commits all staged changes to EEPROM, one write per contiguous run of changed bytes.
+ */
+void eeconfig_flush(void) {
+    if (!eeconfig_stage.pending) {
+        return;
+    }
+
+    uint16_t offset = 0;
+    while (offset < (EECONFIG_SIZE)) {
+        if (!(eeconfig_stage.dirty[offset / 8] & (1 << (offset % 8)))) {
+            ++offset;
+            continue;
+        }
+        uint16_t start = offset;
+        while (offset < (EECONFIG_SIZE) && (eeconfig_stage.dirty[offset / 8] & (1 << (offset % 8)))) {
+            ++offset;
+        }
+        eeprom_update_block(&eeconfig_stage.data[start], (void *)(uintptr_t)start, offset - start);
+    }
+
+    memset(eeconfig_stage.dirty, 0, sizeof(eeconfig_stage.dirty));
+    eeconfig_stage.pending = false;
+}
+
+/** \brief eeconfig task
+ *
+ * Commits staged changes once they have been left untouched for EECONFIG_COMMIT_DELAY milliseconds.
+ */
+void eeconfig_task(void) {
+    if (eeconfig_stage.pending && timer_elapsed32(eeconfig_stage.last_change) >= (EECONFIG_COMMIT_DELAY)) {
+        eeconfig_flush();
+    }
+}
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -45,24 +201,25 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
 void eeconfig_init_quantum(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+    eeconfig_stage_invalidate();
 #endif
 
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
-    eeprom_update_byte(EECONFIG_DEBUG, 0);
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, 0);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_byte(EECONFIG_DEBUG, 0);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, 0);
     default_layer_state = 0;
     // Enable oneshot and autocorrect by default: 0b0001 0100 0000 0000
-    eeprom_update_word(EECONFIG_KEYMAP, 0x1400);
-    eeprom_update_byte(EECONFIG_BACKLIGHT, 0);
-    eeprom_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
-    eeprom_update_dword(EECONFIG_RGBLIGHT, 0);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
-    eeprom_update_byte(EECONFIG_VELOCIKEY, 0);
-    eeprom_update_byte(EECONFIG_UNICODEMODE, 0);
-    eeprom_update_byte(EECONFIG_STENOMODE, 0);
+    eeconfig_update_word(EECONFIG_KEYMAP, 0x1400);
+    eeconfig_update_byte(EECONFIG_BACKLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
+    eeconfig_update_byte(EECONFIG_VELOCIKEY, 0);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, 0);
+    eeconfig_update_byte(EECONFIG_STENOMODE, 0);
     uint64_t dummy = 0;
-    eeprom_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
-    eeprom_update_dword(EECONFIG_HAPTIC, 0);
+    eeconfig_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
+    eeconfig_update_dword(EECONFIG_HAPTIC, 0);
 #if defined(HAPTIC_ENABLE)
     haptic_reset();
 #endif
@@ -84,6 +241,9 @@ void eeconfig_init_quantum(void) {
 #endif
 
     eeconfig_init_kb();
+
+    // Don't leave a freshly initialised eeconfig sitting in RAM
+    eeconfig_flush();
 }
 
 /** \brief eeconfig initialization
@@ -99,7 +259,8 @@ void eeconfig_init(void) {
  * FIXME: needs doc
  */
 void eeconfig_enable(void) {
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_flush();
 }
 
 /** \brief eeconfig disable
@@ -109,8 +270,10 @@ void eeconfig_enable(void) {
 void eeconfig_disable(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+    eeconfig_stage_invalidate();
 #endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_flush();
 }
 
 /** \brief eeconfig is enabled
@@ -118,7 +281,7 @@ void eeconfig_disable(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_enabled(void) {
-    bool is_eeprom_enabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
+    bool is_eeprom_enabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
 #ifdef VIA_ENABLE
     if (is_eeprom_enabled) {
         is_eeprom_enabled = via_eeprom_is_valid();
@@ -132,7 +295,7 @@ bool eeconfig_is_enabled(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_disabled(void) {
-    bool is_eeprom_disabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
+    bool is_eeprom_disabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
 #ifdef VIA_ENABLE
     if (!is_eeprom_disabled) {
         is_eeprom_disabled = !via_eeprom_is_valid();
@@ -146,14 +309,14 @@ bool eeconfig_is_disabled(void) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_debug(void) {
-    return eeprom_read_byte(EECONFIG_DEBUG);
+    return eeconfig_read_byte(EECONFIG_DEBUG);
 }
 /** \brief eeconfig update debug
  *
  * FIXME: needs doc
  */
 void eeconfig_update_debug(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEBUG, val);
+    eeconfig_update_byte(EECONFIG_DEBUG, val);
 }
 
 /** \brief eeconfig read default layer
@@ -161,14 +324,14 @@ void eeconfig_update_debug(uint8_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_default_layer(void) {
-    return eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    return eeconfig_read_byte(EECONFIG_DEFAULT_LAYER);
 }
 /** \brief eeconfig update default layer
  *
  * FIXME: needs doc
  */
 void eeconfig_update_default_layer(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, val);
 }
 
 /** \brief eeconfig read keymap
@@ -176,14 +339,14 @@ void eeconfig_update_default_layer(uint8_t val) {
  * FIXME: needs doc
  */
 uint16_t eeconfig_read_keymap(void) {
-    return eeprom_read_word(EECONFIG_KEYMAP);
+    return eeconfig_read_word(EECONFIG_KEYMAP);
 }
 /** \brief eeconfig update keymap
  *
  * FIXME: needs doc
  */
 void eeconfig_update_keymap(uint16_t val) {
-    eeprom_update_word(EECONFIG_KEYMAP, val);
+    eeconfig_update_word(EECONFIG_KEYMAP, val);
 }
 
 /** \brief eeconfig read audio
@@ -191,14 +354,14 @@ void eeconfig_update_keymap(uint16_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_audio(void) {
-    return eeprom_read_byte(EECONFIG_AUDIO);
+    return eeconfig_read_byte(EECONFIG_AUDIO);
 }
 /** \brief eeconfig update audio
  *
  * FIXME: needs doc
  */
 void eeconfig_update_audio(uint8_t val) {
-    eeprom_update_byte(EECONFIG_AUDIO, val);
+    eeconfig_update_byte(EECONFIG_AUDIO, val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) == 0
@@ -207,14 +370,14 @@ void eeconfig_update_audio(uint8_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return eeconfig_read_dword(EECONFIG_KEYBOARD);
 }
 /** \brief eeconfig update kb
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    eeconfig_update_dword(EECONFIG_KEYBOARD, val);
 }
 #endif // (EECONFIG_KB_DATA_SIZE) == 0
 
@@ -224,14 +387,14 @@ void eeconfig_update_kb(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return eeconfig_read_dword(EECONFIG_USER);
 }
 /** \brief eeconfig update user
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    eeconfig_update_dword(EECONFIG_USER, val);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) == 0
 
@@ -240,14 +403,14 @@ void eeconfig_update_user(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_haptic(void) {
-    return eeprom_read_dword(EECONFIG_HAPTIC);
+    return eeconfig_read_dword(EECONFIG_HAPTIC);
 }
 /** \brief eeconfig update haptic
  *
  * FIXME: needs doc
  */
 void eeconfig_update_haptic(uint32_t val) {
-    eeprom_update_dword(EECONFIG_HAPTIC, val);
+    eeconfig_update_dword(EECONFIG_HAPTIC, val);
 }
 
 /** \brief eeconfig read split handedness
@@ -255,14 +418,14 @@ void eeconfig_update_haptic(uint32_t val) {
  * FIXME: needs doc
  */
 bool eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!eeconfig_read_byte(EECONFIG_HANDEDNESS);
 }
 /** \brief eeconfig update split handedness
  *
  * FIXME: needs doc
  */
 void eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    eeconfig_update_byte(EECONFIG_HANDEDNESS, !!val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) > 0
@@ -271,7 +434,7 @@ void eeconfig_update_handedness(bool val) {
  * FIXME: needs doc
  */
 bool eeconfig_is_kb_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
+    return eeconfig_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
 }
 /** \brief eeconfig read keyboard data block
  *
@@ -279,7 +442,7 @@ bool eeconfig_is_kb_datablock_valid(void) {
  */
 void eeconfig_read_kb_datablock(void *data) {
     if (eeconfig_is_kb_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+        eeconfig_read_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
     } else {
         memset(data, 0, (EECONFIG_KB_DATA_SIZE));
     }
@@ -289,8 +452,8 @@ void eeconfig_read_kb_datablock(void *data) {
  * FIXME: needs doc
  */
 void eeconfig_update_kb_datablock(const void *data) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+    eeconfig_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
+    eeconfig_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
 }
 /** \brief eeconfig init keyboard data block
  *
@@ -308,7 +471,7 @@ __attribute__((weak)) void eeconfig_init_kb_datablock(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_user_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
+    return eeconfig_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
 }
 /** \brief eeconfig read user data block
  *
@@ -316,7 +479,7 @@ bool eeconfig_is_user_datablock_valid(void) {
  */
 void eeconfig_read_user_datablock(void *data) {
     if (eeconfig_is_user_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+        eeconfig_read_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
     } else {
         memset(data, 0, (EECONFIG_USER_DATA_SIZE));
     }
@@ -326,8 +489,8 @@ void eeconfig_read_user_datablock(void *data) {
  * FIXME: needs doc
  */
 void eeconfig_update_user_datablock(const void *data) {
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+    eeconfig_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    eeconfig_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
 }
 /** \brief eeconfig init user data block
  *
@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifndef EECONFIG_MAGIC_NUMBER
 #    define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEE6 // When changing, decrement this value to avoid future re-init issues
@@ -70,6 +71,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // Size of EEPROM being used, other code can refer to this for available EEPROM
 #define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE))
 
+// Number of milliseconds without further changes before staged eeconfig updates are committed to EEPROM
+#ifndef EECONFIG_COMMIT_DELAY
+#    define EECONFIG_COMMIT_DELAY 1000
+#endif
+
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
 #define EECONFIG_DEBUG_MATRIX (1 << 1)
@@ -89,6 +95,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 bool eeconfig_is_enabled(void);
 bool eeconfig_is_disabled(void);
 
+// Staged access to the eeconfig region -- anything outside of the region passes straight through to EEPROM
+uint8_t  eeconfig_read_byte(const uint8_t *addr);
+uint16_t eeconfig_read_word(const uint16_t *addr);
+uint32_t eeconfig_read_dword(const uint32_t *addr);
+void     eeconfig_read_block(void *buf, const void *addr, size_t size);
+void     eeconfig_update_byte(uint8_t *addr, uint8_t val);
+void     eeconfig_update_word(uint16_t *addr, uint16_t val);
+void     eeconfig_update_dword(uint32_t *addr, uint32_t val);
+void     eeconfig_update_block(const void *buf, void *addr, size_t size);
+
+bool eeconfig_is_dirty(void);
+void eeconfig_flush(void);
+void eeconfig_task(void);
+
 void eeconfig_init(void);
 void eeconfig_init_quantum(void);
 void eeconfig_init_kb(void);
@@ -144,6 +164,8 @@ void eeconfig_update_user_datablock(const void *data);
 void eeconfig_init_user_datablock(void);
 #endif // (EECONFIG_USER_DATA_SIZE) > 0
 
+// Blocks within the eeconfig region are staged, and committed by eeconfig_task() -- the flush task only needs to be
+// used for blocks stored outside of the eeconfig region.
 // Any "checked" debounce variant used requires implementation of:
 //    -- bool eeconfig_check_valid_##name(void)
 //    -- void eeconfig_post_flush_##name(void)
@@ -156,13 +178,13 @@ void eeconfig_init_user_datablock(void);
     static inline void eeconfig_init_##name(void) {                     \
         dirty_##name = true;                                            \
         if (eeconfig_check_valid_##name()) {                            \
-            eeprom_read_block(&config, offset, sizeof(config));         \
+            eeconfig_read_block(&config, offset, sizeof(config));       \
             dirty_##name = false;                                       \
         }                                                               \
     }                                                                   \
     static inline void eeconfig_flush_##name(bool force) {              \
         if (force || dirty_##name) {                                    \
-            eeprom_update_block(&config, offset, sizeof(config));       \
+            eeconfig_update_block(&config, offset, sizeof(config));     \
             eeconfig_post_flush_##name();                               \
             dirty_##name = false;                                       \
         }                                                               \
@@ -111,6 +111,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DUAL_BANK)
+#    include "wear_leveling.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -214,6 +217,34 @@ uint32_t get_matrix_scan_rate(void) {
 #    define matrix_scan_perf_task()
 #endif
 
+#ifdef IDLE_SLEEP_ENABLE
+#    ifndef IDLE_SLEEP_SCAN_INTERVAL_US
+#        define IDLE_SLEEP_SCAN_INTERVAL_US 1000
+#    endif
+
+static uint32_t last_scan_time_us = 0;
+
+/** \brief Time the main loop can sleep for before the next scan or tick event is due
+ *
+ * Anything else that needs the main loop sooner should wake it up with idle_wakeup().
+ */
+uint32_t keyboard_idle_time_us(void) {
+    const uint32_t elapsed = timer_elapsed_us(last_scan_time_us);
+    if (elapsed >= IDLE_SLEEP_SCAN_INTERVAL_US) {
+        return 0;
+    }
+
+    uint32_t       idle = IDLE_SLEEP_SCAN_INTERVAL_US - elapsed;
+    // Compared in microseconds, so a tick due in under a millisecond still cuts the sleep short; widened as
+    // action_tick_remaining() returns UINT32_MAX when nothing is scheduled
+    const uint64_t tick_us = (uint64_t)action_tick_remaining() * 1000;
+    if (tick_us < idle) {
+        idle = (uint32_t)tick_us;
+    }
+    return idle;
+}
+#endif
+
 #ifdef MATRIX_HAS_GHOST
 static matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
     matrix_row_t out = 0;
@@ -486,14 +517,11 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 
 /**
  * @brief Generates a tick event at a maximum rate of 1KHz that drives the
- * internal QMK state machine.
+ * internal QMK state machine, whenever one has been scheduled.
  */
 static inline void generate_tick_event(void) {
-    static uint16_t last_tick = 0;
-    const uint16_t  now       = timer_read();
-    if (TIMER_DIFF_16(now, last_tick) != 0) {
+    if (action_tick_due()) {
         action_exec(MAKE_TICK_EVENT);
-        last_tick = now;
     }
 }
 
@@ -640,6 +668,10 @@ void quantum_task(void) {
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
+#ifdef IDLE_SLEEP_ENABLE
+    last_scan_time_us = timer_read_us();
+#endif
+
     __attribute__((unused)) bool activity_has_occurred = false;
     if (matrix_task()) {
         last_matrix_activity_trigger();
@@ -726,5 +758,15 @@ void keyboard_task(void) {
     bluetooth_task();
 #endif
 
+    eeconfig_task();
+
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+    eeprom_driver_task();
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DUAL_BANK)
+    wear_leveling_task();
+#endif
+
     led_task();
 }
@@ -128,6 +128,10 @@ void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timesta
 
 uint32_t get_matrix_scan_rate(void);
 
+#ifdef IDLE_SLEEP_ENABLE
+uint32_t keyboard_idle_time_us(void); // Number of microseconds the main loop can sleep for before it is needed again
+#endif
+
 #ifdef __cplusplus
 }
 #endif
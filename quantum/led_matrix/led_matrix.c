@@ -24,6 +24,7 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "lighting_task.h"
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -118,10 +119,19 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_led_matrix_split[2] = LED_MATRIX_SPLIT;
 #endif
 
-EECONFIG_DEBOUNCE_HELPER(led_matrix, EECONFIG_LED_MATRIX, led_matrix_eeconfig);
+static inline void eeconfig_init_led_matrix(void) {
+    eeconfig_read_block(&led_matrix_eeconfig, EECONFIG_LED_MATRIX, sizeof(led_matrix_eeconfig));
+}
 
 void eeconfig_update_led_matrix(void) {
-    eeconfig_flush_led_matrix(true);
+    eeconfig_update_block(&led_matrix_eeconfig, EECONFIG_LED_MATRIX, sizeof(led_matrix_eeconfig));
+}
+
+// Changes are staged in the eeconfig mirror, which eeconfig_task() commits to EEPROM once they have settled
+static inline void eeconfig_flag_led_matrix(bool write_to_eeprom) {
+    if (write_to_eeprom) {
+        eeconfig_update_led_matrix();
+    }
 }
 
 void eeconfig_update_led_matrix_default(void) {
@@ -131,7 +141,7 @@ void eeconfig_update_led_matrix_default(void) {
     led_matrix_eeconfig.val    = LED_MATRIX_DEFAULT_VAL;
     led_matrix_eeconfig.speed  = LED_MATRIX_DEFAULT_SPD;
     led_matrix_eeconfig.flags  = LED_FLAG_ALL;
-    eeconfig_flush_led_matrix(true);
+    eeconfig_update_led_matrix();
 }
 
 void eeconfig_debug_led_matrix(void) {
@@ -202,22 +212,7 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
+    lighting_last_hit_record(&last_hit_buffer, led, led_count, 0);
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(LED_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_LED_MATRIX_TYPING_HEATMAP)
@@ -236,66 +231,54 @@ static bool led_matrix_none(effect_params_t *params) {
     return false;
 }
 
-static void led_task_timers(void) {
-#if defined(LED_MATRIX_KEYREACTIVE_ENABLED) || LED_MATRIX_TIMEOUT > 0
-    uint32_t deltaTime = sync_timer_elapsed32(led_timer_buffer);
-#endif // defined(LED_MATRIX_KEYREACTIVE_ENABLED) || LED_MATRIX_TIMEOUT > 0
-    led_timer_buffer = sync_timer_read32();
-
-    // Update double buffer timers
-#if LED_MATRIX_TIMEOUT > 0
-    if (led_anykey_timer < UINT32_MAX) {
-        if (UINT32_MAX - deltaTime < led_anykey_timer) {
-            led_anykey_timer = UINT32_MAX;
-        } else {
-            led_anykey_timer += deltaTime;
-        }
-    }
-#endif // LED_MATRIX_TIMEOUT > 0
-
-    // Update double buffer last hit timers
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+// Effects not listed here animate over time, and are rendered every frame
+static lighting_effect_kind_t led_effect_kind(uint8_t effect) {
+    switch (effect) {
+        case LED_MATRIX_NONE:
+        case LED_MATRIX_SOLID:
+#    ifdef ENABLE_LED_MATRIX_ALPHAS_MODS
+        case LED_MATRIX_ALPHAS_MODS:
+#    endif
+            return LIGHTING_EFFECT_STATIC;
+#    ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+#        ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_SIMPLE
+        case LED_MATRIX_SOLID_REACTIVE_SIMPLE:
+#        endif
+#        ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_WIDE
+        case LED_MATRIX_SOLID_REACTIVE_WIDE:
+#        endif
+#        ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTIWIDE
+        case LED_MATRIX_SOLID_REACTIVE_MULTIWIDE:
+#        endif
+#        ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_CROSS
+        case LED_MATRIX_SOLID_REACTIVE_CROSS:
+#        endif
+#        ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTICROSS
+        case LED_MATRIX_SOLID_REACTIVE_MULTICROSS:
+#        endif
+#        ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_NEXUS
+        case LED_MATRIX_SOLID_REACTIVE_NEXUS:
+#        endif
+#        ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTINEXUS
+        case LED_MATRIX_SOLID_REACTIVE_MULTINEXUS:
+#        endif
+#        ifdef ENABLE_LED_MATRIX_SOLID_SPLASH
+        case LED_MATRIX_SOLID_SPLASH:
+#        endif
+#        ifdef ENABLE_LED_MATRIX_SOLID_MULTISPLASH
+        case LED_MATRIX_SOLID_MULTISPLASH:
+#        endif
+            return LIGHTING_EFFECT_KEY_REACTIVE;
+#    endif // LED_MATRIX_KEYREACTIVE_ENABLED
+        default:
+            return LIGHTING_EFFECT_TIMED;
     }
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
-}
-
-static void led_task_sync(void) {
-    eeconfig_flush_led_matrix(false);
-    // next task
-    if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
-}
-
-static void led_task_start(void) {
-    // reset iter
-    led_effect_params.iter = 0;
-
-    // update double buffers
-    g_led_timer = led_timer_buffer;
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    led_task_state = RENDERING;
 }
+#endif // LED_MATRIX_SKIP_UNCHANGED_FRAMES
 
-static void led_task_render(uint8_t effect) {
-    bool rendering         = false;
-    led_effect_params.init = (effect != led_last_effect) || (led_matrix_eeconfig.enable != led_last_enable);
-    if (led_effect_params.flags != led_matrix_eeconfig.flags) {
-        led_effect_params.flags = led_matrix_eeconfig.flags;
-        led_matrix_set_value_all(0);
-    }
-
-    // each effect can opt to do calculations
-    // and/or request PWM buffer updates.
+static bool led_task_render_effect(uint8_t effect) {
+    bool rendering = false;
     switch (effect) {
         case LED_MATRIX_NONE:
             rendering = led_matrix_none(&led_effect_params);
@@ -326,33 +309,40 @@ static void led_task_render(uint8_t effect) {
             // -----End led effect switch case macros-------
             // ---------------------------------------------
     }
+    return rendering;
+}
+
+// Task state machine
+#define LIGHTING_TASK_STATE led_task_state
+#define LIGHTING_EFFECT_PARAMS led_effect_params
+#define LIGHTING_LAST_EFFECT led_last_effect
+#define LIGHTING_LAST_ENABLE led_last_enable
+#define LIGHTING_TIMER_BUFFER led_timer_buffer
+#define LIGHTING_CONFIG_ENABLE led_matrix_eeconfig.enable
+#define LIGHTING_CONFIG_FLAGS led_matrix_eeconfig.flags
+#define LIGHTING_FLUSH_LIMIT LED_MATRIX_LED_FLUSH_LIMIT
+#define LIGHTING_PROCESS_MAX_ITERATIONS LED_MATRIX_LED_PROCESS_MAX_ITERATIONS
+#define LIGHTING_CLEAR() led_matrix_set_value_all(0)
+#define LIGHTING_RENDER_EFFECT led_task_render_effect
+#define LIGHTING_UPDATE_PWM_BUFFERS led_matrix_update_pwm_buffers
+#define LIGHTING_INDICATORS led_matrix_indicators
+#define LIGHTING_INDICATORS_ADVANCED led_matrix_indicators_advanced
+#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+#    define LIGHTING_LAST_HIT_BUFFER last_hit_buffer
+#endif
+#if LED_MATRIX_TIMEOUT > 0
+#    define LIGHTING_ANYKEY_TIMER led_anykey_timer
+#endif
+#ifdef LED_MATRIX_SKIP_UNCHANGED_FRAMES
+#    define LIGHTING_SKIP_UNCHANGED_FRAMES
+#    define LIGHTING_EFFECT_KIND led_effect_kind
+#    define LIGHTING_CONFIG_RAW led_matrix_eeconfig.raw
+#endif
 
-    led_effect_params.iter++;
-
-    // next task
-    if (!rendering) {
-        led_task_state = FLUSHING;
-        if (!led_effect_params.init && effect == LED_MATRIX_NONE) {
-            // We only need to flush once if we are LED_MATRIX_NONE
-            led_task_state = SYNCING;
-        }
-    }
-}
-
-static void led_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    led_last_effect = effect;
-    led_last_enable = led_matrix_eeconfig.enable;
-
-    // update pwm buffers
-    led_matrix_update_pwm_buffers();
-
-    // next task
-    led_task_state = SYNCING;
-}
+#include "lighting_task.inc"
 
 void led_matrix_task(void) {
-    led_task_timers();
+    lighting_task_timers();
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
@@ -364,27 +354,15 @@ void led_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
 
-    switch (led_task_state) {
-        case STARTING:
-            led_task_start();
-            break;
-        case RENDERING:
-            led_task_render(effect);
-            if (effect) {
-                // Only run the basic indicators in the last render iteration (default there are 5 iterations)
-                if (led_effect_params.iter == LED_MATRIX_LED_PROCESS_MAX_ITERATIONS) {
-                    led_matrix_indicators();
-                }
-                led_matrix_indicators_advanced(&led_effect_params);
-            }
-            break;
-        case FLUSHING:
-            led_task_flush(effect);
-            break;
-        case SYNCING:
-            led_task_sync();
-            break;
-    }
+    lighting_task_step(effect);
+}
+
+uint32_t led_matrix_get_rendered_frames(void) {
+    return lighting_frames_rendered;
+}
+
+uint32_t led_matrix_get_skipped_frames(void) {
+    return lighting_frames_skipped;
 }
 
 void led_matrix_indicators(void) {
@@ -401,9 +379,9 @@ __attribute__((weak)) bool led_matrix_indicators_user(void) {
 
 void led_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
-     * Could move the invocations to led_task_render, but then it's missing a few checks
+     * Could move the invocations to lighting_task_render, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
-     * led_task_render, right before the iter++ line.
+     * lighting_task_render, right before the iter++ line.
      */
 #if defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
     uint8_t min = LED_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
@@ -456,8 +434,8 @@ void led_matrix_init(void) {
 void led_matrix_set_suspend_state(bool state) {
 #ifdef LED_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state && is_keyboard_master()) { // only run if turning off, and only once
-        led_task_render(0);                                // turn off all LEDs when suspending
-        led_task_flush(0);                                 // and actually flash led state to LEDs
+        lighting_task_render(0);                           // turn off all LEDs when suspending
+        lighting_task_flush(0);                            // and actually flash led state to LEDs
     }
     suspend_state = state;
 #endif
@@ -118,6 +118,10 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void led_matrix_task(void);
 
+// Frames rendered and flushed, and frames skipped as nothing they depend on has changed
+uint32_t led_matrix_get_rendered_frames(void);
+uint32_t led_matrix_get_skipped_frames(void);
+
 // This runs after another backlight effect and replaces
 // values already set
 void led_matrix_indicators(void);
@@ -0,0 +1,28 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Current estimate shared by rgb_matrix and rgblight. Each channel of each LED is
+taken to draw current in proportion to its value, reaching channel_current
+milliamps at 255, so a whole frame is summarised by the sum of its channel values.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/** \brief Estimated current, in milliamps, of a frame whose channel values add up to level */
+static inline uint32_t lighting_power_estimate(uint32_t level, uint8_t channel_current) {
+    return (level * channel_current + 254) / 255;
+}
+
+/** \brief Scale, out of 256, that brings a frame within limit milliamps, or 256 if it already is */
+static inline uint16_t lighting_power_scale(uint32_t level, uint8_t channel_current, uint16_t limit) {
+    uint32_t draw   = level * channel_current;
+    uint32_t budget = (uint32_t)limit * 255;
+    if (draw <= budget) {
+        return 256;
+    }
+    // Rounded down, so the scaled frame never goes over
+    return budget * 256 / draw;
+}
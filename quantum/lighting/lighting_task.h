@@ -0,0 +1,78 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Task helpers shared by led_matrix and rgb_matrix. Include after the module's
+own header, which provides last_hit_t and LED_HITS_TO_REMEMBER.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "action_layer.h"
+#include "action_util.h"
+#include "host.h"
+
+// How a frame of an effect depends on time, for skipping frames that would come out the same
+typedef enum { LIGHTING_EFFECT_TIMED, LIGHTING_EFFECT_KEY_REACTIVE, LIGHTING_EFFECT_STATIC } lighting_effect_kind_t;
+
+// What indicators and overlays are expected to depend on
+typedef struct {
+    layer_state_t layer_state;
+    layer_state_t default_layer_state;
+    uint8_t       led_state;
+    uint8_t       mods;
+} lighting_indicator_inputs_t;
+
+static inline void lighting_indicator_inputs_read(lighting_indicator_inputs_t *inputs) {
+    // zeroed padding lets the inputs be compared with memcmp
+    memset(inputs, 0, sizeof(*inputs));
+    inputs->layer_state         = layer_state;
+    inputs->default_layer_state = default_layer_state;
+    inputs->led_state           = host_keyboard_led_state().raw;
+    inputs->mods                = get_mods() | get_oneshot_mods();
+}
+
+/** \brief Advances a timeout timer, stopping at its maximum instead of wrapping */
+static inline void lighting_anykey_timer_advance(uint32_t *timer, uint32_t delta) {
+    if (UINT32_MAX - delta < *timer) {
+        *timer = UINT32_MAX;
+    } else {
+        *timer += delta;
+    }
+}
+
+#if defined(LED_MATRIX_KEYREACTIVE_ENABLED) || defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
+/** \brief Records hits on the given LEDs, tick milliseconds ago, dropping the oldest ones when full */
+static inline void lighting_last_hit_record(last_hit_t *hits, const uint8_t *led, uint8_t led_count, uint16_t tick) {
+    if (hits->count + led_count > LED_HITS_TO_REMEMBER) {
+        memcpy(&hits->x[0], &hits->x[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memcpy(&hits->y[0], &hits->y[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memcpy(&hits->tick[0], &hits->tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
+        memcpy(&hits->index[0], &hits->index[led_count], LED_HITS_TO_REMEMBER - led_count);
+        hits->count = LED_HITS_TO_REMEMBER - led_count;
+    }
+
+    for (uint8_t i = 0; i < led_count; i++) {
+        uint8_t index      = hits->count;
+        hits->x[index]     = g_led_config.point[led[i]].x;
+        hits->y[index]     = g_led_config.point[led[i]].y;
+        hits->index[index] = led[i];
+        hits->tick[index]  = tick;
+        hits->count++;
+    }
+}
+
+/** \brief Ages recorded hits, forgetting those that have run out */
+static inline void lighting_last_hit_advance(last_hit_t *hits, uint32_t delta) {
+    uint8_t count = hits->count;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (UINT16_MAX - delta < hits->tick[i]) {
+            hits->count--;
+            continue;
+        }
+        hits->tick[i] += delta;
+    }
+}
+#endif // defined(LED_MATRIX_KEYREACTIVE_ENABLED) || defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
@@ -0,0 +1,19 @@
+#pragma once
+
+#ifdef LIGHTING_LED_POLAR
+
+typedef lighting_value_t (*dist_angle_f)(lighting_value_t value, uint8_t dist, uint8_t angle, uint8_t time);
+
+bool effect_runner_dist_angle(effect_params_t* params, dist_angle_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(LIGHTING_TIMER, LIGHTING_SPEED / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        led_polar_t polar = LIGHTING_LED_POLAR(i);
+        LIGHTING_SET_OUTPUT(i, LIGHTING_CONVERT(effect_func(LIGHTING_CONFIG_VALUE, polar.dist, polar.angle, time)));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
+
+#endif // LIGHTING_LED_POLAR
@@ -0,0 +1,17 @@
+#pragma once
+
+typedef lighting_value_t (*dx_dy_dist_f)(lighting_value_t value, int16_t dx, int16_t dy, uint8_t dist, uint8_t time);
+
+bool effect_runner_dx_dy_dist(effect_params_t* params, dx_dy_dist_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(LIGHTING_TIMER, LIGHTING_SPEED / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        int16_t dx   = g_led_config.point[i].x - LIGHTING_CENTER.x;
+        int16_t dy   = g_led_config.point[i].y - LIGHTING_CENTER.y;
+        uint8_t dist = LIGHTING_LED_DIST(i, dx, dy);
+        LIGHTING_SET_OUTPUT(i, LIGHTING_CONVERT(effect_func(LIGHTING_CONFIG_VALUE, dx, dy, dist, time)));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
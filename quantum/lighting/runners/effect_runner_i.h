@@ -0,0 +1,14 @@
+#pragma once
+
+typedef lighting_value_t (*i_f)(lighting_value_t value, uint8_t i, uint8_t time);
+
+bool effect_runner_i(effect_params_t* params, i_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(LIGHTING_TIMER, LIGHTING_SPEED_NONZERO(LIGHTING_SPEED / 4));
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        LIGHTING_SET_OUTPUT(i, LIGHTING_CONVERT(effect_func(LIGHTING_CONFIG_VALUE, i, time)));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
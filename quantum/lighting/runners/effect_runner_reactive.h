@@ -0,0 +1,28 @@
+#pragma once
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+
+typedef lighting_value_t (*reactive_f)(lighting_value_t value, uint16_t offset);
+
+bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint16_t max_tick = 65535 / LIGHTING_SPEED_NONZERO(LIGHTING_SPEED);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        uint16_t tick = max_tick;
+        // Reverse search to find most recent key hit
+        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
+            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
+                tick = g_last_hit_tracker.tick[j];
+                break;
+            }
+        }
+
+        uint16_t offset = scale16by8(tick, LIGHTING_SPEED_NONZERO(LIGHTING_SPEED));
+        LIGHTING_SET_OUTPUT(i, LIGHTING_CONVERT(effect_func(LIGHTING_CONFIG_VALUE, offset)));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
+
+#endif // LIGHTING_KEYREACTIVE_ENABLED
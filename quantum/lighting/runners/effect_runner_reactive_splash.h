@@ -0,0 +1,66 @@
+#pragma once
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+
+typedef lighting_value_t (*reactive_splash_f)(lighting_value_t value, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+// How far a hit can light up LEDs: only those closer than the returned distance, or none at all for 0
+typedef uint16_t (*reactive_splash_reach_f)(uint16_t tick);
+
+// Positions are bucketed into 16 unit wide columns and rows, one bit each
+static inline uint16_t reactive_splash_buckets(uint8_t position, uint16_t reach) {
+    if (reach == 0) {
+        return 0;
+    }
+    uint8_t first = position > reach ? (position - reach) >> 4 : 0;
+    uint8_t last  = position + reach < UINT8_MAX ? (position + reach) >> 4 : 15;
+    return (uint16_t)(UINT16_MAX >> (15 - last)) & (uint16_t)(UINT16_MAX << first);
+}
+
+bool effect_runner_reactive_splash_reach(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t  count = g_last_hit_tracker.count;
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+    uint16_t columns[LED_HITS_TO_REMEMBER];
+    uint16_t rows[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        tick[j]        = scale16by8(g_last_hit_tracker.tick[j], LIGHTING_SPEED_NONZERO(LIGHTING_SPEED));
+        uint16_t reach = reach_func && LIGHTING_SPLASH_BUCKETING ? reach_func(tick[j]) : UINT8_MAX + 1;
+        columns[j]     = reactive_splash_buckets(g_last_hit_tracker.x[j], reach);
+        rows[j]        = reactive_splash_buckets(g_last_hit_tracker.y[j], reach);
+    }
+
+    lighting_output_t off = LIGHTING_CONVERT(lighting_value_with_level(LIGHTING_CONFIG_VALUE, 0));
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        uint16_t column = 1U << (g_led_config.point[i].x >> 4);
+        uint16_t row    = 1U << (g_led_config.point[i].y >> 4);
+        bool     near   = false;
+        for (uint8_t j = start; j < count && !near; j++) {
+            near = (columns[j] & column) && (rows[j] & row);
+        }
+        if (!near) {
+            LIGHTING_SET_OUTPUT(i, off);
+            continue;
+        }
+
+        // Every hit is still applied, as some effects shift the hue even for hits out of reach
+        lighting_value_t value = lighting_value_with_level(LIGHTING_CONFIG_VALUE, 0);
+        for (uint8_t j = start; j < count; j++) {
+            int16_t dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            uint8_t dist = LIGHTING_LED_DISTANCE(i, g_last_hit_tracker.index[j], dx, dy);
+            value        = effect_func(value, dx, dy, dist, tick[j]);
+        }
+        value = lighting_value_with_level(value, scale8(lighting_value_level(value), lighting_value_level(LIGHTING_CONFIG_VALUE)));
+        LIGHTING_SET_OUTPUT(i, LIGHTING_CONVERT(value));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
+
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_reach(start, params, effect_func, NULL);
+}
+
+#endif // LIGHTING_KEYREACTIVE_ENABLED
@@ -0,0 +1,16 @@
+#pragma once
+
+typedef lighting_value_t (*sin_cos_i_f)(lighting_value_t value, int8_t sin, int8_t cos, uint8_t i, uint8_t time);
+
+bool effect_runner_sin_cos_i(effect_params_t* params, sin_cos_i_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint16_t time      = scale16by8(LIGHTING_TIMER, LIGHTING_SPEED / 4);
+    int8_t   cos_value = cos8(time) - 128;
+    int8_t   sin_value = sin8(time) - 128;
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        LIGHTING_SET_OUTPUT(i, LIGHTING_CONVERT(effect_func(LIGHTING_CONFIG_VALUE, cos_value, sin_value, i, time)));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
@@ -15,6 +15,9 @@
  */
 
 #include "keyboard.h"
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle.h"
+#endif
 
 void platform_setup(void);
 
@@ -72,5 +75,10 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef IDLE_SLEEP_ENABLE
+        // Sleep until the next scan is due, unless woken up sooner
+        idle_sleep_us(keyboard_idle_time_us());
+#endif
     }
 }
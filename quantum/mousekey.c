@@ -51,6 +51,14 @@ static int8_t  mousekey_y_inertia = 0; // ...
 #endif
 #ifdef MK_KINETIC_SPEED
 static uint16_t mouse_timer = 0;
+#    if !defined(MK_COMBINED) && !defined(MK_3_SPEED)
+// Movement is integrated over time in 1/256ths of a unit, and whatever doesn't
+// add up to a whole unit is carried over to the next report.
+static uint16_t move_timer     = 0;
+static uint16_t wheel_timer    = 0;
+static int16_t  move_carry[2]  = {0}; // x, y
+static int16_t  wheel_carry[2] = {0}; // v, h
+#    endif
 #endif
 
 #ifndef MK_3_SPEED
@@ -194,22 +202,35 @@ const uint16_t mk_base_speed        = MOUSEKEY_BASE_SPEED;
 const uint16_t mk_decelerated_speed = MOUSEKEY_DECELERATED_SPEED;
 const uint16_t mk_initial_speed     = MOUSEKEY_INITIAL_SPEED;
 
-static uint8_t move_unit(void) {
-    uint16_t speed = mk_initial_speed;
+/* Time in milliseconds since the movement started, for the acceleration curves.
+ * It stops counting long after any sensible base speed has been reached, which
+ * keeps the curves within 32 bits. */
+static uint32_t kinetic_time(void) {
+    const uint16_t time = timer_elapsed(mouse_timer);
+    return time > 10000 ? 10000 : time;
+}
+
+/* Current cursor speed, in pixels per second */
+static uint16_t move_speed(void) {
+    uint32_t speed = mk_initial_speed;
 
     if (mousekey_accel & (1 << 0)) {
         speed = mk_decelerated_speed;
     } else if (mousekey_accel & (1 << 2)) {
         speed = mk_accelerated_speed;
     } else if (mousekey_repeat && mouse_timer) {
-        const uint16_t time_elapsed = timer_elapsed(mouse_timer) / 50;
-        speed                       = mk_initial_speed + MOUSEKEY_MOVE_DELTA * time_elapsed + (MOUSEKEY_MOVE_DELTA * time_elapsed * time_elapsed) / 2;
+        const uint32_t time = kinetic_time();
+        speed               = mk_initial_speed + (MOUSEKEY_MOVE_DELTA * time) / 50 + (MOUSEKEY_MOVE_DELTA * time * time) / 5000;
         if (speed > mk_base_speed) {
             speed = mk_base_speed;
         }
     }
+    return speed;
+}
+
+static uint8_t move_unit(void) {
     /* convert speed to USB mouse speed 1 to 127 */
-    speed = (uint8_t)(speed / (1000U / mk_interval));
+    uint16_t speed = move_speed() / (1000U / mk_interval);
 
     if (speed > MOUSEKEY_MOVE_MAX) {
         speed = MOUSEKEY_MOVE_MAX;
@@ -219,26 +240,52 @@ static uint8_t move_unit(void) {
     return speed;
 }
 
-static uint8_t wheel_unit(void) {
-    uint16_t speed = MOUSEKEY_WHEEL_INITIAL_MOVEMENTS;
+/* Current wheel speed, in movements per second */
+static uint16_t wheel_speed(void) {
+    uint32_t speed = MOUSEKEY_WHEEL_INITIAL_MOVEMENTS;
 
     if (mousekey_accel & (1 << 0)) {
         speed = MOUSEKEY_WHEEL_DECELERATED_MOVEMENTS;
     } else if (mousekey_accel & (1 << 2)) {
         speed = MOUSEKEY_WHEEL_ACCELERATED_MOVEMENTS;
     } else if (mousekey_wheel_repeat && mouse_timer) {
-        if (mk_wheel_interval != MOUSEKEY_WHEEL_BASE_MOVEMENTS) {
-            const uint16_t time_elapsed = timer_elapsed(mouse_timer) / 50;
-            speed                       = MOUSEKEY_WHEEL_INITIAL_MOVEMENTS + 1 * time_elapsed + (1 * time_elapsed * time_elapsed) / 2;
-        }
+        const uint32_t time = kinetic_time();
+        speed               = MOUSEKEY_WHEEL_INITIAL_MOVEMENTS + time / 50 + (time * time) / 5000;
         if (speed > MOUSEKEY_WHEEL_BASE_MOVEMENTS) {
             speed = MOUSEKEY_WHEEL_BASE_MOVEMENTS;
         }
     }
-    mk_wheel_interval = 1000U / speed;
+    return speed;
+}
+
+static uint8_t wheel_unit(void) {
+    mk_wheel_interval = 1000U / wheel_speed();
     return 1;
 }
 
+/* Adds the distance travelled at `speed` units per second over `time` milliseconds
+ * to what was carried over on an axis, and returns the whole units to report. */
+static int8_t kinetic_step(int16_t *carry, int8_t direction, uint16_t speed, uint8_t time, bool diagonal, int8_t max) {
+    // 256/1000ths, as the carry is in 1/256ths of a unit
+    int32_t distance = ((uint32_t)speed * time * 32) / 125;
+    if (diagonal) {
+        distance = (distance * 181) / 256;
+    }
+
+    int32_t total = *carry + (direction < 0 ? -distance : distance);
+    int32_t whole = total / 256;
+    if (whole > max) {
+        whole = max;
+    } else if (whole < -max) {
+        whole = -max;
+    }
+
+    // Anything beyond the report limit is dropped rather than building up
+    total -= whole * 256;
+    *carry = total > 255 ? 255 : (total < -255 ? -255 : total);
+    return whole;
+}
+
 #        endif /* #ifndef MK_KINETIC_SPEED */
 #    else      /* #ifndef MK_COMBINED */
 
@@ -337,6 +384,27 @@ void mousekey_task(void) {
         tmpmr.y        = 0;
     }
 
+#    elif defined(MK_KINETIC_SPEED) && !defined(MK_COMBINED)
+
+    if (tmpmr.x || tmpmr.y) {
+        if (!mousekey_repeat && timer_elapsed(last_timer_c) > mk_delay * 10) {
+            // The first repeat moves as far as a whole interval would have
+            mousekey_repeat = 1;
+            move_timer      = timer_read() - mk_interval;
+        }
+
+        const uint16_t elapsed = timer_elapsed(move_timer);
+        if (mousekey_repeat && elapsed >= mk_interval) {
+            const uint16_t speed    = move_speed();
+            const uint8_t  time     = elapsed > UINT8_MAX ? UINT8_MAX : elapsed;
+            const bool     diagonal = tmpmr.x && tmpmr.y;
+
+            move_timer += elapsed;
+            if (tmpmr.x != 0) mouse_report.x = kinetic_step(&move_carry[0], (tmpmr.x > 0) ? 1 : -1, speed, time, diagonal, MOUSEKEY_MOVE_MAX);
+            if (tmpmr.y != 0) mouse_report.y = kinetic_step(&move_carry[1], (tmpmr.y > 0) ? 1 : -1, speed, time, diagonal, MOUSEKEY_MOVE_MAX);
+        }
+    }
+
 #    else // default acceleration
 
     if ((tmpmr.x || tmpmr.y) && timer_elapsed(last_timer_c) > (mousekey_repeat ? mk_interval : mk_delay * 10)) {
@@ -359,6 +427,28 @@ void mousekey_task(void) {
 
 #    endif // MOUSEKEY_INERTIA or not
 
+#    if defined(MK_KINETIC_SPEED) && !defined(MK_COMBINED)
+
+    if (tmpmr.v || tmpmr.h) {
+        if (!mousekey_wheel_repeat && timer_elapsed(last_timer_w) > mk_wheel_delay * 10) {
+            mousekey_wheel_repeat = 1;
+            wheel_timer           = timer_read() - mk_wheel_interval;
+        }
+
+        const uint16_t elapsed = timer_elapsed(wheel_timer);
+        if (mousekey_wheel_repeat && elapsed >= mk_interval) {
+            const uint16_t speed    = wheel_speed();
+            const uint8_t  time     = elapsed > UINT8_MAX ? UINT8_MAX : elapsed;
+            const bool     diagonal = tmpmr.v && tmpmr.h;
+
+            wheel_timer += elapsed;
+            if (tmpmr.v != 0) mouse_report.v = kinetic_step(&wheel_carry[0], (tmpmr.v > 0) ? 1 : -1, speed, time, diagonal, MOUSEKEY_WHEEL_MAX);
+            if (tmpmr.h != 0) mouse_report.h = kinetic_step(&wheel_carry[1], (tmpmr.h > 0) ? 1 : -1, speed, time, diagonal, MOUSEKEY_WHEEL_MAX);
+        }
+    }
+
+#    else
+
     if ((tmpmr.v || tmpmr.h) && timer_elapsed(last_timer_w) > (mousekey_wheel_repeat ? mk_wheel_interval : mk_wheel_delay * 10)) {
         if (mousekey_wheel_repeat != UINT8_MAX) mousekey_wheel_repeat++;
         if (tmpmr.v != 0) mouse_report.v = wheel_unit() * ((tmpmr.v > 0) ? 1 : -1);
@@ -377,6 +467,8 @@ void mousekey_task(void) {
         }
     }
 
+#    endif
+
     if (has_mouse_report_changed(&mouse_report, &tmpmr) || should_mousekey_report_send(&mouse_report)) {
         mousekey_send();
     }
@@ -475,6 +567,12 @@ void mousekey_off(uint8_t code) {
         mousekey_accel &= ~(1 << 1);
     else if (code == KC_MS_ACCEL2)
         mousekey_accel &= ~(1 << 2);
+#    if defined(MK_KINETIC_SPEED) && !defined(MK_COMBINED)
+    if (mouse_report.x == 0) move_carry[0] = 0;
+    if (mouse_report.y == 0) move_carry[1] = 0;
+    if (mouse_report.v == 0) wheel_carry[0] = 0;
+    if (mouse_report.h == 0) wheel_carry[1] = 0;
+#    endif
     if (mouse_report.x == 0 && mouse_report.y == 0) {
         mousekey_repeat = 0;
 #    ifdef MK_KINETIC_SPEED
@@ -630,6 +728,10 @@ void mousekey_clear(void) {
     mousekey_repeat       = 0;
     mousekey_wheel_repeat = 0;
     mousekey_accel        = 0;
+#if defined(MK_KINETIC_SPEED) && !defined(MK_COMBINED) && !defined(MK_3_SPEED)
+    memset(move_carry, 0, sizeof(move_carry));
+    memset(wheel_carry, 0, sizeof(wheel_carry));
+#endif
 #ifdef MOUSEKEY_INERTIA
     mousekey_frame     = 0;
     mousekey_x_inertia = 0;
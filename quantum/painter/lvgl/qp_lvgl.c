@@ -3,6 +3,9 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "qp_lvgl.h"
+#include "qp_internal.h"
+#include "qp_comms.h"
+#include "qp_draw.h"
 #include "timer.h"
 #include "deferred_exec.h"
 #include "lvgl.h"
@@ -16,22 +19,69 @@ typedef struct lvgl_state_t {
 static deferred_executor_t lvgl_executors[2] = {0}; // For lv_tick_inc and lv_task_handler
 static lvgl_state_t        lvgl_states[2]    = {0}; // For lv_tick_inc and lv_task_handler
 
+_Static_assert((QUANTUM_PAINTER_LVGL_DRAW_BUFFER_COUNT == 1) || (QUANTUM_PAINTER_LVGL_DRAW_BUFFER_COUNT == 2), "QUANTUM_PAINTER_LVGL_DRAW_BUFFER_COUNT needs to be 1 or 2");
+
 painter_device_t selected_display = NULL;
 void *           color_buffer     = NULL;
 
+static lv_disp_t *    lvgl_display  = NULL;  // LVGL display registered for the attached device
+static lv_disp_drv_t *flush_pending = NULL;  // LVGL display driver awaiting lv_disp_flush_ready()
+static bool           direct_mode   = false; // LVGL renders straight into an RGB565 surface's framebuffer
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter LVGL Integration Internal: qp_lvgl_flush
 
-void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
-    if (selected_display) {
-        uint32_t number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
-        qp_viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
-        qp_pixdata(selected_display, (void *)color_p, number_pixels);
+// Waits for any in-progress transfer to the display, then signals LVGL that the draw buffer is free again
+static void qp_lvgl_flush_complete(void) {
+    if (flush_pending) {
+        lv_disp_drv_t *disp = flush_pending;
+        flush_pending       = NULL;
+        qp_comms_stop(selected_display);
         qp_flush(selected_display);
         lv_disp_flush_ready(disp);
     }
 }
 
+void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
+    if (!selected_display) {
+        lv_disp_flush_ready(disp);
+        return;
+    }
+
+#ifdef QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
+    if (direct_mode) {
+        // LVGL has already rendered into the framebuffer, only the dirty region needs updating
+        qp_rgb565_surface_mark_dirty(selected_display, area->x1, area->y1, area->x2, area->y2);
+        lv_disp_flush_ready(disp);
+        return;
+    }
+#endif // QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
+
+    // LVGL shouldn't hand over another area before the previous one is done, but make sure regardless
+    qp_lvgl_flush_complete();
+
+    painter_driver_t *driver = (painter_driver_t *)selected_display;
+    if (!qp_comms_start(selected_display)) {
+        qp_dprintf("qp_lvgl_flush: fail (could not start comms)\n");
+        lv_disp_flush_ready(disp);
+        return;
+    }
+
+    // Allow the comms driver to transmit LVGL's draw buffer in the background, the comms stay open until completion
+    uint32_t number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
+    driver->driver_vtable->viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
+    qp_internal_pixdata_buffer_lend(color_p);
+    driver->driver_vtable->pixdata(selected_display, (void *)color_p, number_pixels);
+    qp_internal_pixdata_buffer_lend(NULL);
+
+    // Completion is signalled from qp_lvgl_wait, once LVGL requires the buffer again
+    flush_pending = disp;
+}
+
+static void qp_lvgl_wait(lv_disp_drv_t *disp) {
+    qp_lvgl_flush_complete();
+}
+
 static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
     lvgl_state_t *  state     = (lvgl_state_t *)cb_arg;
     static uint32_t last_tick = 0;
@@ -43,6 +93,8 @@ static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
         } break;
         case 1:
             lv_task_handler();
+            // Release the display before returning to the rest of the firmware
+            qp_lvgl_flush_complete();
             break;
 
         default:
@@ -93,33 +145,50 @@ bool qp_lvgl_attach(painter_device_t device) {
     // Init LVGL
     lv_init();
 
-    // Set up lvgl display buffer
-    static lv_disp_draw_buf_t draw_buf;
-    // Allocate a buffer for 1/10 screen size
-    const size_t count_required = driver->panel_width * driver->panel_height / 10;
-    color_buffer                = color_buffer ? realloc(color_buffer, sizeof(lv_color_t) * count_required) : malloc(sizeof(lv_color_t) * count_required);
-    if (!color_buffer) {
-        qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
-        qp_lvgl_detach();
-        return false;
-    }
-    memset(color_buffer, 0, sizeof(lv_color_t) * count_required);
-    // Initialize the display buffer.
-    lv_disp_draw_buf_init(&draw_buf, color_buffer, NULL, count_required);
-
     selected_display = device;
 
     uint16_t panel_width, panel_height, offset_x, offset_y;
     qp_get_geometry(selected_display, &panel_width, &panel_height, NULL, &offset_x, &offset_y);
 
+    // Set up lvgl display buffer
+    static lv_disp_draw_buf_t draw_buf;
+    direct_mode = false;
+#if defined(QUANTUM_PAINTER_RGB565_SURFACE_ENABLE) && (LV_COLOR_DEPTH == 16) && (LV_COLOR_16_SWAP == 1)
+    // Surfaces store byte-swapped RGB565 just like LVGL, so LVGL can render directly into the framebuffer
+    void *framebuffer = qp_rgb565_surface_get_buffer(device);
+    if (framebuffer) {
+        lv_disp_draw_buf_init(&draw_buf, framebuffer, NULL, (uint32_t)panel_width * panel_height);
+        direct_mode = true;
+    }
+#endif // defined(QUANTUM_PAINTER_RGB565_SURFACE_ENABLE) && (LV_COLOR_DEPTH == 16) && (LV_COLOR_16_SWAP == 1)
+
+    if (!direct_mode) {
+        // Allocate the draw buffer(s) as a fraction of the screen size
+        const size_t count_required = driver->panel_width * driver->panel_height / (QUANTUM_PAINTER_LVGL_DRAW_BUFFER_DIVISOR);
+        const size_t bytes_required = sizeof(lv_color_t) * count_required * (QUANTUM_PAINTER_LVGL_DRAW_BUFFER_COUNT);
+        color_buffer                = color_buffer ? realloc(color_buffer, bytes_required) : malloc(bytes_required);
+        if (!color_buffer) {
+            qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
+            qp_lvgl_detach();
+            return false;
+        }
+        memset(color_buffer, 0, bytes_required);
+        // Initialize the display buffer, with the second half as the alternate buffer if double-buffered
+        lv_color_t *second_buffer = (QUANTUM_PAINTER_LVGL_DRAW_BUFFER_COUNT > 1) ? ((lv_color_t *)color_buffer) + count_required : NULL;
+        lv_disp_draw_buf_init(&draw_buf, color_buffer, second_buffer, count_required);
+    }
+
     // Setting up display driver
-    static lv_disp_drv_t disp_drv;     /*Descriptor of a display driver*/
-    lv_disp_drv_init(&disp_drv);       /*Basic initialization*/
-    disp_drv.flush_cb = qp_lvgl_flush; /*Set your driver function*/
-    disp_drv.draw_buf = &draw_buf;     /*Assign the buffer to the display*/
-    disp_drv.hor_res  = panel_width;   /*Set the horizontal resolution of the display*/
-    disp_drv.ver_res  = panel_height;  /*Set the vertical resolution of the display*/
-    lv_disp_drv_register(&disp_drv);   /*Finally register the driver*/
+    static lv_disp_drv_t disp_drv;        /*Descriptor of a display driver*/
+    lv_disp_drv_init(&disp_drv);          /*Basic initialization*/
+    disp_drv.flush_cb    = qp_lvgl_flush; /*Set your driver function*/
+    disp_drv.wait_cb     = qp_lvgl_wait;  /*Completes any asynchronous flush*/
+    disp_drv.draw_buf    = &draw_buf;     /*Assign the buffer to the display*/
+    disp_drv.direct_mode = direct_mode;   /*Render directly into the framebuffer, if possible*/
+    disp_drv.hor_res     = panel_width;   /*Set the horizontal resolution of the display*/
+    disp_drv.ver_res     = panel_height;  /*Set the vertical resolution of the display*/
+
+    lvgl_display = lv_disp_drv_register(&disp_drv); /*Finally register the driver*/
 
     return true;
 }
@@ -128,6 +197,14 @@ bool qp_lvgl_attach(painter_device_t device) {
 // Quantum Painter LVGL Integration API: qp_lvgl_detach
 
 void qp_lvgl_detach(void) {
+    if (selected_display) {
+        qp_lvgl_flush_complete();
+    }
+    // Remove the display, so that the next attach gets a fresh default display rather than a second one
+    if (lvgl_display) {
+        lv_disp_remove(lvgl_display);
+        lvgl_display = NULL;
+    }
     for (int i = 0; i < 2; ++i) {
         cancel_deferred_exec_advanced(lvgl_executors, 2, lvgl_states[i].defer_token);
     }
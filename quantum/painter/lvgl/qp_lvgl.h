@@ -7,6 +7,25 @@
 #include "qp.h"
 #include "lvgl.h"
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter - LVGL configurables (add to your keyboard's config.h)
+
+#ifndef QUANTUM_PAINTER_LVGL_DRAW_BUFFER_COUNT
+/**
+ * @def This controls the number of draw buffers allocated for LVGL, either 1 or 2. With 2, LVGL renders the next area
+ *      into one buffer whilst the other is being transferred to the display, if the display's comms driver supports
+ *      asynchronous transfers.
+ */
+#    define QUANTUM_PAINTER_LVGL_DRAW_BUFFER_COUNT 2
+#endif
+
+#ifndef QUANTUM_PAINTER_LVGL_DRAW_BUFFER_DIVISOR
+/**
+ * @def This controls the size of each LVGL draw buffer, as a fraction of the display's total pixel count.
+ */
+#    define QUANTUM_PAINTER_LVGL_DRAW_BUFFER_DIVISOR 10
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter - LVGL External API
 
@@ -16,7 +16,7 @@ static bool validate_driver_vtable(painter_driver_t *driver) {
 }
 
 static bool validate_comms_vtable(painter_driver_t *driver) {
-    return (driver->comms_vtable && driver->comms_vtable->comms_init && driver->comms_vtable->comms_start && driver->comms_vtable->comms_stop && driver->comms_vtable->comms_send) ? true : false;
+    return (driver->comms_vtable && driver->comms_vtable->comms_init && driver->comms_vtable->comms_start && driver->comms_vtable->comms_stop && driver->comms_vtable->comms_send && (!driver->comms_vtable->comms_send_async || driver->comms_vtable->comms_wait)) ? true : false;
 }
 
 static bool validate_driver_integrity(painter_driver_t *driver) {
@@ -102,7 +102,16 @@ bool qp_clear(painter_device_t device) {
         return false;
     }
 
-    bool ret = driver->driver_vtable->clear(device);
+    bool ret;
+    if (driver->driver_vtable->fill) {
+        // Prefer the driver's accelerated fill, blanking the entire panel
+        uint16_t width, height;
+        qp_get_geometry(device, &width, &height, NULL, NULL, NULL);
+        qp_internal_fill_pixdata(device, 1, 0, 0, 0);
+        ret = driver->driver_vtable->fill(device, 0, 0, width - 1, height - 1, qp_internal_global_pixdata_buffer);
+    } else {
+        ret = driver->driver_vtable->clear(device);
+    }
     qp_comms_stop(device);
     qp_dprintf("qp_clear: %s\n", ret ? "ok" : "fail");
     return ret;
@@ -241,3 +250,68 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
     qp_comms_stop(device);
     return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_copyrect
+
+bool qp_copyrect(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint16_t dest_x, uint16_t dest_y) {
+    qp_dprintf("qp_copyrect: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_copyrect: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!driver->driver_vtable->copy) {
+        qp_dprintf("qp_copyrect: fail (not supported by driver)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_copyrect: fail (could not start comms)\n");
+        return false;
+    }
+
+    // Cater for cases where people have submitted the coordinates backwards
+    uint16_t l = QP_MIN(left, right);
+    uint16_t r = QP_MAX(left, right);
+    uint16_t t = QP_MIN(top, bottom);
+    uint16_t b = QP_MAX(top, bottom);
+
+    bool ret = driver->driver_vtable->copy(device, l, t, r, b, dest_x, dest_y);
+    qp_dprintf("qp_copyrect: %s\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_scroll
+
+bool qp_scroll(painter_device_t device, uint16_t top_fixed, uint16_t bottom_fixed, uint16_t scroll_offset) {
+    qp_dprintf("qp_scroll: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_scroll: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!driver->driver_vtable->scroll) {
+        qp_dprintf("qp_scroll: fail (not supported by driver)\n");
+        return false;
+    }
+
+    if (top_fixed + bottom_fixed >= driver->panel_height) {
+        qp_dprintf("qp_scroll: fail (fixed areas leave no scrollable region)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_scroll: fail (could not start comms)\n");
+        return false;
+    }
+
+    bool ret = driver->driver_vtable->scroll(device, top_fixed, bottom_fixed, scroll_offset);
+    qp_dprintf("qp_scroll: %s\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret;
+}
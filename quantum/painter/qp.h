@@ -72,6 +72,42 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT
+/**
+ * @def This controls the number of pixel data buffers, either 1 or 2. With 2, comms drivers capable of asynchronous
+ *      transfers (such as SPI on ChibiOS) send one buffer while the next is prepared in the other, at the cost of
+ *      doubling the RAM used by \ref QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT 1
+#endif
+
+#ifndef QUANTUM_PAINTER_IMAGE_CACHE_SIZE
+/**
+ * @def This controls the amount of RAM (in bytes) that may be used for holding images that have been pre-converted to a
+ *      display's native pixel format, using \ref qp_cache_image. Cached images are drawn by streaming the converted
+ *      pixel data directly, skipping decompression and palette conversion. Least-recently-drawn images are evicted
+ *      when the budget is exceeded. If set to 0, the image cache is disabled.
+ */
+#    define QUANTUM_PAINTER_IMAGE_CACHE_SIZE 0
+#endif
+
+#ifndef QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of images that can be held in the image cache at any one time. Only relevant
+ *      if \ref QUANTUM_PAINTER_IMAGE_CACHE_SIZE is non-zero.
+ */
+#    define QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES 4
+#endif
+
+#ifndef QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE
+/**
+ * @def This controls the size of the read-ahead cache used when streaming images and fonts from external flash, using
+ *      \ref qp_load_image_flash and \ref qp_load_font_flash. Larger values result in fewer, longer flash reads at the
+ *      cost of RAM. If set to 0, every byte is read from flash individually.
+ */
+#    define QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE 64
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -306,6 +342,39 @@ bool qp_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t
  */
 bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
 
+/**
+ * Copies a rectangular region of the display to another location on the same display.
+ *
+ * @note Only supported by drivers able to read back their own pixel data, such as surfaces. Overlapping source and
+ *       destination regions are handled correctly.
+ *
+ * @param device[in] the handle of the device to control
+ * @param left[in] the device's x-position of the source region to start
+ * @param top[in] the device's y-position of the source region to start
+ * @param right[in] the device's x-position of the source region to finish
+ * @param bottom[in] the device's y-position of the source region to finish
+ * @param dest_x[in] the device's x-position to copy the region to
+ * @param dest_y[in] the device's y-position to copy the region to
+ * @return true if copying the region succeeded
+ * @return false if copying the region failed, or is unsupported by the driver
+ */
+bool qp_copyrect(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint16_t dest_x, uint16_t dest_y);
+
+/**
+ * Configures hardware vertical scrolling on the display.
+ *
+ * @note Scrolling is performed by the panel itself, in the panel's native orientation -- the rotation supplied to
+ *       \ref qp_init is not taken into account.
+ *
+ * @param device[in] the handle of the device to control
+ * @param top_fixed[in] the number of rows at the top of the panel which do not scroll
+ * @param bottom_fixed[in] the number of rows at the bottom of the panel which do not scroll
+ * @param scroll_offset[in] the number of rows the scrollable region is offset by
+ * @return true if scrolling succeeded
+ * @return false if scrolling failed, or is unsupported by the driver
+ */
+bool qp_scroll(painter_device_t device, uint16_t top_fixed, uint16_t bottom_fixed, uint16_t scroll_offset);
+
 /**
  * Loads an image into memory.
  *
@@ -318,6 +387,21 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef QP_STREAM_HAS_FLASH_IO
+/**
+ * Loads an image stored in external flash.
+ *
+ * @note Images can be unloaded by calling \ref qp_close_image. Image data is read from flash on demand whenever the
+ *       image is drawn, through a small read-ahead cache.
+ *
+ * @param address[in] the address in external flash of the image data
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(uint32_t address);
+#endif // QP_STREAM_HAS_FLASH_IO
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -327,6 +411,46 @@ painter_image_handle_t qp_load_image_mem(const void *buffer);
  */
 bool qp_close_image(painter_image_handle_t image);
 
+#if (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+/**
+ * Pre-converts an image into the native pixel format of the supplied device, so that subsequent draws of the image to
+ * any device sharing the same pixel format skip decoding entirely.
+ *
+ * @note Requires \ref QUANTUM_PAINTER_IMAGE_CACHE_SIZE to be non-zero. Cached data is released by calling
+ *       \ref qp_uncache_image or \ref qp_close_image, or evicted automatically when the cache budget is exceeded.
+ *
+ * @param device[in] the handle of the device whose pixel format should be used
+ * @param image[in] the handle of the image to cache
+ * @return true if the image was cached
+ * @return false if caching the image failed
+ */
+bool qp_cache_image(painter_device_t device, painter_image_handle_t image);
+
+/**
+ * Pre-converts an image into the native pixel format of the supplied device, recoloring monochrome images to the
+ * desired foreground/background. Cached monochrome images are only used when drawn with the same colors.
+ *
+ * @param device[in] the handle of the device whose pixel format should be used
+ * @param image[in] the handle of the image to cache
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return true if the image was cached
+ * @return false if caching the image failed
+ */
+bool qp_cache_image_recolor(painter_device_t device, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+/**
+ * Releases all pre-converted data held in the image cache for the supplied image.
+ *
+ * @param image[in] the handle of the image to remove from the cache
+ */
+void qp_uncache_image(painter_image_handle_t image);
+#endif // (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+
 /**
  * Draws an image to the display.
  *
@@ -405,6 +529,20 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef QP_STREAM_HAS_FLASH_IO
+/**
+ * Loads a font stored in external flash.
+ *
+ * @note Fonts can be unloaded by calling \ref qp_close_font. If \ref QUANTUM_PAINTER_LOAD_FONTS_TO_RAM is enabled the
+ *       font is copied into RAM, otherwise glyphs are read from flash on demand.
+ *
+ * @param address[in] the address in external flash of the font data
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(uint32_t address);
+#endif // QP_STREAM_HAS_FLASH_IO
+
 /**
  * Closes a font handle when no longer in use.
  *
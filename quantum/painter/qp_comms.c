@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "qp_comms.h"
+#include "qp_draw.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base comms APIs
@@ -33,6 +34,7 @@ void qp_comms_stop(painter_device_t device) {
         return;
     }
 
+    qp_comms_wait(device);
     driver->comms_vtable->comms_stop(device);
 }
 
@@ -43,15 +45,33 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
         return false;
     }
 
+    // Only one transfer can be outstanding at any point in time
+    qp_comms_wait(device);
+
+    // The pixdata buffer can be sent asynchronously if the comms driver supports it -- the caller claims the spare
+    // buffer for preparing the next chunk of data whilst this one is transferred.
+    if (driver->comms_vtable->comms_send_async && qp_internal_pixdata_buffer_begin_transfer(data)) {
+        return driver->comms_vtable->comms_send_async(device, data, byte_count);
+    }
+
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+void qp_comms_wait(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (driver->comms_vtable->comms_wait) {
+        driver->comms_vtable->comms_wait(device);
+    }
+    qp_internal_pixdata_buffer_end_transfer();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
 void qp_comms_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *                   driver       = (painter_driver_t *)device;
     painter_comms_with_command_vtable_t *comms_vtable = (painter_comms_with_command_vtable_t *)driver->comms_vtable;
+    qp_comms_wait(device);
     comms_vtable->send_command(device, cmd);
 }
 
@@ -68,5 +88,6 @@ uint32_t qp_comms_command_databuf(painter_device_t device, uint8_t cmd, const vo
 void qp_comms_bulk_command_sequence(painter_device_t device, const uint8_t *sequence, size_t sequence_len) {
     painter_driver_t *                   driver       = (painter_driver_t *)device;
     painter_comms_with_command_vtable_t *comms_vtable = (painter_comms_with_command_vtable_t *)driver->comms_vtable;
+    qp_comms_wait(device);
     comms_vtable->bulk_command_sequence(device, sequence, sequence_len);
 }
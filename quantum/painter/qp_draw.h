@@ -10,7 +10,24 @@
 // Quantum Painter utility functions
 
 // Global variable used for native pixel data streaming.
+#if QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT > 1
+extern uint8_t *qp_internal_global_pixdata_buffer;
+#else
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+
+// Marks the start of an asynchronous transfer, returning false if the data isn't able to be sent asynchronously
+bool qp_internal_pixdata_buffer_begin_transfer(const void *data);
+
+// Marks the completion of any outstanding asynchronous transfer
+void qp_internal_pixdata_buffer_end_transfer(void);
+
+// Allows a caller-owned buffer to be sent asynchronously by the next pixdata call. The caller must not modify the buffer
+// until the transfer has completed, i.e. after qp_comms_wait() or qp_comms_stop().
+void qp_internal_pixdata_buffer_lend(const void *data);
+
+// Ensures the current pixdata buffer can be written to, swapping to the spare buffer if it's still being transmitted
+void qp_internal_pixdata_buffer_claim(void);
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -139,6 +139,7 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
             return false;
         }
         state->pixel_write_pos = 0;
+        qp_internal_pixdata_buffer_claim();
     }
 
     return true;
@@ -159,6 +160,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
             return false;
         }
         state->byte_write_pos = 0;
+        qp_internal_pixdata_buffer_claim();
     }
 
     return true;
@@ -8,6 +8,7 @@
 #include "qgf.h"
 
 _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE % 16) == 0, "QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE needs to be a non-zero multiple of 16");
+_Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT == 1) || (QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT == 2), "QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT needs to be 1 or 2");
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Global variables
@@ -20,7 +21,18 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //
 
 // Buffer used for transmitting native pixel data to the downstream device.
+#if QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT > 1
+// With double-buffering, qp_internal_global_pixdata_buffer points at whichever buffer is currently safe to write to,
+// whilst the other may still be in the process of being transmitted asynchronously.
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t *                                      qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
+#else
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+
+// Tracking of asynchronous transfers, either of a pixdata buffer or a caller-owned buffer that has been lent out
+static const void *qp_internal_pixdata_in_flight = NULL;
+static const void *qp_internal_pixdata_lent      = NULL;
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -41,6 +53,41 @@ uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
     return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
 }
 
+// Marks the start of an asynchronous transfer, returning false if the data isn't able to be sent asynchronously
+bool qp_internal_pixdata_buffer_begin_transfer(const void *data) {
+    if (data == qp_internal_pixdata_lent) {
+        qp_internal_pixdata_lent      = NULL;
+        qp_internal_pixdata_in_flight = data;
+        return true;
+    }
+#if QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT > 1
+    if (data == qp_internal_global_pixdata_buffer) {
+        qp_internal_pixdata_in_flight = data;
+        return true;
+    }
+#endif
+    return false;
+}
+
+// Marks the completion of any outstanding asynchronous transfer
+void qp_internal_pixdata_buffer_end_transfer(void) {
+    qp_internal_pixdata_in_flight = NULL;
+}
+
+// Allows a caller-owned buffer to be sent asynchronously by the next pixdata call
+void qp_internal_pixdata_buffer_lend(const void *data) {
+    qp_internal_pixdata_lent = data;
+}
+
+// Ensures the current pixdata buffer can be written to, swapping to the spare buffer if it's still being transmitted
+void qp_internal_pixdata_buffer_claim(void) {
+#if QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT > 1
+    if (qp_internal_pixdata_in_flight == qp_internal_global_pixdata_buffer) {
+        qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0]) ? qp_internal_pixdata_buffers[1] : qp_internal_pixdata_buffers[0];
+    }
+#endif
+}
+
 // qp_setpixel internal implementation, but accepts a buffer with pre-converted native pixel. Only the first pixel is used.
 bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -53,6 +100,9 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
     uint32_t          pixels_in_pixdata = qp_internal_num_pixels_in_buffer(device);
     num_pixels                          = QP_MIN(pixels_in_pixdata, num_pixels);
 
+    // Make sure we don't overwrite data that's still being transmitted
+    qp_internal_pixdata_buffer_claim();
+
     // Convert the color to native pixel format
     qp_pixel_t color = {.hsv888 = {.h = hue, .s = sat, .v = val}};
     driver->driver_vtable->palette_convert(device, 1, &color);
@@ -238,10 +288,16 @@ bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t left, ui
     uint16_t w = r - l + 1;
     uint16_t h = b - t + 1;
 
+    // Prefer the driver's accelerated fill if it has one, only the first pixel of the pixdata buffer is required
+    if (driver->driver_vtable->fill) {
+        return driver->driver_vtable->fill(device, l, t, r, b, qp_internal_global_pixdata_buffer);
+    }
+
     uint32_t remaining = w * h;
     driver->driver_vtable->viewport(device, l, t, r, b);
     while (remaining > 0) {
         uint32_t transmit = QP_MIN(remaining, pixels_in_pixdata);
+        // The same buffer contents are resent each time, so no claim is needed between transfers
         if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, transmit)) {
             return false;
         }
@@ -273,14 +329,14 @@ bool qp_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t righ
     }
 
     if (filled) {
-        // Fill up the pixdata buffer with the required number of native pixels
-        qp_internal_fill_pixdata(device, w * h, hue, sat, val);
+        // Fill up the pixdata buffer with the required number of native pixels -- accelerated fills only need one
+        qp_internal_fill_pixdata(device, driver->driver_vtable->fill ? 1 : w * h, hue, sat, val);
 
         // Perform the draw
         ret = qp_internal_fillrect_helper_impl(device, l, t, r, b);
     } else {
         // Fill up the pixdata buffer with the required number of native pixels
-        qp_internal_fill_pixdata(device, QP_MAX(w, h), hue, sat, val);
+        qp_internal_fill_pixdata(device, driver->driver_vtable->fill ? 1 : QP_MAX(w, h), hue, sat, val);
 
         // Draw 4x filled single-width rects to create an outline
         if (!qp_internal_fillrect_helper_impl(device, l, t, r, t) || !qp_internal_fillrect_helper_impl(device, l, b, r, b) || !qp_internal_fillrect_helper_impl(device, l, t + 1, l, b - 1) || !qp_internal_fillrect_helper_impl(device, r, t + 1, r, b - 1)) {
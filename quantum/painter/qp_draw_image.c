@@ -19,11 +19,100 @@ typedef struct qgf_image_handle_t {
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
+#ifdef QP_STREAM_HAS_FLASH_IO
+        qp_flash_stream_t flash_stream;
+#endif // QP_STREAM_HAS_FLASH_IO
     };
 } qgf_image_handle_t;
 
 static qgf_image_handle_t image_descriptors[QUANTUM_PAINTER_NUM_IMAGES] = {0};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Native-format image cache
+
+#if (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+
+typedef struct qp_image_cache_frame_t {
+    uint32_t offset; // byte offset of this frame's pixel data within the entry's pixdata
+    uint16_t left;   // drawing area relative to the image origin, inclusive
+    uint16_t top;
+    uint16_t right;
+    uint16_t bottom;
+    uint16_t delay;
+    bool     is_delta;
+} qp_image_cache_frame_t;
+
+typedef struct qp_image_cache_entry_t {
+    const qgf_image_handle_t *     image;
+    const painter_driver_vtable_t *driver_vtable; // pixel format key: drivers sharing a vtable share native pixel layout
+    uint8_t                        native_bits_per_pixel;
+    bool                           recolorable; // whether the fg/bg colors below affect the converted output
+    qp_pixel_t                     fg_hsv888;
+    qp_pixel_t                     bg_hsv888;
+    uint32_t                       alloc_size;
+    uint32_t                       last_used;
+    qp_image_cache_frame_t *       frames; // frame table, immediately followed by pixdata in the same allocation
+    uint8_t *                      pixdata;
+} qp_image_cache_entry_t;
+
+static qp_image_cache_entry_t image_cache[QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES] = {0};
+static uint32_t               image_cache_bytes_used                            = 0;
+static uint32_t               image_cache_clock                                 = 0;
+
+static void qp_image_cache_evict(qp_image_cache_entry_t *entry) {
+    image_cache_bytes_used -= entry->alloc_size;
+    free(entry->frames);
+    memset(entry, 0, sizeof(qp_image_cache_entry_t));
+}
+
+static qp_image_cache_entry_t *qp_image_cache_find(painter_device_t device, const qgf_image_handle_t *qgf_image, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    for (int i = 0; i < QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES; ++i) {
+        qp_image_cache_entry_t *entry = &image_cache[i];
+        if (entry->image != qgf_image || entry->driver_vtable != driver->driver_vtable || entry->native_bits_per_pixel != driver->native_bits_per_pixel) {
+            continue;
+        }
+        if (entry->recolorable && (memcmp(&entry->fg_hsv888.hsv888, &fg_hsv888.hsv888, sizeof(fg_hsv888.hsv888)) != 0 || memcmp(&entry->bg_hsv888.hsv888, &bg_hsv888.hsv888, sizeof(bg_hsv888.hsv888)) != 0)) {
+            continue;
+        }
+        return entry;
+    }
+    return NULL;
+}
+
+// Finds a free cache slot with room for the requested allocation, evicting least-recently-used entries as required
+static qp_image_cache_entry_t *qp_image_cache_reserve(uint32_t alloc_size) {
+    if (alloc_size > (QUANTUM_PAINTER_IMAGE_CACHE_SIZE)) {
+        return NULL;
+    }
+
+    while (true) {
+        qp_image_cache_entry_t *free_slot = NULL;
+        qp_image_cache_entry_t *lru_slot  = NULL;
+        for (int i = 0; i < QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES; ++i) {
+            qp_image_cache_entry_t *entry = &image_cache[i];
+            if (!entry->image) {
+                free_slot = free_slot ? free_slot : entry;
+            } else if (!lru_slot || (image_cache_clock - entry->last_used) > (image_cache_clock - lru_slot->last_used)) {
+                lru_slot = entry;
+            }
+        }
+
+        if (free_slot && image_cache_bytes_used + alloc_size <= (QUANTUM_PAINTER_IMAGE_CACHE_SIZE)) {
+            return free_slot;
+        }
+
+        if (!lru_slot) {
+            return NULL;
+        }
+
+        qp_dprintf("qp_image_cache_reserve: evicting cached image (%d bytes)\n", (int)lru_slot->alloc_size);
+        qp_image_cache_evict(lru_slot);
+    }
+}
+
+#endif // (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load image from stream
 
@@ -85,6 +174,30 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_flash
+
+#ifdef QP_STREAM_HAS_FLASH_IO
+
+static inline bool image_flash_stream_factory(qgf_image_handle_t *image, void *arg) {
+    uint32_t address = *(uint32_t *)arg;
+
+    // Assume we can read the graphics descriptor
+    image->flash_stream = qp_make_flash_stream(address, sizeof(qgf_graphics_descriptor_v1_t));
+
+    // Update the length of the stream to match, and rewind to the start
+    image->flash_stream.length   = qgf_get_total_size(&image->stream);
+    image->flash_stream.position = 0;
+
+    return true;
+}
+
+painter_image_handle_t qp_load_image_flash(uint32_t address) {
+    return qp_load_image_internal(image_flash_stream_factory, &address);
+}
+
+#endif // QP_STREAM_HAS_FLASH_IO
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -95,6 +208,11 @@ bool qp_close_image(painter_image_handle_t image) {
         return false;
     }
 
+#if (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+    // Release any pre-converted copies of this image
+    qp_uncache_image(image);
+#endif // (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+
     // Free up this image for use elsewhere.
     qgf_image->validate_ok = false;
     qp_stream_close(&qgf_image->stream);
@@ -207,6 +325,43 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     return true;
 }
 
+#if (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+static bool qp_drawimage_cached_impl(painter_device_t device, uint16_t x, uint16_t y, qp_image_cache_entry_t *entry, int frame_number, qgf_frame_info_t *frame_info) {
+    painter_driver_t *      driver = (painter_driver_t *)device;
+    qp_image_cache_frame_t *frame  = &entry->frames[frame_number];
+
+    // Fill out the frame info as if it were decoded, so that animations retain the correct timing
+    frame_info->is_delta = frame->is_delta;
+    frame_info->left     = frame->left;
+    frame_info->top      = frame->top;
+    frame_info->right    = frame->right + 1;
+    frame_info->bottom   = frame->bottom + 1;
+    frame_info->delay    = frame->delay;
+
+    entry->last_used = ++image_cache_clock;
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not start comms)\n");
+        return false;
+    }
+
+    // Configure where we're going to be rendering to
+    if (!driver->driver_vtable->viewport(device, x + frame->left, y + frame->top, x + frame->right, y + frame->bottom)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
+        qp_comms_stop(device);
+        return false;
+    }
+
+    // Pixel data is already in native format, so it can be sent in a single transaction
+    uint32_t pixel_count = ((uint32_t)(frame->right - frame->left + 1)) * (frame->bottom - frame->top + 1);
+    bool     ret         = driver->driver_vtable->pixdata(device, entry->pixdata + frame->offset, pixel_count);
+
+    qp_dprintf("qp_drawimage_recolor: %s (cached)\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret;
+}
+#endif // (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+
 static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
     qp_dprintf("qp_drawimage_recolor: entry\n");
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -221,6 +376,14 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
+#if (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+    // Short-circuit the decode if there's a pre-converted copy available
+    qp_image_cache_entry_t *cache_entry = qp_image_cache_find(device, qgf_image, fg_hsv888, bg_hsv888);
+    if (cache_entry) {
+        return qp_drawimage_cached_impl(device, x, y, cache_entry, frame_number, frame_info);
+    }
+#endif // (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+
     // Read the frame info
     if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
         qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
@@ -302,6 +465,183 @@ bool qp_drawimage_recolor(painter_device_t device, uint16_t x, uint16_t y, paint
     return qp_drawimage_recolor_impl(device, x, y, image, 0, &frame_info, fg_hsv888, bg_hsv888);
 }
 
+#if (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_cache_image_recolor
+
+typedef struct qp_image_cache_output_state_t {
+    painter_device_t device;
+    uint8_t *        target;
+    uint32_t         write_pos;
+} qp_image_cache_output_state_t;
+
+static bool qp_image_cache_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_image_cache_output_state_t *state  = (qp_image_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->target, palette, state->write_pos++, 1, &index);
+}
+
+static bool qp_image_cache_byte_appender(uint8_t byteval, void *cb_arg) {
+    qp_image_cache_output_state_t *state  = (qp_image_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixdata(state->device, state->target, state->write_pos++, byteval);
+}
+
+static void qp_image_cache_frame_bounds(const qgf_image_handle_t *qgf_image, const qgf_frame_info_t *frame_info, qp_image_cache_frame_t *frame) {
+    frame->is_delta = frame_info->is_delta;
+    frame->delay    = frame_info->delay;
+    if (frame_info->is_delta) {
+        frame->left   = frame_info->left;
+        frame->top    = frame_info->top;
+        frame->right  = frame_info->right - 1;
+        frame->bottom = frame_info->bottom - 1;
+    } else {
+        frame->left   = 0;
+        frame->top    = 0;
+        frame->right  = qgf_image->base.width - 1;
+        frame->bottom = qgf_image->base.height - 1;
+    }
+}
+
+static bool qp_cache_image_recolor_impl(painter_device_t device, painter_image_handle_t image, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    qp_dprintf("qp_cache_image_recolor: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_cache_image_recolor: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (!qgf_image || !qgf_image->validate_ok) {
+        qp_dprintf("qp_cache_image_recolor: fail (invalid image)\n");
+        return false;
+    }
+
+    // Nothing to do if it's already been converted
+    qp_image_cache_entry_t *entry = qp_image_cache_find(device, qgf_image, fg_hsv888, bg_hsv888);
+    if (entry) {
+        entry->last_used = ++image_cache_clock;
+        qp_dprintf("qp_cache_image_recolor: ok (already cached)\n");
+        return true;
+    }
+
+    // Work out how much space is required for all frames once converted
+    uint32_t pixdata_size = 0;
+    bool     recolorable  = false;
+    for (uint16_t frame_number = 0; frame_number < qgf_image->base.frame_count; ++frame_number) {
+        qgf_frame_info_t       frame_info = {0};
+        qp_image_cache_frame_t frame;
+        if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, &frame_info)) {
+            qp_dprintf("qp_cache_image_recolor: fail (could not read frame %d)\n", (int)frame_number);
+            return false;
+        }
+        if (frame_info.bpp > 8 && frame_info.bpp != driver->native_bits_per_pixel) {
+            qp_dprintf("qp_cache_image_recolor: fail (image's bpp doesn't match the target display's native_bits_per_pixel)\n");
+            return false;
+        }
+        qp_image_cache_frame_bounds(qgf_image, &frame_info, &frame);
+        pixdata_size += ((uint32_t)(frame.right - frame.left + 1)) * (frame.bottom - frame.top + 1) * driver->native_bits_per_pixel / 8;
+        recolorable |= !frame_info.has_palette && frame_info.bpp <= 8;
+    }
+
+    // Find somewhere to put it, evicting older images if need be
+    uint32_t frames_size = sizeof(qp_image_cache_frame_t) * qgf_image->base.frame_count;
+    uint32_t alloc_size  = frames_size + pixdata_size;
+    entry                = qp_image_cache_reserve(alloc_size);
+    if (!entry) {
+        qp_dprintf("qp_cache_image_recolor: fail (image requires %d bytes, exceeds QUANTUM_PAINTER_IMAGE_CACHE_SIZE)\n", (int)alloc_size);
+        return false;
+    }
+
+    void *buffer = malloc(alloc_size);
+    if (!buffer) {
+        qp_dprintf("qp_cache_image_recolor: fail (could not allocate %d bytes)\n", (int)alloc_size);
+        return false;
+    }
+
+    entry->image                 = qgf_image;
+    entry->driver_vtable         = driver->driver_vtable;
+    entry->native_bits_per_pixel = driver->native_bits_per_pixel;
+    entry->recolorable           = recolorable;
+    entry->fg_hsv888             = fg_hsv888;
+    entry->bg_hsv888             = bg_hsv888;
+    entry->alloc_size            = alloc_size;
+    entry->last_used             = ++image_cache_clock;
+    entry->frames                = (qp_image_cache_frame_t *)buffer;
+    entry->pixdata               = ((uint8_t *)buffer) + frames_size;
+    image_cache_bytes_used += alloc_size;
+
+    // Decode each frame into the cache, in the device's native format
+    uint32_t pixdata_offset = 0;
+    for (uint16_t frame_number = 0; frame_number < qgf_image->base.frame_count; ++frame_number) {
+        qgf_frame_info_t        frame_info = {0};
+        qp_image_cache_frame_t *frame      = &entry->frames[frame_number];
+        if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, &frame_info)) {
+            qp_dprintf("qp_cache_image_recolor: fail (could not read frame %d)\n", (int)frame_number);
+            qp_image_cache_evict(entry);
+            return false;
+        }
+
+        qp_image_cache_frame_bounds(qgf_image, &frame_info, frame);
+        frame->offset        = pixdata_offset;
+        uint32_t pixel_count = ((uint32_t)(frame->right - frame->left + 1)) * (frame->bottom - frame->top + 1);
+
+        qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
+        qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info.compression_scheme);
+        if (input_callback == NULL) {
+            qp_dprintf("qp_cache_image_recolor: fail (invalid image compression scheme)\n");
+            qp_image_cache_evict(entry);
+            return false;
+        }
+
+        qp_image_cache_output_state_t output_state = {.device = device, .target = entry->pixdata + pixdata_offset, .write_pos = 0};
+        bool                          ok;
+        if (frame_info.bpp <= 8) {
+            ok = qp_internal_decode_palette(device, pixel_count, frame_info.bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_image_cache_pixel_appender, &output_state);
+        } else {
+            ok = qp_internal_send_bytes(device, pixel_count * frame_info.bpp / 8, input_callback, &input_state, qp_image_cache_byte_appender, &output_state);
+        }
+
+        if (!ok) {
+            qp_dprintf("qp_cache_image_recolor: fail (could not decode frame %d)\n", (int)frame_number);
+            qp_image_cache_evict(entry);
+            return false;
+        }
+
+        pixdata_offset += pixel_count * driver->native_bits_per_pixel / 8;
+    }
+
+    qp_dprintf("qp_cache_image_recolor: ok (%d bytes)\n", (int)alloc_size);
+    return true;
+}
+
+bool qp_cache_image_recolor(painter_device_t device, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    return qp_cache_image_recolor_impl(device, image, fg_hsv888, bg_hsv888);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_cache_image
+
+bool qp_cache_image(painter_device_t device, painter_image_handle_t image) {
+    return qp_cache_image_recolor(device, image, 0, 0, 255, 0, 0, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_uncache_image
+
+void qp_uncache_image(painter_image_handle_t image) {
+    for (int i = 0; i < QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES; ++i) {
+        if (image_cache[i].image == (const qgf_image_handle_t *)image) {
+            qp_image_cache_evict(&image_cache[i]);
+        }
+    }
+}
+
+#endif // (QUANTUM_PAINTER_IMAGE_CACHE_SIZE) > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_animate
 
@@ -18,7 +18,7 @@ enum {
                      + (SSD1351_NUM_DEVICES) // SSD1351
 };
 
-static painter_device_t qp_devices[QP_NUM_DEVICES] = {NULL};
+static painter_device_t qp_devices[QP_NUM_DEVICES]; // zero-initialised, may be empty if only surfaces are in use
 
 bool qp_internal_register_device(painter_device_t driver) {
     for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
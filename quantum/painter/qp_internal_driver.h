@@ -18,6 +18,11 @@ typedef bool (*painter_driver_convert_palette_func)(painter_device_t device, int
 typedef bool (*painter_driver_append_pixels)(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices);
 typedef bool (*painter_driver_append_pixdata)(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte);
 
+// Optional accelerated operations -- drivers leave these as NULL if unsupported
+typedef bool (*painter_driver_fill_func)(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, const void *native_pixel);
+typedef bool (*painter_driver_copy_func)(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint16_t dest_x, uint16_t dest_y);
+typedef bool (*painter_driver_scroll_func)(painter_device_t device, uint16_t top_fixed, uint16_t bottom_fixed, uint16_t scroll_offset);
+
 // Driver vtable definition
 typedef struct painter_driver_vtable_t {
     painter_driver_init_func            init;
@@ -29,6 +34,9 @@ typedef struct painter_driver_vtable_t {
     painter_driver_convert_palette_func palette_convert;
     painter_driver_append_pixels        append_pixels;
     painter_driver_append_pixdata       append_pixdata;
+    painter_driver_fill_func            fill;   // optional
+    painter_driver_copy_func            copy;   // optional
+    painter_driver_scroll_func          scroll; // optional
 } painter_driver_vtable_t;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,12 +46,15 @@ typedef bool (*painter_driver_comms_init_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_start_func)(painter_device_t device);
 typedef void (*painter_driver_comms_stop_func)(painter_device_t device);
 typedef uint32_t (*painter_driver_comms_send_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef void (*painter_driver_comms_wait_func)(painter_device_t device);
 
 typedef struct painter_comms_vtable_t {
     painter_driver_comms_init_func  comms_init;
     painter_driver_comms_start_func comms_start;
     painter_driver_comms_stop_func  comms_stop;
     painter_driver_comms_send_func  comms_send;
+    painter_driver_comms_send_func  comms_send_async; // optional, returns before the transfer completes
+    painter_driver_comms_wait_func  comms_wait;       // optional, required if comms_send_async is provided
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
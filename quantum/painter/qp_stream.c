@@ -164,3 +164,117 @@ qp_file_stream_t qp_make_file_stream(FILE *f) {
     return stream;
 }
 #endif // QP_STREAM_HAS_FILE_IO
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Flash streams
+
+#ifdef QP_STREAM_HAS_FLASH_IO
+
+#    include "flash_spi.h"
+
+#    if (QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE) > 0
+// Read-ahead cache, shared between all flash streams as only one asset is decoded at any point in time. Keyed by
+// absolute flash address so that switching between streams simply results in a cache miss.
+static uint8_t  flash_cache[QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE];
+static uint32_t flash_cache_address = 0;
+static uint32_t flash_cache_length  = 0;
+#    endif // (QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE) > 0
+
+static inline int16_t flash_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+
+    uint32_t address = s->address + s->position;
+    uint8_t  c;
+#    if (QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE) > 0
+    if (address < flash_cache_address || address >= flash_cache_address + flash_cache_length) {
+        // Refill the cache from the current location, without reading past the end of the stream
+        uint32_t length = QP_MIN((uint32_t)(s->length - s->position), (uint32_t)(QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE));
+        if (flash_read_block(address, flash_cache, length) != FLASH_STATUS_SUCCESS) {
+            flash_cache_length = 0;
+            s->is_eof          = true;
+            return STREAM_EOF;
+        }
+        flash_cache_address = address;
+        flash_cache_length  = length;
+    }
+    c = flash_cache[address - flash_cache_address];
+#    else
+    if (flash_read_block(address, &c, 1) != FLASH_STATUS_SUCCESS) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+#    endif // (QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE) > 0
+
+    s->position++;
+    return c;
+}
+
+static inline bool flash_put(qp_stream_t *stream, uint8_t c) {
+    // Flash streams are read-only.
+    return false;
+}
+
+static inline int flash_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek
+    int32_t position = s->position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    // Same bounds semantics as memory streams
+    if (position < 0 || position > s->length) {
+        return -1;
+    }
+
+    s->position = position;
+    s->is_eof   = false;
+    return 0;
+}
+
+static inline int32_t flash_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->position;
+}
+
+static inline bool flash_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static inline void flash_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length) {
+    qp_flash_stream_t stream = {
+        .base     = {.get = flash_get, .put = flash_put, .seek = flash_seek, .tell = flash_tell, .is_eof = flash_is_eof, .close = flash_close},
+        .address  = address,
+        .length   = length,
+        .position = 0,
+    };
+    return stream;
+}
+
+void qp_flash_stream_invalidate_cache(void) {
+#    if (QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE) > 0
+    flash_cache_length = 0;
+#    endif // (QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE) > 0
+}
+
+#endif // QP_STREAM_HAS_FLASH_IO
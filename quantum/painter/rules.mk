@@ -25,6 +25,7 @@ SRC += \
     $(QUANTUM_DIR)/color.c \
     $(QUANTUM_DIR)/painter/qp.c \
     $(QUANTUM_DIR)/painter/qp_internal.c \
+    $(QUANTUM_DIR)/painter/qp_comms.c \
     $(QUANTUM_DIR)/painter/qp_stream.c \
     $(QUANTUM_DIR)/painter/qgf.c \
     $(QUANTUM_DIR)/painter/qff.c \
@@ -147,12 +148,21 @@ ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI)), yes)
     QUANTUM_LIB_SRC += spi_master.c
     VPATH += $(DRIVER_PATH)/painter/comms
     SRC += \
-        $(QUANTUM_DIR)/painter/qp_comms.c \
         $(DRIVER_PATH)/painter/comms/qp_comms_spi.c
 
     ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI_DC_RESET)), yes)
         OPT_DEFS += -DQUANTUM_PAINTER_SPI_DC_RESET_ENABLE
     endif
+
+    # Asynchronous transfers are only available on ChibiOS
+    ifeq ($(PLATFORM),CHIBIOS)
+        OPT_DEFS += -DQUANTUM_PAINTER_SPI_ASYNC_ENABLE
+    endif
+endif
+
+# Allow for streaming of images and fonts from external flash
+ifeq ($(strip $(FLASH_DRIVER)), spi)
+    OPT_DEFS += -DQP_STREAM_HAS_FLASH_IO
 endif
 
 # Check if LVGL needs to be enabled
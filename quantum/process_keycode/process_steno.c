@@ -21,9 +21,6 @@
 #ifdef VIRTSER_ENABLE
 #    include "virtser.h"
 #endif
-#ifdef STENO_ENABLE_ALL
-#    include "eeprom.h"
-#endif
 
 // All steno keys that have been pressed to form this chord,
 // stored in MAX_STROKE_SIZE groups of 8-bit arrays.
@@ -132,13 +129,13 @@ void steno_init(void) {
     if (!eeconfig_is_enabled()) {
         eeconfig_init();
     }
-    mode = eeprom_read_byte(EECONFIG_STENOMODE);
+    mode = eeconfig_read_byte(EECONFIG_STENOMODE);
 }
 
 void steno_set_mode(steno_mode_t new_mode) {
     steno_clear_chord();
     mode = new_mode;
-    eeprom_update_byte(EECONFIG_STENOMODE, mode);
+    eeconfig_update_byte(EECONFIG_STENOMODE, mode);
 }
 #endif // STENO_ENABLE_ALL
 
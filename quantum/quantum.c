@@ -72,6 +72,10 @@
 #    include "velocikey.h"
 #endif
 
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -197,6 +201,12 @@ void shutdown_quantum(void) {
 #endif
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
+#endif
+    // Commit any staged configuration before the reset
+    eeconfig_flush();
+#ifdef EEPROM_WRITE_CACHE_ENABLE
+    // Make sure any cached EEPROM writes survive the reset
+    eeprom_driver_flush();
 #endif
 }
 
@@ -501,6 +511,8 @@ __attribute__((weak)) void shutdown_user(void) {}
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+    // Don't leave staged configuration in RAM while the host may cut power
+    eeconfig_flush();
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
@@ -19,15 +19,21 @@ HSV SPLASH_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
     return hsv;
 }
 
+uint16_t SPLASH_reach(uint16_t tick) {
+    // The ring of light is 255 wide, and has moved past every LED by 510
+    if (tick >= 2 * UINT8_MAX) return 0;
+    return tick < UINT8_MAX ? tick + 1 : UINT8_MAX + 1;
+}
+
 #            ifdef ENABLE_RGB_MATRIX_SPLASH
 bool SPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SPLASH_math);
+    return effect_runner_reactive_splash_reach(qsub8(g_last_hit_tracker.count, 1), params, &SPLASH_math, &SPLASH_reach);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_MULTISPLASH
 bool MULTISPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SPLASH_math);
+    return effect_runner_reactive_splash_reach(0, params, &SPLASH_math, &SPLASH_reach);
 }
 #            endif
 
@@ -24,6 +24,26 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
+    if (g_rgb_led_neighbors) {
+        // Only visit the keys close enough to warm up
+        uint8_t led = g_led_config.matrix_co[row][col];
+        g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+        uint16_t end = pgm_read_word(&g_rgb_led_neighbor_index[led + 1]);
+        for (uint16_t i = pgm_read_word(&g_rgb_led_neighbor_index[led]); i < end; i++) {
+            uint8_t n_row = pgm_read_byte(&g_rgb_led_neighbors[i].row);
+            uint8_t n_col = pgm_read_byte(&g_rgb_led_neighbors[i].col);
+            uint8_t dist  = pgm_read_byte(&g_rgb_led_neighbors[i].dist);
+            if ((n_row == row && n_col == col) || dist > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                continue;
+            }
+            uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, dist);
+            if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+            }
+            g_rgb_frame_buffer[n_row][n_col] = qadd8(g_rgb_frame_buffer[n_row][n_col], amount);
+        }
+        return;
+    }
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
             if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
@@ -32,9 +52,7 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
             if (i_row == row && i_col == col) {
                 g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
             } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
+                uint8_t distance = rgb_matrix_led_distance(g_led_config.matrix_co[row][col], g_led_config.matrix_co[i_row][i_col]);
                 if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
                     uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
                     if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
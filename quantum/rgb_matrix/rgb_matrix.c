@@ -23,6 +23,12 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "lighting_task.h"
+#include "lighting_power.h"
+#include "action_layer.h"
+#include "action_util.h"
+#include "host.h"
+#include "led_tables.h"
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -36,7 +42,157 @@ const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
 __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+#ifdef RGB_MATRIX_OUTPUT_LUT
+    // The output stage applies the curve to each channel instead
+    return hsv_to_rgb_nocie(hsv);
+#else
     return hsv_to_rgb(hsv);
+#endif
+}
+
+// LED geometry generated from info.json at build time. As the LED positions and the
+// centre point can both be overridden in code, it is only used if its checksum matches.
+// The tables are in flash.
+extern const uint16_t k_led_geometry_checksum __attribute__((weak));
+#ifdef RGB_MATRIX_LED_POLAR_ENABLED
+extern const led_polar_t g_led_polar[] __attribute__((weak));
+#endif
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+extern const uint8_t g_led_distance[] __attribute__((weak));
+#endif
+
+#if defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+// The keys around each LED, which also depend on the LED at each matrix position. These are in flash.
+extern const uint16_t       k_led_neighbor_checksum __attribute__((weak));
+extern const uint16_t       g_led_neighbor_index[] __attribute__((weak));
+extern const led_neighbor_t g_led_neighbors[] __attribute__((weak));
+#endif
+
+#ifdef RGB_MATRIX_LED_POLAR_ENABLED
+const led_polar_t *g_rgb_led_polar = NULL;
+#endif
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+const uint8_t *g_rgb_led_distance = NULL;
+#endif
+#if defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+const uint16_t       *g_rgb_led_neighbor_index = NULL;
+const led_neighbor_t *g_rgb_led_neighbors      = NULL;
+#endif
+
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+// Whether reactive effects can skip LEDs that are out of reach of every hit
+static bool splash_bucketing = false;
+#endif
+
+static inline void fletcher16(uint16_t *sum1, uint16_t *sum2, uint8_t value) {
+    *sum1 = (*sum1 + value) % 255;
+    *sum2 = (*sum2 + *sum1) % 255;
+}
+
+static uint16_t led_geometry_checksum(void) {
+    // Fletcher-16 over the centre point and the LED positions
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+    for (int16_t i = -1; i < RGB_MATRIX_LED_COUNT; i++) {
+        const led_point_t point = i < 0 ? k_rgb_matrix_center : g_led_config.point[i];
+        fletcher16(&sum1, &sum2, point.x);
+        fletcher16(&sum1, &sum2, point.y);
+    }
+    return (sum2 << 8) | sum1;
+}
+
+#if defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+static uint16_t led_matrix_checksum(void) {
+    // Fletcher-16 over the LED at each matrix position, offset by one as
+    // Fletcher-16 can't tell LED 0 from NO_LED otherwise
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            fletcher16(&sum1, &sum2, g_led_config.matrix_co[row][col] + 1);
+        }
+    }
+    return (sum2 << 8) | sum1;
+}
+#endif
+
+static void led_geometry_init(void) {
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    // sqrt16() wraps for LEDs 256 or more units apart, after which their distance no longer
+    // follows from their positions. Nearly every layout fits well within that.
+    uint8_t min_x = UINT8_MAX, max_x = 0, min_y = UINT8_MAX, max_y = 0;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        min_x = MIN(min_x, g_led_config.point[i].x);
+        max_x = MAX(max_x, g_led_config.point[i].x);
+        min_y = MIN(min_y, g_led_config.point[i].y);
+        max_y = MAX(max_y, g_led_config.point[i].y);
+    }
+    splash_bucketing = (uint32_t)(max_x - min_x) * (max_x - min_x) + (uint32_t)(max_y - min_y) * (max_y - min_y) <= UINT16_MAX;
+#endif
+
+#ifdef RGB_MATRIX_LED_POLAR_ENABLED
+    g_rgb_led_polar = NULL;
+#endif
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+    g_rgb_led_distance = NULL;
+#endif
+#if defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+    g_rgb_led_neighbor_index = NULL;
+    g_rgb_led_neighbors      = NULL;
+#endif
+    if (&k_led_geometry_checksum == NULL || pgm_read_word(&k_led_geometry_checksum) != led_geometry_checksum()) {
+        return;
+    }
+#ifdef RGB_MATRIX_LED_POLAR_ENABLED
+    g_rgb_led_polar = g_led_polar;
+#endif
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+    g_rgb_led_distance = g_led_distance;
+#endif
+#if defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+    if (&k_led_neighbor_checksum != NULL && pgm_read_word(&k_led_neighbor_checksum) == led_matrix_checksum()) {
+        g_rgb_led_neighbor_index = g_led_neighbor_index;
+        g_rgb_led_neighbors      = g_led_neighbors;
+    }
+#endif
+}
+
+/** \brief Distance and angle of an LED from the centre point */
+static inline led_polar_t rgb_matrix_led_polar(uint8_t led) {
+#ifdef RGB_MATRIX_LED_POLAR_ENABLED
+    if (g_rgb_led_polar) {
+        return (led_polar_t){.dist = pgm_read_byte(&g_rgb_led_polar[led].dist), .angle = pgm_read_byte(&g_rgb_led_polar[led].angle)};
+    }
+#endif
+    int16_t dx = g_led_config.point[led].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[led].y - k_rgb_matrix_center.y;
+    return (led_polar_t){.dist = sqrt16(dx * dx + dy * dy), .angle = atan2_8(dy, dx)};
+}
+
+/** \brief Distance of an LED from the centre point */
+static inline uint8_t rgb_matrix_led_dist(uint8_t led, int16_t dx, int16_t dy) {
+#ifdef RGB_MATRIX_LED_POLAR_ENABLED
+    if (g_rgb_led_polar) {
+        return pgm_read_byte(&g_rgb_led_polar[led].dist);
+    }
+#endif
+    return sqrt16(dx * dx + dy * dy);
+}
+
+/** \brief Distance between two LEDs */
+static inline uint8_t rgb_matrix_led_distance(uint8_t a, uint8_t b) {
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+    if (g_rgb_led_distance) {
+        if (a == b) {
+            return 0;
+        }
+        // The table holds the lower triangle of the distance matrix
+        return pgm_read_byte(a > b ? &g_rgb_led_distance[(uint16_t)a * (a - 1) / 2 + b] : &g_rgb_led_distance[(uint16_t)b * (b - 1) / 2 + a]);
+    }
+#endif
+    int16_t dx = g_led_config.point[a].x - g_led_config.point[b].x;
+    int16_t dy = g_led_config.point[a].y - g_led_config.point[b].y;
+    return sqrt16(dx * dx + dy * dy);
 }
 
 // Generic effect runners
@@ -69,6 +225,21 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
 #    define RGB_MATRIX_MAXIMUM_BRIGHTNESS UINT8_MAX
 #endif
 
+#if !defined(RGB_MATRIX_WHITE_BALANCE)
+#    define RGB_MATRIX_WHITE_BALANCE \
+        { 255, 255, 255 }
+#endif
+
+#if !defined(RGB_MATRIX_CHANNEL_CURRENT)
+#    define RGB_MATRIX_CHANNEL_CURRENT 20
+#endif
+
+#if !defined(RGB_MATRIX_MAX_OVERLAYS)
+#    define RGB_MATRIX_MAX_OVERLAYS 8
+#elif RGB_MATRIX_MAX_OVERLAYS < 1 || RGB_MATRIX_MAX_OVERLAYS > 8
+#    error invalid RGB_MATRIX_MAX_OVERLAYS value (must be between 1 and 8)
+#endif
+
 #if !defined(RGB_MATRIX_HUE_STEP)
 #    define RGB_MATRIX_HUE_STEP 8
 #endif
@@ -129,6 +300,33 @@ static rgb_task_states rgb_task_state    = SYNCING;
 #if RGB_MATRIX_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif // RGB_MATRIX_TIMEOUT > 0
+#ifdef RGB_MATRIX_OUTPUT_LUT
+static uint8_t rgb_white_balance[3] = RGB_MATRIX_WHITE_BALANCE;
+// Maps every value written to an LED to what is sent to the driver, one table per channel
+static uint8_t rgb_output_lut[3][256];
+#endif // RGB_MATRIX_OUTPUT_LUT
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+// Every LED's color as last written, and the sum of all their channels, so each flush
+// knows how much current the frame would draw without going over every LED again
+static RGB      rgb_frame[RGB_MATRIX_LED_COUNT];
+static uint32_t rgb_frame_level   = 0;
+static bool     rgb_frame_limited = false;
+#endif // RGB_MATRIX_CURRENT_LIMIT
+
+#ifdef RGB_MATRIX_OVERLAYS
+// The effect's colors as last written, and all the enabled overlays drawn over black. Each
+// LED shows its effect color scaled by how much the overlays let through, plus theirs.
+static RGB                         rgb_base[RGB_MATRIX_LED_COUNT];
+static RGB                         rgb_overlay_color[RGB_MATRIX_LED_COUNT];
+static uint8_t                     rgb_overlay_keep[RGB_MATRIX_LED_COUNT];
+static uint8_t                     rgb_overlay_alpha[RGB_MATRIX_MAX_OVERLAYS];
+static uint8_t                     rgb_overlay_state    = 0;
+static uint8_t                     rgb_overlay_drawing  = UINT8_MAX;
+static bool                        rgb_overlays_covered = false;
+static bool                        rgb_overlays_shown   = false;
+static bool                        rgb_overlays_dirty   = true;
+static lighting_indicator_inputs_t rgb_overlay_inputs;
+#endif // RGB_MATRIX_OVERLAYS
 
 // double buffers
 static uint32_t rgb_timer_buffer;
@@ -139,12 +337,28 @@ static last_hit_t last_hit_buffer;
 // split rgb matrix
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+
+static rgb_matrix_event_sync_t rgb_event_sync;
+static bool                    rgb_event_synced = false;
+static uint32_t                rgb_events_lost  = 0;
+
+// Each sync goes over the split transport in one transaction, whose size is a uint8_t
+_Static_assert(RGB_MATRIX_SPLIT_EVENTS > 0 && sizeof(rgb_matrix_event_sync_t) <= UINT8_MAX, "RGB_MATRIX_SPLIT_EVENTS must be between 1 and 63");
 #endif
 
-EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
+static inline void eeconfig_init_rgb_matrix(void) {
+    eeconfig_read_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config));
+}
 
 void eeconfig_update_rgb_matrix(void) {
-    eeconfig_flush_rgb_matrix(true);
+    eeconfig_update_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config));
+}
+
+// Changes are staged in the eeconfig mirror, which eeconfig_task() commits to EEPROM once they have settled
+static inline void eeconfig_flag_rgb_matrix(bool write_to_eeprom) {
+    if (write_to_eeprom) {
+        eeconfig_update_rgb_matrix();
+    }
 }
 
 void eeconfig_update_rgb_matrix_default(void) {
@@ -154,7 +368,7 @@ void eeconfig_update_rgb_matrix_default(void) {
     rgb_matrix_config.hsv    = (HSV){RGB_MATRIX_DEFAULT_HUE, RGB_MATRIX_DEFAULT_SAT, RGB_MATRIX_DEFAULT_VAL};
     rgb_matrix_config.speed  = RGB_MATRIX_DEFAULT_SPD;
     rgb_matrix_config.flags  = LED_FLAG_ALL;
-    eeconfig_flush_rgb_matrix(true);
+    eeconfig_update_rgb_matrix();
 }
 
 void eeconfig_debug_rgb_matrix(void) {
@@ -193,26 +407,243 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 }
 
 void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+    uint16_t scale = lighting_power_scale(rgb_frame_level, RGB_MATRIX_CHANNEL_CURRENT, RGB_MATRIX_CURRENT_LIMIT);
+    // Dim the whole frame when it would draw too much, and restore it once it doesn't
+    if (scale < 256 || rgb_frame_limited) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            rgb_matrix_driver.set_color(i, rgb_frame[i].r * scale >> 8, rgb_frame[i].g * scale >> 8, rgb_frame[i].b * scale >> 8);
+        }
+        rgb_frame_limited = scale < 256;
+    }
+#endif // RGB_MATRIX_CURRENT_LIMIT
     rgb_matrix_driver.flush();
 }
 
-void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+uint16_t rgb_matrix_get_current_estimate(void) {
+    return MIN(lighting_power_estimate(rgb_frame_level, RGB_MATRIX_CHANNEL_CURRENT), UINT16_MAX);
+}
+
+bool rgb_matrix_is_current_limited(void) {
+    return rgb_frame_limited;
+}
+
+static inline void rgb_frame_set(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_frame_level += (red + green + blue) - (rgb_frame[index].r + rgb_frame[index].g + rgb_frame[index].b);
+        rgb_frame[index] = (RGB){.r = red, .g = green, .b = blue};
+    }
+}
+#endif // RGB_MATRIX_CURRENT_LIMIT
+
+#ifdef RGB_MATRIX_OUTPUT_LUT
+static void rgb_output_lut_update(void) {
+    for (uint8_t channel = 0; channel < 3; channel++) {
+        uint8_t value = 0;
+        do {
+#    ifdef USE_CIE1931_CURVE
+            uint8_t level = pgm_read_byte(&CIE1931_CURVE[value]);
+#    else
+            uint8_t level = value;
+#    endif
+            // Full balance leaves the curve as is
+            rgb_output_lut[channel][value] = (uint16_t)level * (rgb_white_balance[channel] + 1) >> 8;
+        } while (++value);
+    }
+}
+
+void rgb_matrix_set_white_balance(uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_white_balance[0] = red;
+    rgb_white_balance[1] = green;
+    rgb_white_balance[2] = blue;
+    rgb_output_lut_update();
+}
+
+uint8_t rgb_matrix_get_output_level(uint8_t channel, uint8_t value) {
+    return rgb_output_lut[channel][value];
+}
+#endif // RGB_MATRIX_OUTPUT_LUT
+
+static void rgb_matrix_write_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_OUTPUT_LUT
+    red   = rgb_output_lut[0][red];
+    green = rgb_output_lut[1][green];
+    blue  = rgb_output_lut[2][blue];
+#endif // RGB_MATRIX_OUTPUT_LUT
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+    rgb_frame_set(index, red, green, blue);
+#endif // RGB_MATRIX_CURRENT_LIMIT
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
+#ifdef RGB_MATRIX_OVERLAYS
+static inline uint8_t rgb_overlay_mix(uint8_t under, uint8_t over, uint8_t alpha) {
+    return ((uint16_t)under * (256 - alpha) + (uint16_t)over * (alpha + 1)) >> 8;
+}
+
+static inline RGB rgb_overlay_blend(uint8_t index, RGB base) {
+    uint8_t keep = rgb_overlay_keep[index];
+    if (keep == UINT8_MAX) {
+        return base;
+    }
+    RGB over = rgb_overlay_color[index];
+    if (keep == 0) {
+        return over;
+    }
+    return (RGB){
+        .r = qadd8((uint16_t)base.r * (keep + 1) >> 8, over.r),
+        .g = qadd8((uint16_t)base.g * (keep + 1) >> 8, over.g),
+        .b = qadd8((uint16_t)base.b * (keep + 1) >> 8, over.b),
+    };
+}
+
+void rgb_matrix_overlay_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    // Only overlays being drawn by rgb_matrix_overlay_kb() can be written to
+    if (rgb_overlay_drawing == UINT8_MAX || index < 0 || index >= RGB_MATRIX_LED_COUNT) {
+        return;
+    }
+    uint8_t alpha = rgb_overlay_alpha[rgb_overlay_drawing];
+    RGB    *color = &rgb_overlay_color[index];
+    if (alpha == UINT8_MAX) {
+        *color = (RGB){.r = red, .g = green, .b = blue};
+    } else {
+        *color = (RGB){.r = rgb_overlay_mix(color->r, red, alpha), .g = rgb_overlay_mix(color->g, green, alpha), .b = rgb_overlay_mix(color->b, blue, alpha)};
+    }
+    rgb_overlay_keep[index] = (uint16_t)rgb_overlay_keep[index] * (256 - alpha) >> 8;
+}
+
+void rgb_matrix_overlay_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_overlay_set_color(i, red, green, blue);
+    }
+}
+
+__attribute__((weak)) bool rgb_matrix_overlay_kb(uint8_t overlay) {
+    return rgb_matrix_overlay_user(overlay);
+}
+
+__attribute__((weak)) bool rgb_matrix_overlay_user(uint8_t overlay) {
+    return true;
+}
+
+void rgb_matrix_set_overlay_state(uint8_t overlay, bool enabled) {
+    if (overlay < RGB_MATRIX_MAX_OVERLAYS) {
+        uint8_t state = enabled ? rgb_overlay_state | (1 << overlay) : rgb_overlay_state & ~(1 << overlay);
+        rgb_overlays_dirty |= state != rgb_overlay_state;
+        rgb_overlay_state = state;
+    }
+}
+
+bool rgb_matrix_get_overlay_state(uint8_t overlay) {
+    return overlay < RGB_MATRIX_MAX_OVERLAYS && (rgb_overlay_state & (1 << overlay));
+}
+
+void rgb_matrix_set_overlay_alpha(uint8_t overlay, uint8_t alpha) {
+    if (overlay < RGB_MATRIX_MAX_OVERLAYS && rgb_overlay_alpha[overlay] != alpha) {
+        rgb_overlay_alpha[overlay] = alpha;
+        rgb_overlays_dirty |= (rgb_overlay_state & (1 << overlay)) != 0;
+    }
+}
+
+void rgb_matrix_overlays_changed(void) {
+    rgb_overlays_dirty = true;
+}
+
+// Draws the enabled overlays again, and puts them over the effect, if anything they depend on
+// has changed. Returns whether any LED was written.
+static bool rgb_overlays_update(bool show) {
+    bool was_covered = rgb_overlays_shown && rgb_overlays_covered;
+    if (!show) {
+        // Nothing is drawn over the frame that turns the LEDs off
+        rgb_overlays_shown = false;
+        return false;
+    }
+
+    lighting_indicator_inputs_t inputs;
+    lighting_indicator_inputs_read(&inputs);
+    if (rgb_overlays_shown && !rgb_overlays_dirty && memcmp(&inputs, &rgb_overlay_inputs, sizeof(inputs)) == 0) {
+        return false;
+    }
+    rgb_overlay_inputs = inputs;
+    rgb_overlays_dirty = false;
+    rgb_overlays_shown = true;
+
+    memset(rgb_overlay_color, 0, sizeof(rgb_overlay_color));
+    memset(rgb_overlay_keep, UINT8_MAX, sizeof(rgb_overlay_keep));
+    for (uint8_t overlay = 0; overlay < RGB_MATRIX_MAX_OVERLAYS; overlay++) {
+        if (rgb_overlay_state & (1 << overlay)) {
+            rgb_overlay_drawing = overlay;
+            rgb_matrix_overlay_kb(overlay);
+        }
+    }
+    rgb_overlay_drawing = UINT8_MAX;
+
+    rgb_overlays_covered = false;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_overlays_covered |= rgb_overlay_keep[i] != UINT8_MAX;
+    }
+    if (!was_covered && !rgb_overlays_covered) {
+        return false;
+    }
+
+    // The effect isn't rendered again, its last colors are put back under the new overlays
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        RGB rgb = rgb_overlay_blend(i, rgb_base[i]);
+        rgb_matrix_write_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return true;
+}
+#endif // RGB_MATRIX_OVERLAYS
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_OVERLAYS
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        RGB rgb         = (RGB){.r = red, .g = green, .b = blue};
+        rgb_base[index] = rgb;
+        if (rgb_overlays_shown) {
+            rgb   = rgb_overlay_blend(index, rgb);
+            red   = rgb.r;
+            green = rgb.g;
+            blue  = rgb.b;
+        }
+    }
+#endif // RGB_MATRIX_OVERLAYS
+    rgb_matrix_write_color(index, red, green, blue);
+}
+
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_OVERLAYS
+    if (rgb_overlays_shown && rgb_overlays_covered) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            rgb_matrix_set_color(i, red, green, blue);
+        }
+        return;
+    }
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_base[i] = (RGB){.r = red, .g = green, .b = blue};
+    }
+#endif // RGB_MATRIX_OVERLAYS
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
+#    ifdef RGB_MATRIX_OUTPUT_LUT
+    red   = rgb_output_lut[0][red];
+    green = rgb_output_lut[1][green];
+    blue  = rgb_output_lut[2][blue];
+#    endif // RGB_MATRIX_OUTPUT_LUT
+#    ifdef RGB_MATRIX_CURRENT_LIMIT
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_frame[i] = (RGB){.r = red, .g = green, .b = blue};
+    }
+    rgb_frame_level = (uint32_t)(red + green + blue) * RGB_MATRIX_LED_COUNT;
+#    endif // RGB_MATRIX_CURRENT_LIMIT
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
 
-void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
-#ifndef RGB_MATRIX_SPLIT
-    if (!is_keyboard_master()) return;
-#endif
+static void rgb_matrix_record_event(uint8_t row, uint8_t col, bool pressed, uint16_t tick) {
 #if RGB_MATRIX_TIMEOUT > 0
     rgb_anykey_timer = 0;
 #endif // RGB_MATRIX_TIMEOUT > 0
@@ -230,22 +661,7 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
+    lighting_last_hit_record(&last_hit_buffer, led, led_count, tick);
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
@@ -262,6 +678,55 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #endif // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
 }
 
+void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
+    if (!is_keyboard_master()) return;
+
+#ifdef RGB_MATRIX_SPLIT
+    // Queue the event for the slave half, which replays these instead of its own switch events
+    memmove(&rgb_event_sync.events[0], &rgb_event_sync.events[1], sizeof(rgb_event_sync.events) - sizeof(rgb_event_sync.events[0]));
+    rgb_event_sync.events[RGB_MATRIX_SPLIT_EVENTS - 1] = (rgb_matrix_event_t){.row = row, .col = col, .pressed = pressed, .time = rgb_timer_buffer};
+    rgb_event_sync.sequence++;
+    if (rgb_event_sync.count < RGB_MATRIX_SPLIT_EVENTS) rgb_event_sync.count++;
+#endif // RGB_MATRIX_SPLIT
+
+    rgb_matrix_record_event(row, col, pressed, 0);
+}
+
+#ifdef RGB_MATRIX_SPLIT
+void rgb_matrix_get_event_sync(rgb_matrix_event_sync_t *sync) {
+    memcpy(sync, &rgb_event_sync, sizeof(rgb_matrix_event_sync_t));
+}
+
+void rgb_matrix_update_event_sync(const rgb_matrix_event_sync_t *sync) {
+    uint8_t pending = sync->sequence - rgb_event_sync.sequence;
+    memcpy(&rgb_event_sync, sync, sizeof(rgb_matrix_event_sync_t));
+
+    // Anything before the first sync happened before this half was listening
+    if (!rgb_event_synced) {
+        rgb_event_synced = true;
+        return;
+    }
+
+    // Events that have already been replaced are lost
+    if (pending > sync->count) {
+        rgb_events_lost += pending - sync->count;
+        dprintf("rgb_matrix: %d split events lost, raise RGB_MATRIX_SPLIT_EVENTS\n", pending - sync->count);
+        pending = sync->count;
+    }
+    for (uint8_t i = RGB_MATRIX_SPLIT_EVENTS - pending; i < RGB_MATRIX_SPLIT_EVENTS; i++) {
+        const rgb_matrix_event_t *event = &sync->events[i];
+        // Aged as if recorded when the master did, as both halves share the timer
+        uint16_t tick = (uint16_t)rgb_timer_buffer - event->time;
+        if (tick > INT16_MAX) tick = 0;
+        rgb_matrix_record_event(event->row, event->col, event->pressed, tick);
+    }
+}
+
+uint32_t rgb_matrix_get_lost_split_events(void) {
+    return rgb_events_lost;
+}
+#endif // RGB_MATRIX_SPLIT
+
 void rgb_matrix_test(void) {
     // Mask out bits 4 and 5
     // Increase the factor to make the test animation slower (and reduce to make it faster)
@@ -295,62 +760,69 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
-static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
-    uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
-    rgb_timer_buffer = sync_timer_read32();
-
-    // Update double buffer timers
-#if RGB_MATRIX_TIMEOUT > 0
-    if (rgb_anykey_timer + deltaTime <= UINT32_MAX) {
-        rgb_anykey_timer += deltaTime;
-    }
-#endif // RGB_MATRIX_TIMEOUT > 0
-
-    // Update double buffer last hit timers
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+// Effects not listed here animate over time, and are rendered every frame
+static lighting_effect_kind_t rgb_effect_kind(uint8_t effect) {
+    switch (effect) {
+        case RGB_MATRIX_NONE:
+        case RGB_MATRIX_SOLID_COLOR:
+#    ifdef ENABLE_RGB_MATRIX_ALPHAS_MODS
+        case RGB_MATRIX_ALPHAS_MODS:
+#    endif
+#    ifdef ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
+        case RGB_MATRIX_GRADIENT_UP_DOWN:
+#    endif
+#    ifdef ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+        case RGB_MATRIX_GRADIENT_LEFT_RIGHT:
+#    endif
+            return LIGHTING_EFFECT_STATIC;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
+        case RGB_MATRIX_SOLID_REACTIVE_SIMPLE:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE
+        case RGB_MATRIX_SOLID_REACTIVE:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE
+        case RGB_MATRIX_SOLID_REACTIVE_WIDE:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
+        case RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS
+        case RGB_MATRIX_SOLID_REACTIVE_CROSS:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS
+        case RGB_MATRIX_SOLID_REACTIVE_MULTICROSS:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS
+        case RGB_MATRIX_SOLID_REACTIVE_NEXUS:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
+        case RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SPLASH
+        case RGB_MATRIX_SPLASH:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_MULTISPLASH
+        case RGB_MATRIX_MULTISPLASH:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_SPLASH
+        case RGB_MATRIX_SOLID_SPLASH:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
+        case RGB_MATRIX_SOLID_MULTISPLASH:
+#        endif
+            return LIGHTING_EFFECT_KEY_REACTIVE;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+        default:
+            return LIGHTING_EFFECT_TIMED;
     }
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
+#endif // RGB_MATRIX_SKIP_UNCHANGED_FRAMES
 
-static void rgb_task_sync(void) {
-    eeconfig_flush_rgb_matrix(false);
-    // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
-}
-
-static void rgb_task_start(void) {
-    // reset iter
-    rgb_effect_params.iter = 0;
-
-    // update double buffers
-    g_rgb_timer = rgb_timer_buffer;
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    rgb_task_state = RENDERING;
-}
-
-static void rgb_task_render(uint8_t effect) {
-    bool rendering         = false;
-    rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
-    if (rgb_effect_params.flags != rgb_matrix_config.flags) {
-        rgb_effect_params.flags = rgb_matrix_config.flags;
-        rgb_matrix_set_color_all(0, 0, 0);
-    }
-
-    // each effect can opt to do calculations
-    // and/or request PWM buffer updates.
+static bool rgb_task_render_effect(uint8_t effect) {
+    bool rendering = false;
     switch (effect) {
         case RGB_MATRIX_NONE:
             rendering = rgb_matrix_none(&rgb_effect_params);
@@ -382,39 +854,71 @@ static void rgb_task_render(uint8_t effect) {
             // ---------------------------------------------
 
         // Factory default magic value
-        case UINT8_MAX: {
+        case UINT8_MAX:
             rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+            break;
     }
+    return rendering;
+}
 
-    rgb_effect_params.iter++;
-
-    // next task
-    if (!rendering) {
-        rgb_task_state = FLUSHING;
-        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
-            // We only need to flush once if we are RGB_MATRIX_NONE
-            rgb_task_state = SYNCING;
-        }
+#ifdef RGB_MATRIX_OVERLAYS
+static void rgb_task_render_started(uint8_t effect) {
+    if (effect == RGB_MATRIX_NONE) {
+        rgb_overlays_update(false);
     }
 }
+#endif // RGB_MATRIX_OVERLAYS
 
-static void rgb_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    rgb_last_effect = effect;
-    rgb_last_enable = rgb_matrix_config.enable;
-
-    // update pwm buffers
-    rgb_matrix_update_pwm_buffers();
+#if defined(RGB_MATRIX_SKIP_UNCHANGED_FRAMES) && defined(RGB_MATRIX_OUTPUT_LUT)
+// Static frames also depend on the white balance
+typedef struct {
+    uint8_t white_balance[3];
+} rgb_frame_extra_t;
 
-    // next task
-    rgb_task_state = SYNCING;
+static void rgb_frame_extra_read(rgb_frame_extra_t *extra) {
+    memcpy(extra->white_balance, rgb_white_balance, sizeof(rgb_white_balance));
 }
+#endif
+
+// Task state machine
+#define LIGHTING_TASK_STATE rgb_task_state
+#define LIGHTING_EFFECT_PARAMS rgb_effect_params
+#define LIGHTING_LAST_EFFECT rgb_last_effect
+#define LIGHTING_LAST_ENABLE rgb_last_enable
+#define LIGHTING_TIMER_BUFFER rgb_timer_buffer
+#define LIGHTING_CONFIG_ENABLE rgb_matrix_config.enable
+#define LIGHTING_CONFIG_FLAGS rgb_matrix_config.flags
+#define LIGHTING_FLUSH_LIMIT RGB_MATRIX_LED_FLUSH_LIMIT
+#define LIGHTING_PROCESS_MAX_ITERATIONS RGB_MATRIX_LED_PROCESS_MAX_ITERATIONS
+#define LIGHTING_CLEAR() rgb_matrix_set_color_all(0, 0, 0)
+#define LIGHTING_RENDER_EFFECT rgb_task_render_effect
+#define LIGHTING_UPDATE_PWM_BUFFERS rgb_matrix_update_pwm_buffers
+#define LIGHTING_INDICATORS rgb_matrix_indicators
+#define LIGHTING_INDICATORS_ADVANCED rgb_matrix_indicators_advanced
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#    define LIGHTING_LAST_HIT_BUFFER last_hit_buffer
+#endif
+#if RGB_MATRIX_TIMEOUT > 0
+#    define LIGHTING_ANYKEY_TIMER rgb_anykey_timer
+#endif
+#ifdef RGB_MATRIX_OVERLAYS
+#    define LIGHTING_FRAME_STARTED(effect) rgb_overlays_update((effect) != RGB_MATRIX_NONE)
+#    define LIGHTING_RENDER_STARTED rgb_task_render_started
+#endif
+#ifdef RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+#    define LIGHTING_SKIP_UNCHANGED_FRAMES
+#    define LIGHTING_EFFECT_KIND rgb_effect_kind
+#    define LIGHTING_CONFIG_RAW rgb_matrix_config.raw
+#    ifdef RGB_MATRIX_OUTPUT_LUT
+#        define LIGHTING_FRAME_EXTRA_T rgb_frame_extra_t
+#        define LIGHTING_FRAME_EXTRA_READ rgb_frame_extra_read
+#    endif
+#endif
+
+#include "lighting_task.inc"
 
 void rgb_matrix_task(void) {
-    rgb_task_timers();
+    lighting_task_timers();
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
@@ -426,27 +930,15 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
-    switch (rgb_task_state) {
-        case STARTING:
-            rgb_task_start();
-            break;
-        case RENDERING:
-            rgb_task_render(effect);
-            if (effect) {
-                // Only run the basic indicators in the last render iteration (default there are 5 iterations)
-                if (rgb_effect_params.iter == RGB_MATRIX_LED_PROCESS_MAX_ITERATIONS) {
-                    rgb_matrix_indicators();
-                }
-                rgb_matrix_indicators_advanced(&rgb_effect_params);
-            }
-            break;
-        case FLUSHING:
-            rgb_task_flush(effect);
-            break;
-        case SYNCING:
-            rgb_task_sync();
-            break;
-    }
+    lighting_task_step(effect);
+}
+
+uint32_t rgb_matrix_get_rendered_frames(void) {
+    return lighting_frames_rendered;
+}
+
+uint32_t rgb_matrix_get_skipped_frames(void) {
+    return lighting_frames_skipped;
 }
 
 void rgb_matrix_indicators(void) {
@@ -463,9 +955,9 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 void rgb_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
-     * Could move the invocations to rgb_task_render, but then it's missing a few checks
+     * Could move the invocations to lighting_task_render, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
-     * rgb_task_render, right before the iter++ line.
+     * lighting_task_render, right before the iter++ line.
      */
     RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
     rgb_matrix_indicators_advanced_kb(min, max);
@@ -481,6 +973,13 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    led_geometry_init();
+#ifdef RGB_MATRIX_OUTPUT_LUT
+    rgb_output_lut_update();
+#endif // RGB_MATRIX_OUTPUT_LUT
+#ifdef RGB_MATRIX_OVERLAYS
+    memset(rgb_overlay_alpha, UINT8_MAX, sizeof(rgb_overlay_alpha));
+#endif // RGB_MATRIX_OVERLAYS
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -511,8 +1010,8 @@ void rgb_matrix_init(void) {
 void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state) { // only run if turning off, and only once
-        rgb_task_render(0);        // turn off all LEDs when suspending
-        rgb_task_flush(0);         // and actually flash led state to LEDs
+        lighting_task_render(0);   // turn off all LEDs when suspending
+        lighting_task_flush(0);    // and actually flash led state to LEDs
     }
     suspend_state = state;
 #endif
@@ -131,6 +131,35 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
 
+// Frames rendered and flushed, and frames skipped as nothing they depend on has changed
+uint32_t rgb_matrix_get_rendered_frames(void);
+uint32_t rgb_matrix_get_skipped_frames(void);
+
+#ifdef RGB_MATRIX_OUTPUT_LUT
+// Scales each channel on its way to the driver, after the brightness curve
+void    rgb_matrix_set_white_balance(uint8_t red, uint8_t green, uint8_t blue);
+uint8_t rgb_matrix_get_output_level(uint8_t channel, uint8_t value);
+#endif
+
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+// Estimated current of the frame as rendered, in mA, and whether it was dimmed to stay under the limit
+uint16_t rgb_matrix_get_current_estimate(void);
+bool     rgb_matrix_is_current_limited(void);
+#endif
+
+#ifdef RGB_MATRIX_OVERLAYS
+// Overlays are drawn over the effect and indicators, by rgb_matrix_overlay_kb(), only when
+// they are switched on or off, or the layers, host LED state or modifiers change
+void rgb_matrix_set_overlay_state(uint8_t overlay, bool enabled);
+bool rgb_matrix_get_overlay_state(uint8_t overlay);
+void rgb_matrix_set_overlay_alpha(uint8_t overlay, uint8_t alpha);
+void rgb_matrix_overlays_changed(void);
+void rgb_matrix_overlay_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_overlay_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+bool rgb_matrix_overlay_kb(uint8_t overlay);
+bool rgb_matrix_overlay_user(uint8_t overlay);
+#endif
+
 // This runs after another backlight effect and replaces
 // colors already set
 void rgb_matrix_indicators(void);
@@ -147,6 +176,11 @@ void rgb_matrix_reload_from_eeprom(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
 bool        rgb_matrix_get_suspend_state(void);
+#ifdef RGB_MATRIX_SPLIT
+void     rgb_matrix_get_event_sync(rgb_matrix_event_sync_t *sync);
+void     rgb_matrix_update_event_sync(const rgb_matrix_event_sync_t *sync);
+uint32_t rgb_matrix_get_lost_split_events(void);
+#endif
 void        rgb_matrix_toggle(void);
 void        rgb_matrix_toggle_noeeprom(void);
 void        rgb_matrix_enable(void);
@@ -263,6 +297,18 @@ extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+
+// Precomputed LED geometry in flash, or NULL where it isn't available
+#ifdef RGB_MATRIX_LED_POLAR_ENABLED
+extern const led_polar_t *g_rgb_led_polar;
+#endif
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+extern const uint8_t *g_rgb_led_distance;
+#endif
+#if defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+extern const uint16_t       *g_rgb_led_neighbor_index;
+extern const led_neighbor_t *g_rgb_led_neighbors;
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
@@ -34,6 +34,11 @@
 #    define RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
+// Effects that use each LED's distance and angle from the centre point
+#if defined(ENABLE_RGB_MATRIX_CYCLE_OUT_IN) || defined(ENABLE_RGB_MATRIX_CYCLE_PINWHEEL) || defined(ENABLE_RGB_MATRIX_CYCLE_SPIRAL) || defined(ENABLE_RGB_MATRIX_BAND_PINWHEEL_SAT) || defined(ENABLE_RGB_MATRIX_BAND_PINWHEEL_VAL) || defined(ENABLE_RGB_MATRIX_BAND_SPIRAL_SAT) || defined(ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL)
+#    define RGB_MATRIX_LED_POLAR_ENABLED
+#endif
+
 // Last led hit
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
@@ -49,6 +54,27 @@ typedef struct PACKED {
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_SPLIT
+#    ifndef RGB_MATRIX_SPLIT_EVENTS
+#        define RGB_MATRIX_SPLIT_EVENTS 4
+#    endif // RGB_MATRIX_SPLIT_EVENTS
+
+// A switch event, and the effect timer when the master half recorded it
+typedef struct PACKED {
+    uint8_t  row;
+    uint8_t  col : 7;
+    uint8_t  pressed : 1;
+    uint16_t time;
+} rgb_matrix_event_t;
+
+// The most recent switch events on the master half, oldest first
+typedef struct PACKED {
+    uint8_t            sequence;
+    uint8_t            count;
+    rgb_matrix_event_t events[RGB_MATRIX_SPLIT_EVENTS];
+} rgb_matrix_event_sync_t;
+#endif // RGB_MATRIX_SPLIT
+
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
 typedef uint8_t led_flags_t;
@@ -64,6 +90,19 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+// Distance and angle of an LED from the centre point
+typedef struct PACKED {
+    uint8_t dist;
+    uint8_t angle;
+} led_polar_t;
+
+// Matrix position of an LED near another, and how far away it is
+typedef struct PACKED {
+    uint8_t row;
+    uint8_t col;
+    uint8_t dist;
+} led_neighbor_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -24,8 +24,8 @@
 #include "util.h"
 #include "led_tables.h"
 #include <lib/lib8tion/lib8tion.h>
-#ifdef EEPROM_ENABLE
-#    include "eeprom.h"
+#ifdef RGBLIGHT_CURRENT_LIMIT
+#    include "lighting_power.h"
 #endif
 #ifdef VELOCIKEY_ENABLE
 #    include "velocikey.h"
@@ -89,6 +89,10 @@ static uint8_t mode_base_table[] = {
 #    define RGBLIGHT_DEFAULT_SPD 0
 #endif
 
+#if !defined(RGBLIGHT_CHANNEL_CURRENT)
+#    define RGBLIGHT_CHANNEL_CURRENT 20
+#endif
+
 static inline int is_static_effect(uint8_t mode) {
     return memchr(static_effect_table, mode, sizeof(static_effect_table)) != NULL;
 }
@@ -179,7 +183,7 @@ void rgblight_check_config(void) {
 
 uint64_t eeconfig_read_rgblight(void) {
 #ifdef EEPROM_ENABLE
-    return (uint64_t)((eeprom_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeprom_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
+    return (uint64_t)((eeconfig_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeconfig_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
 #else
     return 0;
 #endif
@@ -188,8 +192,8 @@ uint64_t eeconfig_read_rgblight(void) {
 void eeconfig_update_rgblight(uint64_t val) {
 #ifdef EEPROM_ENABLE
     rgblight_check_config();
-    eeprom_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
+    eeconfig_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
 #endif
 }
 
@@ -763,8 +767,8 @@ bool rgblight_get_layer_state(uint8_t layer) {
     return (rgblight_status.enabled_layer_mask & mask) != 0;
 }
 
-// Write any enabled LED layers into the buffer
-static void rgblight_layers_write(void) {
+// Write any enabled LED layers into the buffer, marking the LEDs they cover in mask if there is one
+static void rgblight_layers_render(LED_TYPE *buffer, uint8_t *mask) {
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
     uint8_t current_val = rgblight_get_val();
 #    endif
@@ -786,19 +790,62 @@ static void rgblight_layers_write(void) {
                 break; // No more segments
             }
             // Write segment.count LEDs
-            LED_TYPE *const limit = &led[MIN(segment.index + segment.count, RGBLED_NUM)];
-            for (LED_TYPE *led_ptr = &led[segment.index]; led_ptr < limit; led_ptr++) {
+            uint8_t limit = MIN(segment.index + segment.count, RGBLED_NUM);
+            for (uint8_t j = segment.index; j < limit; j++) {
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
-                sethsv(segment.hue, segment.sat, current_val, led_ptr);
+                sethsv(segment.hue, segment.sat, current_val, &buffer[j]);
 #    else
-                sethsv(segment.hue, segment.sat, segment.val, led_ptr);
+                sethsv(segment.hue, segment.sat, segment.val, &buffer[j]);
 #    endif
+                if (mask != NULL) {
+                    mask[j / 8] |= 1 << (j % 8);
+                }
             }
             segment_ptr++;
         }
     }
 }
 
+#    ifdef RGBLIGHT_LAYERS_CACHE
+// The enabled layers rendered on their own, so that they are only converted from HSV when they change
+static LED_TYPE                          layers_cache[RGBLED_NUM];
+static uint8_t                           layers_cache_mask[(RGBLED_NUM + 7) / 8];
+static bool                              layers_cache_valid = false;
+static rgblight_layer_mask_t             layers_cache_state;
+static const rgblight_segment_t *const *layers_cache_layers;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+static uint8_t layers_cache_val;
+#        endif
+
+static void rgblight_layers_write(void) {
+    bool stale = !layers_cache_valid || layers_cache_state != rgblight_status.enabled_layer_mask || layers_cache_layers != rgblight_layers;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+    stale |= layers_cache_val != rgblight_get_val();
+    layers_cache_val = rgblight_get_val();
+#        endif
+    if (stale) {
+        layers_cache_valid  = true;
+        layers_cache_state  = rgblight_status.enabled_layer_mask;
+        layers_cache_layers = rgblight_layers;
+        memset(layers_cache_mask, 0, sizeof(layers_cache_mask));
+        rgblight_layers_render(layers_cache, layers_cache_mask);
+    }
+
+    for (uint8_t i = 0; i < sizeof(layers_cache_mask); i++) {
+        uint8_t bits = layers_cache_mask[i];
+        for (uint8_t j = i * 8; bits; j++, bits >>= 1) {
+            if (bits & 1) {
+                led[j] = layers_cache[j];
+            }
+        }
+    }
+}
+#    else
+static void rgblight_layers_write(void) {
+    rgblight_layers_render(led, NULL);
+}
+#    endif
+
 #    ifdef RGBLIGHT_LAYER_BLINK
 rgblight_layer_mask_t _blinking_layer_mask = 0;
 static uint16_t       _repeat_timer;
@@ -903,6 +950,19 @@ __attribute__((weak)) void rgblight_call_driver(LED_TYPE *start_led, uint8_t num
 
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 
+#    ifdef RGBLIGHT_CURRENT_LIMIT
+static uint16_t current_estimate = 0;
+static bool     current_limited  = false;
+
+uint16_t rgblight_get_current_estimate(void) {
+    return current_estimate;
+}
+
+bool rgblight_is_current_limited(void) {
+    return current_limited;
+}
+#    endif
+
 void rgblight_set(void) {
     LED_TYPE *start_led;
     uint8_t   num_leds = rgblight_ranges.clipping_num_leds;
@@ -940,6 +1000,26 @@ void rgblight_set(void) {
     start_led = led + rgblight_ranges.clipping_start_pos;
 #    endif
 
+#    ifdef RGBLIGHT_CURRENT_LIMIT
+    // Send a dimmed copy of the frame when it would draw too much, leaving led[] as the effects left it.
+    // Static, as a whole strip's worth is too much to put on the stack of small MCUs.
+    static LED_TYPE limited_led[RGBLED_NUM];
+    uint32_t level = 0;
+    for (uint8_t i = 0; i < num_leds; i++) {
+        level += start_led[i].r + start_led[i].g + start_led[i].b;
+    }
+    current_estimate = MIN(lighting_power_estimate(level, RGBLIGHT_CHANNEL_CURRENT), UINT16_MAX);
+
+    uint16_t scale  = lighting_power_scale(level, RGBLIGHT_CHANNEL_CURRENT, RGBLIGHT_CURRENT_LIMIT);
+    current_limited = scale < 256;
+    if (current_limited) {
+        for (uint8_t i = 0; i < num_leds; i++) {
+            setrgb(start_led[i].r * scale >> 8, start_led[i].g * scale >> 8, start_led[i].b * scale >> 8, &limited_led[i]);
+        }
+        start_led = limited_led;
+    }
+#    endif
+
 #    ifdef RGBW
     for (uint8_t i = 0; i < num_leds; i++) {
         convert_rgb_to_rgbw(&start_led[i]);
@@ -1224,13 +1304,36 @@ void rgblight_effect_rainbow_mood(animation_status_t *anim) {
 
 __attribute__((weak)) const uint8_t RGBLED_RAINBOW_SWIRL_INTERVALS[] PROGMEM = {100, 50, 20};
 
+#    ifdef RGBLIGHT_EFFECTS_CACHE
+// Every hue at the current saturation and brightness, converted the first time it is shown
+static LED_TYPE swirl_cache[256];
+static uint8_t  swirl_cache_filled[256 / 8];
+static uint8_t  swirl_cache_sat;
+static uint8_t  swirl_cache_val;
+#    endif
+
 void rgblight_effect_rainbow_swirl(animation_status_t *anim) {
     uint8_t hue;
     uint8_t i;
 
+#    ifdef RGBLIGHT_EFFECTS_CACHE
+    if (swirl_cache_sat != rgblight_config.sat || swirl_cache_val != rgblight_config.val) {
+        swirl_cache_sat = rgblight_config.sat;
+        swirl_cache_val = rgblight_config.val;
+        memset(swirl_cache_filled, 0, sizeof(swirl_cache_filled));
+    }
+#    endif
     for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
         hue = (RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds * i + anim->current_hue);
+#    ifdef RGBLIGHT_EFFECTS_CACHE
+        if (!(swirl_cache_filled[hue / 8] & (1 << (hue % 8)))) {
+            swirl_cache_filled[hue / 8] |= 1 << (hue % 8);
+            sethsv(hue, rgblight_config.sat, rgblight_config.val, &swirl_cache[hue]);
+        }
+        led[i + rgblight_ranges.effect_start_pos] = swirl_cache[hue];
+#    else
         sethsv(hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[i + rgblight_ranges.effect_start_pos]);
+#    endif
     }
     rgblight_set();
 
@@ -1248,7 +1351,7 @@ __attribute__((weak)) const uint8_t RGBLED_SNAKE_INTERVALS[] PROGMEM = {100, 50,
 void rgblight_effect_snake(animation_status_t *anim) {
     static uint8_t pos = 0;
     uint8_t        i, j;
-    int8_t         k;
+    int16_t        k;
     int8_t         increment = 1;
 
     if (anim->delta % 2) {
@@ -1274,17 +1377,18 @@ void rgblight_effect_snake(animation_status_t *anim) {
 #    ifdef RGBW
         ledp->w = 0;
 #    endif
-        for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
-            k = pos + j * increment;
-            if (k > RGBLED_NUM) {
-                k = k % (RGBLED_NUM);
-            }
-            if (k < 0) {
-                k = k + rgblight_ranges.effect_num_leds;
-            }
-            if (i == k) {
-                sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val * (RGBLIGHT_EFFECT_SNAKE_LENGTH - j) / RGBLIGHT_EFFECT_SNAKE_LENGTH), ledp);
-            }
+    }
+    // Only the snake's own LEDs need lighting, with later (dimmer) segments winning where they overlap
+    for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
+        k = pos + j * increment;
+        if (k > RGBLED_NUM) {
+            k = k % (RGBLED_NUM);
+        }
+        if (k < 0) {
+            k = k + rgblight_ranges.effect_num_leds;
+        }
+        if (k < rgblight_ranges.effect_num_leds) {
+            sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val * (RGBLIGHT_EFFECT_SNAKE_LENGTH - j) / RGBLIGHT_EFFECT_SNAKE_LENGTH), led + k + rgblight_ranges.effect_start_pos);
         }
     }
     rgblight_set();
@@ -1317,6 +1421,7 @@ void rgblight_effect_knight(animation_status_t *anim) {
     static int8_t high_bound = RGBLIGHT_EFFECT_KNIGHT_LENGTH - 1;
     static int8_t increment  = RGBLIGHT_EFFECT_KNIGHT_INCREMENT;
     uint8_t       i, cur;
+    LED_TYPE      lit;
 
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
     if (anim->pos == 0) { // restart signal
@@ -1335,12 +1440,13 @@ void rgblight_effect_knight(animation_status_t *anim) {
         led[i].w = 0;
 #    endif
     }
-    // Determine which LEDs should be lit up
+    // Determine which LEDs should be lit up, all of them in the same color
+    sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, &lit);
     for (i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++) {
         cur = (i + RGBLIGHT_EFFECT_KNIGHT_OFFSET) % rgblight_ranges.effect_num_leds + rgblight_ranges.effect_start_pos;
 
         if (i >= low_bound && i <= high_bound) {
-            sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[cur]);
+            led[cur] = lit;
         } else {
             led[cur].r = 0;
             led[cur].g = 0;
@@ -1460,6 +1566,11 @@ typedef struct PACKED {
     HSV     hsv;
     uint8_t life;
     uint8_t max_life;
+#    ifdef RGBLIGHT_EFFECTS_CACHE
+    // Most LEDs are off or fading slowly, so they keep their color from one tick to the next
+    HSV      shown_hsv;
+    LED_TYPE shown;
+#    endif
 } TwinkleState;
 
 static TwinkleState led_twinkle_state[RGBLED_NUM];
@@ -1513,7 +1624,15 @@ void rgblight_effect_twinkle(animation_status_t *anim) {
         }
 
         LED_TYPE *ledp = led + i + rgblight_ranges.effect_start_pos;
+#    ifdef RGBLIGHT_EFFECTS_CACHE
+        if (restart || c->h != t->shown_hsv.h || c->s != t->shown_hsv.s || c->v != t->shown_hsv.v) {
+            t->shown_hsv = *c;
+            sethsv(c->h, c->s, c->v, &t->shown);
+        }
+        *ledp = t->shown;
+#    else
         sethsv(c->h, c->s, c->v, ledp);
+#    endif
     }
 
     rgblight_set();
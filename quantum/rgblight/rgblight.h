@@ -290,6 +290,11 @@ void setrgb(uint8_t r, uint8_t g, uint8_t b, LED_TYPE *led1);
 /* === Low level Functions === */
 void rgblight_set(void);
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
+#ifdef RGBLIGHT_CURRENT_LIMIT
+// Estimated current of the last frame sent, in mA, and whether it was dimmed to stay under the limit
+uint16_t rgblight_get_current_estimate(void);
+bool     rgblight_is_current_limited(void);
+#endif
 
 /* === Effects and Animations Functions === */
 /*   effect range setting */
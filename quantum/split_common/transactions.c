@@ -562,9 +562,31 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     rgb_matrix_set_suspend_state(rgb_suspend_state);
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+static bool rgb_matrix_events_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t         last_update = 0;
+    rgb_matrix_event_sync_t rgb_matrix_event_sync;
+    rgb_matrix_get_event_sync(&rgb_matrix_event_sync);
+    return send_if_data_mismatch(PUT_RGB_MATRIX_EVENTS, &last_update, &rgb_matrix_event_sync, &split_shmem->rgb_matrix_event_sync, sizeof(rgb_matrix_event_sync));
+}
+
+static void rgb_matrix_events_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_shared_memory_lock();
+    rgb_matrix_event_sync_t rgb_matrix_event_sync;
+    memcpy(&rgb_matrix_event_sync, &split_shmem->rgb_matrix_event_sync, sizeof(rgb_matrix_event_sync_t));
+    split_shared_memory_unlock();
+
+    rgb_matrix_update_event_sync(&rgb_matrix_event_sync);
+}
+
+#    define TRANSACTIONS_RGB_MATRIX_MASTER()    \
+        TRANSACTION_HANDLER_MASTER(rgb_matrix); \
+        TRANSACTION_HANDLER_MASTER(rgb_matrix_events)
+#    define TRANSACTIONS_RGB_MATRIX_SLAVE()    \
+        TRANSACTION_HANDLER_SLAVE(rgb_matrix); \
+        TRANSACTION_HANDLER_SLAVE(rgb_matrix_events)
+#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS                                      \
+        [PUT_RGB_MATRIX]        = trans_initiator2target_initializer(rgb_matrix_sync), \
+        [PUT_RGB_MATRIX_EVENTS] = trans_initiator2target_initializer(rgb_matrix_event_sync),
 
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -190,7 +190,8 @@ typedef struct _split_shared_memory_t {
 #endif // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
-    rgb_matrix_sync_t rgb_matrix_sync;
+    rgb_matrix_sync_t       rgb_matrix_sync;
+    rgb_matrix_event_sync_t rgb_matrix_event_sync;
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -22,6 +22,8 @@
 #    error "DYNAMIC_KEYMAP_ENABLE is not enabled"
 #endif
 
+#include <string.h>
+
 #include "via.h"
 
 #include "raw_hid.h"
@@ -31,6 +33,7 @@
 #include "matrix.h"
 #include "timer.h"
 #include "wait.h"
+#include "util.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 
 #if defined(AUDIO_ENABLE)
@@ -276,6 +279,121 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+// Streamed keymap transfers move an arbitrary range of the dynamic keymap
+// in back-to-back reports, rather than one request/response per report.
+//
+// Both directions start with a header report:
+//      [command_id, offset_hi, offset_lo, size_hi, size_lo]
+// followed by the data reports, each carrying (length - 2) bytes of payload:
+//      [id_dynamic_keymap_stream_data, sequence, payload...]
+// and end with a trailer report:
+//      [command_id, offset_hi, offset_lo, size_hi, size_lo, status, crc_hi, crc_lo]
+// where the CRC is CRC-16/CCITT-FALSE over the transferred keymap bytes.
+//
+// For reads, the firmware sends all data reports and the trailer in response
+// to the header. For writes, the firmware acknowledges the header, the host
+// sends all data reports without waiting, and the firmware sends the trailer
+// after the last one. Any other command aborts an in-progress write.
+static struct {
+    bool     active;
+    uint16_t offset;
+    uint16_t size;
+    uint16_t position;
+    uint16_t crc;
+    uint8_t  sequence;
+} via_stream;
+
+static uint16_t via_stream_crc16(uint16_t crc, const uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool via_stream_range_valid(uint16_t offset, uint16_t size) {
+    uint32_t dynamic_keymap_size = (uint32_t)dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+    return size > 0 && (uint32_t)offset + size <= dynamic_keymap_size;
+}
+
+static void via_stream_set_trailer(uint8_t *data, uint8_t length, uint8_t command_id, uint8_t status) {
+    memset(data, 0, length);
+    data[0] = command_id;
+    data[1] = via_stream.offset >> 8;
+    data[2] = via_stream.offset & 0xFF;
+    data[3] = via_stream.size >> 8;
+    data[4] = via_stream.size & 0xFF;
+    data[5] = status;
+    data[6] = via_stream.crc >> 8;
+    data[7] = via_stream.crc & 0xFF;
+}
+
+static void via_stream_get_buffer(uint8_t *data, uint8_t length) {
+    via_stream.offset = (data[1] << 8) | data[2];
+    via_stream.size   = (data[3] << 8) | data[4];
+    via_stream.crc    = 0xFFFF;
+
+    if (!via_stream_range_valid(via_stream.offset, via_stream.size)) {
+        via_stream_set_trailer(data, length, id_dynamic_keymap_get_buffer_stream, id_stream_invalid_range);
+        return;
+    }
+
+    uint8_t sequence = 0;
+    for (uint16_t position = 0; position < via_stream.size;) {
+        uint16_t chunk = MIN(length - 2, via_stream.size - position);
+        memset(data, 0, length);
+        data[0] = id_dynamic_keymap_stream_data;
+        data[1] = sequence++;
+        dynamic_keymap_get_buffer(via_stream.offset + position, chunk, &data[2]);
+        via_stream.crc = via_stream_crc16(via_stream.crc, &data[2], chunk);
+        raw_hid_send(data, length);
+        position += chunk;
+    }
+
+    via_stream_set_trailer(data, length, id_dynamic_keymap_get_buffer_stream, id_stream_ok);
+}
+
+static void via_stream_set_buffer_begin(uint8_t *data) {
+    via_stream.offset   = (data[1] << 8) | data[2];
+    via_stream.size     = (data[3] << 8) | data[4];
+    via_stream.position = 0;
+    via_stream.sequence = 0;
+    via_stream.crc      = 0xFFFF;
+    via_stream.active   = via_stream_range_valid(via_stream.offset, via_stream.size);
+    data[5]             = via_stream.active ? id_stream_ok : id_stream_invalid_range;
+}
+
+// Returns true if a report should be sent back to the host.
+static bool via_stream_set_buffer_data(uint8_t *data, uint8_t length) {
+    // Data arriving after a write was aborted is dropped, so the host sees a
+    // single trailer with the failure status
+    if (!via_stream.active) {
+        return false;
+    }
+
+    if (data[1] != via_stream.sequence) {
+        via_stream.active = false;
+        via_stream_set_trailer(data, length, id_dynamic_keymap_set_buffer_stream, id_stream_bad_sequence);
+        return true;
+    }
+
+    uint16_t chunk = MIN(length - 2, via_stream.size - via_stream.position);
+    dynamic_keymap_set_buffer(via_stream.offset + via_stream.position, chunk, &data[2]);
+    via_stream.crc = via_stream_crc16(via_stream.crc, &data[2], chunk);
+    via_stream.position += chunk;
+    via_stream.sequence++;
+
+    if (via_stream.position < via_stream.size) {
+        return false;
+    }
+
+    via_stream.active = false;
+    via_stream_set_trailer(data, length, id_dynamic_keymap_set_buffer_stream, id_stream_ok);
+    return true;
+}
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
@@ -286,6 +404,15 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         return;
     }
 
+    // Data reports of a streamed write are only acknowledged once the write completes
+    if (*command_id == id_dynamic_keymap_stream_data) {
+        if (via_stream_set_buffer_data(data, length)) {
+            raw_hid_send(data, length);
+        }
+        return;
+    }
+    via_stream.active = false;
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
@@ -436,6 +563,14 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+        case id_dynamic_keymap_get_buffer_stream: {
+            via_stream_get_buffer(data, length);
+            break;
+        }
+        case id_dynamic_keymap_set_buffer_stream: {
+            via_stream_set_buffer_begin(data);
+            break;
+        }
 #ifdef ENCODER_MAP_ENABLE
         case id_dynamic_keymap_get_encoder: {
             uint16_t keycode = dynamic_keymap_get_encoder(command_data[0], command_data[1], command_data[2] != 0);
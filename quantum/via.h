@@ -93,6 +93,9 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_dynamic_keymap_get_buffer_stream     = 0x16,
+    id_dynamic_keymap_set_buffer_stream     = 0x17,
+    id_dynamic_keymap_stream_data           = 0x18,
     id_unhandled                            = 0xFF,
 };
 
@@ -104,6 +107,13 @@ enum via_keyboard_value_id {
     id_device_indication   = 0x05,
 };
 
+// Status returned in the final report of a streamed keymap transfer.
+enum via_stream_status {
+    id_stream_ok            = 0x00,
+    id_stream_invalid_range = 0x01,
+    id_stream_bad_sequence  = 0x02,
+};
+
 enum via_channel_id {
     id_custom_channel         = 0,
     id_qmk_backlight_channel  = 1,
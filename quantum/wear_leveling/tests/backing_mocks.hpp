@@ -87,6 +87,8 @@ class MockBackingStore {
     std::uint64_t backing_max_write_count;
     // The total number of writes to all elements of the backing store
     std::uint64_t backing_total_write_count;
+    // The largest range erased by a single call to erase_range()
+    std::size_t backing_max_erase_range_length;
     // The write log for the backing store
     std::vector<MockBackingStoreLogEntry> write_log;
 
@@ -96,6 +98,8 @@ class MockBackingStore {
     std::uint64_t backing_erase_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    std::uint64_t backing_read_invoke_count;
+    std::uint64_t backing_erase_range_invoke_count;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
@@ -127,6 +131,9 @@ class MockBackingStore {
     std::uint64_t max_write_count() const {
         return backing_max_write_count;
     }
+    std::size_t max_erase_range_length() const {
+        return backing_max_erase_range_length;
+    }
     std::uint64_t total_write_count() const {
         return backing_total_write_count;
     }
@@ -147,6 +154,12 @@ class MockBackingStore {
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t read_invoke_count() const {
+        return backing_read_invoke_count;
+    }
+    std::uint64_t erase_range_invoke_count() const {
+        return backing_erase_range_invoke_count;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
@@ -159,9 +172,11 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_range(std::uint32_t address, std::size_t length);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
-    bool read(std::uint32_t address, backing_store_int_t& value) const;
+    bool read(std::uint32_t address, backing_store_int_t& value);
+    bool read_bulk(std::uint32_t address, backing_store_int_t* values, std::size_t item_count);
 
     // Control over when init/writes/erases should succeed
     void set_init_callback(std::function<bool(std::uint64_t)> callback) {
@@ -63,4 +63,19 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+
+wear_leveling_dual_bank_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=512 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=128 \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DWEAR_LEVELING_PLAYBACK_CHUNK_SIZE=32 \
+	-DWEAR_LEVELING_CONSOLIDATION_HEADROOM=64 \
+	-DWEAR_LEVELING_CONSOLIDATION_ERASE_SIZE=64
+wear_leveling_dual_bank_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_dual_bank.cpp
+wear_leveling_dual_bank_INC := \
+	$(wear_leveling_common_INC)
@@ -0,0 +1,208 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingDualBank : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+};
+
+std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> WearLevelingDualBank::verify_data;
+
+/**
+ * Number of erase_range() calls needed to erase a whole bank.
+ */
+static constexpr std::uint64_t ERASE_STEPS_PER_BANK = WEAR_LEVELING_BANK_SIZE / WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE;
+static_assert(ERASE_STEPS_PER_BANK > 1, "Tests require the idle bank to be erased over several steps");
+
+/**
+ * Number of backing store operations which may stall the caller.
+ */
+static std::uint64_t backing_operations(void) {
+    auto& inst = MockBackingStore::Instance();
+    return inst.write_invoke_count() + inst.erase_invoke_count() + inst.erase_range_invoke_count();
+}
+
+/**
+ * Writes a value, returning the number of backing store operations the write required.
+ */
+static std::uint64_t timed_write(std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>& verify, const uint32_t address, const void* value, size_t length, wear_leveling_status_t* status = nullptr) {
+    memcpy(&verify[address], value, length);
+    std::uint64_t          before = backing_operations();
+    wear_leveling_status_t ret    = wear_leveling_write(address, value, length);
+    EXPECT_NE(ret, WEAR_LEVELING_FAILED) << "Write failed";
+    if (status) {
+        *status = ret;
+    }
+    return backing_operations() - before;
+}
+
+static void verify_readback(const std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>& verify) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_TRUE(memcmp(readback.data(), verify.data(), readback.size()) == 0) << "Readback did not match";
+}
+
+/**
+ * This test verifies that the first write after initialisation occurs after the FNV1a_64 hash and bank generation.
+ */
+TEST_F(WearLevelingDualBank, FirstWriteOccursAfterGeneration) {
+    auto&   inst       = MockBackingStore::Instance();
+    uint8_t test_value = 0x15;
+    timed_write(verify_data, 0x02, &test_value, sizeof(test_value));
+    EXPECT_EQ(inst.log_begin()->address, WEAR_LEVELING_LOGICAL_SIZE + 16) << "Invalid first write address.";
+}
+
+/**
+ * This test verifies that when the housekeeping task keeps up, no write ever erases the backing store, and the number of
+ * backing store operations per write stays bounded by the size of a single mirrored log entry.
+ */
+TEST_F(WearLevelingDualBank, WorstCaseWriteLatency_Bounded) {
+    auto&         inst      = MockBackingStore::Instance();
+    std::uint64_t worst     = 0;
+    std::uint64_t committed = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+        uint32_t address = (i * 7) % (WEAR_LEVELING_LOGICAL_SIZE - 2);
+        uint8_t  value[] = {(uint8_t)i, (uint8_t)(i >> 3)};
+        worst            = std::max(worst, timed_write(verify_data, address, value, sizeof(value)));
+
+        if (wear_leveling_task() == WEAR_LEVELING_CONSOLIDATED) {
+            ++committed;
+        }
+    }
+
+    EXPECT_GT(committed, 0) << "Background consolidation should have completed at least once";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Full erase should never have been required";
+    EXPECT_LE(worst, 2 * (8 / BACKING_STORE_WRITE_SIZE)) << "Worst-case write should be no more than a mirrored log entry";
+
+    verify_readback(verify_data);
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    verify_readback(verify_data);
+}
+
+/**
+ * This test verifies that background consolidation erases the idle bank one erase unit per housekeeping step, so no
+ * single step stalls for the duration of a whole-bank erase, and that the erase resumes where it left off.
+ */
+TEST_F(WearLevelingDualBank, ConsolidationErase_OneUnitPerStep) {
+    auto&         inst      = MockBackingStore::Instance();
+    std::uint64_t committed = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+        uint8_t value[] = {(uint8_t)i, (uint8_t)(i >> 2)};
+        timed_write(verify_data, (i * 3) % (WEAR_LEVELING_LOGICAL_SIZE - 2), value, sizeof(value));
+
+        std::uint64_t erases_before = inst.erase_range_invoke_count();
+        if (wear_leveling_task() == WEAR_LEVELING_CONSOLIDATED) {
+            ++committed;
+        }
+        EXPECT_LE(inst.erase_range_invoke_count() - erases_before, 1) << "A single step should erase at most one unit";
+    }
+
+    EXPECT_GT(committed, 0) << "Background consolidation should have completed at least once";
+    EXPECT_EQ(inst.max_erase_range_length(), WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE) << "Each erase should cover exactly one unit";
+    EXPECT_GE(inst.erase_range_invoke_count(), committed * ERASE_STEPS_PER_BANK) << "Every erase unit of the bank should have been erased";
+
+    verify_readback(verify_data);
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    verify_readback(verify_data);
+}
+
+/**
+ * This test verifies that if the housekeeping task never runs, the write which fills the log completes consolidation
+ * in-line, and the write itself is retained.
+ */
+TEST_F(WearLevelingDualBank, LogFull_ConsolidatesInline) {
+    auto&                  inst   = MockBackingStore::Instance();
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+
+    int i;
+    for (i = 0; i < 1000 && status != WEAR_LEVELING_CONSOLIDATED; ++i) {
+        uint8_t value[] = {(uint8_t)(i + 1), (uint8_t)(i + 2), (uint8_t)(i + 3)};
+        timed_write(verify_data, WEAR_LEVELING_LOGICAL_SIZE - sizeof(value), value, sizeof(value), &status);
+    }
+
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write should have consolidated in-line";
+    EXPECT_EQ(inst.erase_range_invoke_count(), ERASE_STEPS_PER_BANK) << "Idle bank should have been erased once";
+    verify_readback(verify_data);
+
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    verify_readback(verify_data);
+}
+
+/**
+ * This test verifies that losing power part-way through background consolidation falls back to the previous bank, and
+ * that writes made during the copy are not lost once consolidation completes.
+ */
+TEST_F(WearLevelingDualBank, InterruptedConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Fill the log until background consolidation has erased the idle bank
+    int i = 0;
+    while (inst.erase_range_invoke_count() < ERASE_STEPS_PER_BANK) {
+        uint8_t value = (uint8_t)(0x40 + i);
+        timed_write(verify_data, (i * 5) % WEAR_LEVELING_LOGICAL_SIZE, &value, sizeof(value));
+        wear_leveling_task();
+        ++i;
+    }
+
+    // Erase completed, copy one chunk, then write to an area that was already copied
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Copy should not have completed";
+    uint8_t value = 0xA5;
+    timed_write(verify_data, 0, &value, sizeof(value));
+
+    // "Power loss" -- the new bank has not been committed, so the old one is used
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    verify_readback(verify_data);
+
+    // Run consolidation through to completion this time, writing to an already-copied area part-way through
+    while (inst.erase_range_invoke_count() < 2 * ERASE_STEPS_PER_BANK) {
+        timed_write(verify_data, 1, &i, 1);
+        wear_leveling_task();
+        ++i;
+    }
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Copy should not have completed";
+    value = 0x5A;
+    timed_write(verify_data, 0, &value, sizeof(value));
+    while (wear_leveling_task() != WEAR_LEVELING_CONSOLIDATED) {
+    }
+
+    verify_readback(verify_data);
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    verify_readback(verify_data);
+}
+
+/**
+ * This test verifies the number of backing store operations required to boot, regardless of how full the write log is.
+ */
+TEST_F(WearLevelingDualBank, Boot_BackingStoreOperations) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Cycle through both banks a few times
+    for (int i = 0; i < 500; ++i) {
+        uint8_t value[] = {(uint8_t)i, (uint8_t)(i * 3), (uint8_t)(i * 5), (uint8_t)(i * 7)};
+        timed_write(verify_data, (i * 11) % (WEAR_LEVELING_LOGICAL_SIZE - 4), value, sizeof(value));
+        wear_leveling_task();
+    }
+    EXPECT_GT(inst.erase_range_invoke_count(), 2 * ERASE_STEPS_PER_BANK) << "Both banks should have been used";
+
+    uint64_t read_count  = inst.read_invoke_count();
+    uint64_t operations = backing_operations();
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+
+    // Two generations, consolidated data, checksum, then the write log in chunks
+    const uint64_t log_chunks = ((WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_OFFSET) + WEAR_LEVELING_PLAYBACK_CHUNK_SIZE - 1) / WEAR_LEVELING_PLAYBACK_CHUNK_SIZE;
+    EXPECT_LE(inst.read_invoke_count() - read_count, 4 + log_chunks) << "Boot should have read the write log in bulk";
+    EXPECT_EQ(backing_operations(), operations) << "Boot should not have written to or erased the backing store";
+    verify_readback(verify_data);
+}
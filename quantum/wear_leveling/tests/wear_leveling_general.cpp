@@ -202,3 +202,32 @@ TEST_F(WearLevelingGeneral, WriteFailure_NoSubsequentWrites) {
     wear_leveling_read(0x04, &test_val, sizeof(test_val));
     EXPECT_EQ(test_val, 0x14) << "Readback should come from cache regardless of unlock failure";
 }
+
+/**
+ * This test verifies that playback of the write log on boot reads the backing store in bulk, rather than one item at a time.
+ */
+TEST_F(WearLevelingGeneral, Playback_BulkReads) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Fill most of the write log without triggering consolidation
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue{};
+    for (uint8_t i = 0; i < 8; ++i) {
+        testvalue[i] = 0x30 + i;
+        EXPECT_EQ(wear_leveling_write(i, &testvalue[i], sizeof(testvalue[i])), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Re-init, counting the number of backing store operations required to boot
+    uint64_t read_count  = inst.read_invoke_count();
+    uint64_t write_count = inst.write_invoke_count();
+    uint64_t erase_count = inst.erase_invoke_count();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+
+    // Consolidated data, checksum, then the entire write log in a single chunk
+    EXPECT_EQ(inst.read_invoke_count() - read_count, 3) << "Boot should have read the write log in bulk";
+    EXPECT_EQ(inst.write_invoke_count(), write_count) << "Boot should not have written to the backing store";
+    EXPECT_EQ(inst.erase_invoke_count(), erase_count) << "Boot should not have erased the backing store";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_TRUE(memcmp(readback.data(), testvalue.data(), readback.size()) == 0) << "Readback did not match";
+}
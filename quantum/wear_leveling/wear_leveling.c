@@ -61,6 +61,12 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_PLAYBACK_CHUNK_SIZE: The number of bytes of the write
+            log fetched with a single bulk read during playback.
+
+        - WEAR_LEVELING_DUAL_BANK: Splits the backing store into two banks and
+            performs consolidation incrementally in the background. See below.
+
     General algorithm:
 
         During initialization:
@@ -153,15 +159,52 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Dual-bank consolidation:
+
+        With WEAR_LEVELING_DUAL_BANK defined, the backing store is split into
+        two equally-sized banks, each laid out as described above with an
+        additional 8-byte generation counter following the FNV1a_64 hash:
+
+        ╔ Bank ═══════════════════════════════════════════════════╗
+        ║ Consolidated data │ FNV1a_64 │ Generation │ Write log... ║
+        ╚═════════════════════════════════════════════════════════╝
+
+        The bank with the highest generation and a valid checksum is active.
+        Once the active write log has less than
+        WEAR_LEVELING_CONSOLIDATION_HEADROOM bytes remaining, each call to
+        wear_leveling_task() performs one step of consolidation into the idle
+        bank -- erasing WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE bytes of it,
+        copying WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE bytes of the cache, then
+        writing the checksum and finally the generation.
+        Log entries appended while the copy is in progress are written to both
+        banks, so that whichever bank is used on the next boot is complete.
+        Only if the active write log fills up before the background copy has
+        finished does the remaining work occur in-line with a write.
+
+        Backing stores used in this mode must implement
+        backing_store_erase_range(). */
 
 /**
  * Storage area for the wear-leveling cache.
  */
 static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
+    uint32_t                                                       bank_address;
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_DUAL_BANK
+    uint64_t generation;
+    struct {
+        uint8_t  state;
+        uint32_t bank_address;
+        uint32_t write_address;
+        uint32_t offset;
+        uint64_t hash;
+        bool     forced;
+    } consolidation;
+#endif // WEAR_LEVELING_DUAL_BANK
 } wear_leveling;
 
 /**
@@ -202,38 +245,61 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = wear_leveling.bank_address + (WEAR_LEVELING_LOG_OFFSET);
+}
+
+/**
+ * Reads an 8-byte value, such as the FNV1a_64 checksum, from the backing store.
+ */
+static bool wear_leveling_read_u64(uint32_t address, uint64_t *value) {
+    write_log_entry_t entry;
+    if (!backing_store_read_bulk(address, (backing_store_int_t *)entry.raw8, sizeof(entry) / sizeof(backing_store_int_t))) {
+        return false;
+    }
+    *value = entry.raw64;
+    return true;
 }
 
 /**
- * Reads the consolidated data from the backing store into the cache.
+ * Writes an 8-byte value, such as the FNV1a_64 checksum, to the backing store.
+ */
+static bool wear_leveling_write_u64(uint32_t address, uint64_t value) {
+    write_log_entry_t entry = {.raw64 = value};
+    return backing_store_write_bulk(address, (backing_store_int_t *)entry.raw8, sizeof(entry) / sizeof(backing_store_int_t));
+}
+
+/**
+ * Reads the consolidated data from the supplied bank of the backing store into the cache.
  * Does not consider the write log.
+ *
+ * @param checksum_ok[out] whether the checksum of the consolidated data matched, may be NULL
  */
-static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+static wear_leveling_status_t wear_leveling_read_consolidated(uint32_t bank_address, bool *checksum_ok) {
     wl_dprintf("Reading consolidated data\n");
 
+    if (checksum_ok) {
+        *checksum_ok = false;
+    }
+
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_read_bulk(bank_address, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
 
     // Verify the FNV1a_64 result
     if (status != WEAR_LEVELING_FAILED) {
-        uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        write_log_entry_t entry;
+        uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        uint64_t actual   = 0;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_u64(bank_address + (WEAR_LEVELING_LOGICAL_SIZE), &actual);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
-        if (entry.raw64 == expected) {
+        if (actual == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
+            if (checksum_ok) {
+                *checksum_ok = true;
+            }
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
             wear_leveling_clear_cache();
@@ -248,6 +314,8 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     return status;
 }
 
+#ifndef WEAR_LEVELING_DUAL_BANK
+
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
  * Does not clear the write log.
@@ -265,27 +333,10 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     if (status != WEAR_LEVELING_FAILED) {
         // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_u64((WEAR_LEVELING_LOGICAL_SIZE), fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT))) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -316,7 +367,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_OFFSET);
 
     return status;
 }
@@ -352,62 +403,217 @@ static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value
 }
 
 /**
- * Handles writing multi_byte-encoded data to the backing store.
+ * Appends a complete log entry to the write log, optionally consolidating if the log is full.
  *
  * @return true if consolidation occurred
  */
-static wear_leveling_status_t wear_leveling_write_raw_multibyte(uint32_t address, const void *value, size_t length) {
-    const uint8_t *   p   = value;
-    write_log_entry_t log = LOG_ENTRY_MAKE_MULTIBYTE(address, length);
-    for (size_t i = 0; i < length; ++i) {
-        log.raw8[3 + i] = p[i];
+static wear_leveling_status_t wear_leveling_append_entry(const backing_store_int_t *values, size_t item_count) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (size_t i = 0; i < item_count; ++i) {
+        status = wear_leveling_append_raw(values[i]);
+        if (status != WEAR_LEVELING_SUCCESS) {
+            // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
+            // If a failure occurred, pass it on.
+            return status;
+        }
+    }
+    return status;
+}
+
+#else // WEAR_LEVELING_DUAL_BANK
+
+/**
+ * Background consolidation state.
+ */
+enum {
+    CONSOLIDATION_IDLE = 0, // No consolidation in progress
+    CONSOLIDATION_ERASE,    // Idle bank needs to be erased
+    CONSOLIDATION_COPY,     // Cache is being copied into the idle bank
+    CONSOLIDATION_COMMIT,   // Checksum and generation need to be written to the idle bank
+};
+
+/**
+ * Returns the address of the bank not currently in use.
+ */
+static inline uint32_t wear_leveling_idle_bank(void) {
+    return wear_leveling.bank_address == 0 ? (WEAR_LEVELING_BANK_SIZE) : 0;
+}
+
+/**
+ * Starts consolidation into the idle bank, beginning with erasing it.
+ */
+static void wear_leveling_consolidate_start(void) {
+    wear_leveling.consolidation.state         = CONSOLIDATION_ERASE;
+    wear_leveling.consolidation.bank_address  = wear_leveling_idle_bank();
+    wear_leveling.consolidation.write_address = wear_leveling.consolidation.bank_address + (WEAR_LEVELING_LOG_OFFSET);
+    wear_leveling.consolidation.offset        = 0;
+    wear_leveling.consolidation.hash          = FNV1A_64_INIT;
+}
+
+/**
+ * Performs a single step of background consolidation into the idle bank.
+ * Pre-condition: the backing store is unlocked.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the idle bank has become the active bank
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    switch (wear_leveling.consolidation.state) {
+        case CONSOLIDATION_ERASE: {
+            // Only one erase unit per step, as erasing a whole bank can stall for a long time on large sectors
+            uint32_t offset = wear_leveling.consolidation.offset;
+            wl_dprintf("Erasing idle bank at offset %d\n", (int)offset);
+            if (!backing_store_erase_range(wear_leveling.consolidation.bank_address + offset, (WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE))) {
+                wl_dprintf("Failed to erase idle bank\n");
+                return WEAR_LEVELING_FAILED;
+            }
+            wear_leveling.consolidation.offset = offset + (WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE);
+            if (wear_leveling.consolidation.offset >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling.consolidation.offset = 0;
+                wear_leveling.consolidation.state  = CONSOLIDATION_COPY;
+            }
+        } break;
+
+        case CONSOLIDATION_COPY: {
+            uint32_t offset = wear_leveling.consolidation.offset;
+            uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+            if (length > (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE)) {
+                length = (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE);
+            }
+            wl_dprintf("Copying consolidated data at offset %d\n", (int)offset);
+            if (!backing_store_write_bulk(wear_leveling.consolidation.bank_address + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / sizeof(backing_store_int_t))) {
+                wl_dprintf("Failed to write to backing store\n");
+                return WEAR_LEVELING_FAILED;
+            }
+            // The checksum is accumulated over the data as it was written, as the cache may change before the copy completes
+            wear_leveling.consolidation.hash   = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling.consolidation.hash);
+            wear_leveling.consolidation.offset = offset + length;
+            if (wear_leveling.consolidation.offset >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling.consolidation.state = CONSOLIDATION_COMMIT;
+            }
+        } break;
+
+        case CONSOLIDATION_COMMIT: {
+            // The generation is written last -- until it is present, the idle bank is ignored during init
+            wl_dprintf("Committing idle bank\n");
+            uint32_t bank_address = wear_leveling.consolidation.bank_address;
+            if (!wear_leveling_write_u64(bank_address + (WEAR_LEVELING_LOGICAL_SIZE), wear_leveling.consolidation.hash) || !wear_leveling_write_u64(bank_address + (WEAR_LEVELING_LOGICAL_SIZE) + 8, wear_leveling.generation + 1)) {
+                wl_dprintf("Failed to write checksum or generation\n");
+                return WEAR_LEVELING_FAILED;
+            }
+            wear_leveling.bank_address        = bank_address;
+            wear_leveling.write_address       = wear_leveling.consolidation.write_address;
+            wear_leveling.generation          = wear_leveling.generation + 1;
+            wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+            return WEAR_LEVELING_CONSOLIDATED;
+        }
+
+        default:
+            break;
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Runs any outstanding consolidation steps in-line, starting consolidation if none is in progress.
+ * Only used when the active write log is full, or is corrupted.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        wear_leveling_consolidate_start();
     }
 
-    // Write to the backing store. See the multi-byte log format in the documentation header at the top of the file.
     wear_leveling_status_t status;
-#if BACKING_STORE_WRITE_SIZE == 2
-    status = wear_leveling_append_raw(log.raw16[0]);
-    if (status != WEAR_LEVELING_SUCCESS) {
-        return status;
+    do {
+        status = wear_leveling_consolidate_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
+    if (status == WEAR_LEVELING_FAILED) {
+        // Restart from the erase on the next attempt, the active bank is still intact
+        wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
     }
 
-    status = wear_leveling_append_raw(log.raw16[1]);
-    if (status != WEAR_LEVELING_SUCCESS) {
-        return status;
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
     }
+    return status;
+}
 
-    if (length > 1) {
-        status = wear_leveling_append_raw(log.raw16[2]);
-        if (status != WEAR_LEVELING_SUCCESS) {
-            return status;
-        }
+/**
+ * Starts background consolidation if the active write log is running out of space.
+ * The actual work is performed by wear_leveling_task().
+ */
+static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE && wear_leveling.write_address + (WEAR_LEVELING_CONSOLIDATION_HEADROOM) >= wear_leveling.bank_address + (WEAR_LEVELING_BANK_SIZE)) {
+        wl_dprintf("Starting background consolidation\n");
+        wear_leveling_consolidate_start();
     }
 
-    if (length > 3) {
-        status = wear_leveling_append_raw(log.raw16[3]);
-        if (status != WEAR_LEVELING_SUCCESS) {
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Appends a complete log entry to the write log. Entries are never split across banks -- if the entry does not fit in
+ * the active write log, consolidation is completed first and the entry is appended to the new bank's write log.
+ */
+static wear_leveling_status_t wear_leveling_append_entry(const backing_store_int_t *values, size_t item_count) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    if (wear_leveling.write_address + (item_count * (BACKING_STORE_WRITE_SIZE)) > wear_leveling.bank_address + (WEAR_LEVELING_BANK_SIZE)) {
+        status = wear_leveling_consolidate_force();
+        if (status == WEAR_LEVELING_FAILED) {
             return status;
         }
+        // Unlike single-bank mode, the remainder of the write still needs to be logged as the copy may predate it
+        wear_leveling.consolidation.forced = true;
+        status                             = WEAR_LEVELING_SUCCESS;
     }
-#elif BACKING_STORE_WRITE_SIZE == 4
-    status = wear_leveling_append_raw(log.raw32[0]);
-    if (status != WEAR_LEVELING_SUCCESS) {
-        return status;
+
+    if (!backing_store_write_bulk(wear_leveling.write_address, (backing_store_int_t *)values, item_count)) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
     }
+    wear_leveling.write_address += item_count * (BACKING_STORE_WRITE_SIZE);
 
-    if (length > 1) {
-        status = wear_leveling_append_raw(log.raw32[1]);
-        if (status != WEAR_LEVELING_SUCCESS) {
-            return status;
+    // Mirror the entry into the idle bank if the copy has already started, as it may have missed this change
+    if (wear_leveling.consolidation.state == CONSOLIDATION_COPY || wear_leveling.consolidation.state == CONSOLIDATION_COMMIT) {
+        if (!backing_store_write_bulk(wear_leveling.consolidation.write_address, (backing_store_int_t *)values, item_count)) {
+            wl_dprintf("Failed to write to backing store\n");
+            return WEAR_LEVELING_FAILED;
         }
+        wear_leveling.consolidation.write_address += item_count * (BACKING_STORE_WRITE_SIZE);
     }
-#elif BACKING_STORE_WRITE_SIZE == 8
-    status = wear_leveling_append_raw(log.raw64);
-    if (status != WEAR_LEVELING_SUCCESS) {
-        return status;
+
+    wear_leveling_consolidate_if_needed();
+    return status;
+}
+
+#endif // WEAR_LEVELING_DUAL_BANK
+
+/**
+ * Handles writing multi_byte-encoded data to the backing store.
+ *
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_write_raw_multibyte(uint32_t address, const void *value, size_t length) {
+    const uint8_t *   p   = value;
+    write_log_entry_t log = LOG_ENTRY_MAKE_MULTIBYTE(address, length);
+    for (size_t i = 0; i < length; ++i) {
+        log.raw8[3 + i] = p[i];
     }
+
+    // Write to the backing store. See the multi-byte log format in the documentation header at the top of the file.
+#if BACKING_STORE_WRITE_SIZE == 2
+    return wear_leveling_append_entry(log.raw16, length > 3 ? 4 : (length > 1 ? 3 : 2));
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return wear_leveling_append_entry(log.raw32, length > 1 ? 2 : 1);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return wear_leveling_append_entry(&log.raw64, 1);
 #endif
-    return status;
 }
 
 /**
@@ -424,7 +630,7 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
             const uint16_t v = ((uint16_t)p[1]) << 8 | p[0]; // don't just dereference a uint16_t here -- if unaligned it generates faults on some MCUs
             if (v == 0 || v == 1) {
                 const write_log_entry_t log = LOG_ENTRY_MAKE_WORD_01(address, v);
-                status                      = wear_leveling_append_raw(log.raw16[0]);
+                status                      = wear_leveling_append_entry(log.raw16, 1);
                 if (status != WEAR_LEVELING_SUCCESS) {
                     // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
                     // If a failure occurred, pass it on.
@@ -441,7 +647,7 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
         // Small-write optimizations - address<64:
         if (address < 64) {
             const write_log_entry_t log = LOG_ENTRY_MAKE_OPTIMIZED_64(address, *p);
-            status                      = wear_leveling_append_raw(log.raw16[0]);
+            status                      = wear_leveling_append_entry(log.raw16, 1);
             if (status != WEAR_LEVELING_SUCCESS) {
                 // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
                 // If a failure occurred, pass it on.
@@ -469,18 +675,53 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+/**
+ * Chunked reader used during playback of the write log, so that the backing store is read in bulk rather than one
+ * item at a time.
+ */
+typedef struct wear_leveling_log_reader_t {
+    backing_store_int_t buffer[(WEAR_LEVELING_PLAYBACK_CHUNK_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    uint32_t            address; // Backing store address of buffer[0]
+    uint32_t            end;     // Backing store address of the end of the write log
+    size_t              count;   // Number of valid items in the buffer
+} wear_leveling_log_reader_t;
+
+/**
+ * Reads a single item of the write log, refilling the reader's buffer from the backing store if required.
+ */
+static bool wear_leveling_log_read(wear_leveling_log_reader_t *reader, uint32_t address, backing_store_int_t *value) {
+    if (address < reader->address || address >= reader->address + (reader->count * (BACKING_STORE_WRITE_SIZE))) {
+        if (address >= reader->end) {
+            return false;
+        }
+        size_t count = (reader->end - address) / (BACKING_STORE_WRITE_SIZE);
+        if (count > sizeof(reader->buffer) / sizeof(reader->buffer[0])) {
+            count = sizeof(reader->buffer) / sizeof(reader->buffer[0]);
+        }
+        reader->count = 0;
+        if (!backing_store_read_bulk(address, reader->buffer, count)) {
+            return false;
+        }
+        reader->address = address;
+        reader->count   = count;
+    }
+    *value = reader->buffer[(address - reader->address) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
 static wear_leveling_status_t wear_leveling_playback_log(void) {
     wl_dprintf("Playback write log\n");
 
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    wear_leveling_log_reader_t reader          = {.address = 0, .end = wear_leveling.bank_address + (WEAR_LEVELING_BANK_SIZE), .count = 0};
+    wear_leveling_status_t     status          = WEAR_LEVELING_SUCCESS;
+    bool                       cancel_playback = false;
+    uint32_t                   address         = wear_leveling.bank_address + (WEAR_LEVELING_LOG_OFFSET);
+    while (!cancel_playback && address < reader.end) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_log_read(&reader, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +750,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_log_read(&reader, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +770,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +780,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +791,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -611,6 +852,45 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
     return status;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+/**
+ * Selects the committed bank with the highest generation and a valid checksum as the active bank, reading its
+ * consolidated data into the cache. Falls back to the first bank if neither bank is usable.
+ */
+static wear_leveling_status_t wear_leveling_select_bank(void) {
+    uint64_t generations[2] = {0, 0};
+    for (int i = 0; i < 2; ++i) {
+        if (!wear_leveling_read_u64(i * (WEAR_LEVELING_BANK_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &generations[i])) {
+            wl_dprintf("Failed to read bank generation\n");
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+
+    int newest = generations[1] > generations[0] ? 1 : 0;
+    for (int i = 0; i < 2; ++i) {
+        int bank = newest ^ i;
+        if (generations[bank] == 0) {
+            continue;
+        }
+
+        bool checksum_ok;
+        wear_leveling.bank_address    = bank * (WEAR_LEVELING_BANK_SIZE);
+        wear_leveling.generation      = generations[bank];
+        wear_leveling_status_t status = wear_leveling_read_consolidated(wear_leveling.bank_address, &checksum_ok);
+        if (status == WEAR_LEVELING_FAILED || checksum_ok) {
+            wl_dprintf("Using bank %d, generation %d\n", bank, (int)generations[bank]);
+            return status;
+        }
+    }
+
+    // Keep the generation moving forward so that the next committed bank always takes precedence
+    wear_leveling.bank_address = 0;
+    wear_leveling.generation   = generations[newest];
+    wear_leveling_clear_cache();
+    return WEAR_LEVELING_SUCCESS;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 /**
  * Wear-leveling initialization
  */
@@ -618,6 +898,11 @@ wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
     // Reset the cache
+    wear_leveling.bank_address = 0;
+#ifdef WEAR_LEVELING_DUAL_BANK
+    wear_leveling.generation          = 0;
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_DUAL_BANK
     wear_leveling_clear_cache();
 
     // Initialise the backing store
@@ -628,7 +913,11 @@ wear_leveling_status_t wear_leveling_init(void) {
     }
 
     // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
-    wear_leveling_status_t status = wear_leveling_read_consolidated();
+#ifdef WEAR_LEVELING_DUAL_BANK
+    wear_leveling_status_t status = wear_leveling_select_bank();
+#else
+    wear_leveling_status_t status = wear_leveling_read_consolidated(0, NULL);
+#endif // WEAR_LEVELING_DUAL_BANK
     if (status == WEAR_LEVELING_FAILED) {
         // If it failed, clear the cache and return with failure
         wear_leveling_clear_cache();
@@ -660,7 +949,12 @@ wear_leveling_status_t wear_leveling_erase(void) {
     }
 
     // Perform the erase
-    bool ret = backing_store_erase();
+    bool ret                   = backing_store_erase();
+    wear_leveling.bank_address = 0;
+#ifdef WEAR_LEVELING_DUAL_BANK
+    wear_leveling.generation          = 0;
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_DUAL_BANK
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -699,7 +993,15 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     }
 
     // Perform the actual write
+#ifdef WEAR_LEVELING_DUAL_BANK
+    wear_leveling.consolidation.forced = false;
+#endif // WEAR_LEVELING_DUAL_BANK
     wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
+#ifdef WEAR_LEVELING_DUAL_BANK
+    if (status == WEAR_LEVELING_SUCCESS && wear_leveling.consolidation.forced) {
+        status = WEAR_LEVELING_CONSOLIDATED;
+    }
+#endif // WEAR_LEVELING_DUAL_BANK
     switch (status) {
         case WEAR_LEVELING_CONSOLIDATED:
         case WEAR_LEVELING_FAILED:
@@ -726,6 +1028,41 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Performs any pending background work.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_DUAL_BANK
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidate_step();
+    if (status == WEAR_LEVELING_FAILED) {
+        // Abandon this attempt, the active bank is still intact -- the next write will restart consolidation
+        wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+    }
+
+    // Lock the backing store if we acquired the lock successfully
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_DUAL_BANK
+}
+
 /**
  * Reads logical data from the cache.
  */
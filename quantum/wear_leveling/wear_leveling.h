@@ -52,3 +52,13 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Performs any pending background work.
+ *
+ * When WEAR_LEVELING_DUAL_BANK is enabled, each invocation performs a single step of any in-progress consolidation into
+ * the idle bank. Otherwise, this is a no-op.
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED once consolidation completes
+ */
+wear_leveling_status_t wear_leveling_task(void);
@@ -61,15 +61,53 @@ typedef uint64_t backing_store_int_t;
         } while (0)
 #endif // WEAR_LEVELING_ASSERTS
 
+// Number of bytes of the write log read from the backing store at a time during playback
+#ifndef WEAR_LEVELING_PLAYBACK_CHUNK_SIZE
+#    define WEAR_LEVELING_PLAYBACK_CHUNK_SIZE 64
+#endif // WEAR_LEVELING_PLAYBACK_CHUNK_SIZE
+
+#ifdef WEAR_LEVELING_DUAL_BANK
+// Each bank holds its own consolidated data, checksum, generation counter, and write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 16) // +16 due to the FNV1a_64 of the consolidated area, and the bank generation
+// Number of bytes of consolidated data copied into the idle bank per invocation of wear_leveling_task()
+#    ifndef WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE 32
+#    endif // WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE
+// Number of bytes of the idle bank erased per invocation of wear_leveling_task(), normally the backing store's erase unit
+#    ifndef WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE
+#        ifdef BACKING_STORE_ERASE_SIZE
+#            define WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE (BACKING_STORE_ERASE_SIZE)
+#        else
+#            define WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE (WEAR_LEVELING_BANK_SIZE)
+#        endif
+#    endif // WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE
+// Number of bytes left in the active write log at which background consolidation is started
+#    ifndef WEAR_LEVELING_CONSOLIDATION_HEADROOM
+#        define WEAR_LEVELING_CONSOLIDATION_HEADROOM (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_OFFSET)) / 4)
+#    endif // WEAR_LEVELING_CONSOLIDATION_HEADROOM
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 8) // +8 due to the FNV1a_64 of the consolidated area
+#endif // WEAR_LEVELING_DUAL_BANK
+
 // Compile-time validation of configurable options
 _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+_Static_assert(WEAR_LEVELING_PLAYBACK_CHUNK_SIZE >= 8 && WEAR_LEVELING_PLAYBACK_CHUNK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Playback chunk size must be a multiple of write size, and at least 8 bytes");
+#ifdef WEAR_LEVELING_DUAL_BANK
+_Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 4), "Total backing size must be at least four times the size of the logical size when using dual banks");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation chunk size must be a multiple of write size");
+_Static_assert((WEAR_LEVELING_BANK_SIZE) % (WEAR_LEVELING_CONSOLIDATION_ERASE_SIZE) == 0, "Bank size must be a multiple of the consolidation erase size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_HEADROOM < (WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_OFFSET), "Consolidation headroom must be smaller than the write log");
+#endif // WEAR_LEVELING_DUAL_BANK
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
 bool backing_store_erase(void);
+bool backing_store_erase_range(uint32_t address, size_t length); // only required when WEAR_LEVELING_DUAL_BANK is enabled, erases a single bank
 bool backing_store_write(uint32_t address, backing_store_int_t value);
 bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
 bool backing_store_lock(void);
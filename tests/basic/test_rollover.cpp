@@ -0,0 +1,135 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "action_util.h"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::ElementsAre;
+using testing::InSequence;
+
+class Rollover : public TestFixture {
+   protected:
+    std::vector<uint8_t> report_slots() {
+        return std::vector<uint8_t>(keyboard_report->keys, keyboard_report->keys + KEYBOARD_REPORT_KEYS);
+    }
+};
+
+TEST_F(Rollover, KeysKeepTheirSlotWhileHeld) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+
+    set_keymap({key_a, key_b, key_c, key_d});
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_REPORT(driver, (KC_C, KC_A));
+    EXPECT_REPORT(driver, (KC_C, KC_A, KC_B));
+    key_c.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_THAT(report_slots(), ElementsAre(KC_C, KC_A, KC_B, 0, 0, 0));
+
+    /* A released key leaves a gap, which the next key pressed fills */
+    EXPECT_REPORT(driver, (KC_C, KC_B));
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_THAT(report_slots(), ElementsAre(KC_C, 0, KC_B, 0, 0, 0));
+
+    EXPECT_REPORT(driver, (KC_C, KC_B, KC_D));
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_THAT(report_slots(), ElementsAre(KC_C, KC_D, KC_B, 0, 0, 0));
+
+    EXPECT_REPORT(driver, (KC_B, KC_D));
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    key_c.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Rollover, KeyBeyondTheReportRollsInOnRelease) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+    auto       key_f = KeymapKey(0, 5, 0, KC_F);
+    auto       key_g = KeymapKey(0, 6, 0, KC_G);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f, key_g});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(6);
+    for (auto key : {key_a, key_b, key_c, key_d, key_e, key_f}) {
+        key.press();
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    /* The seventh key doesn't fit, so nothing changes... */
+    EXPECT_NO_REPORT(driver);
+    key_g.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* ...until another key is released, and it takes that key's place */
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_G, KC_D, KC_E, KC_F));
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_THAT(report_slots(), ElementsAre(KC_A, KC_B, KC_G, KC_D, KC_E, KC_F));
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(6);
+    for (auto key : {key_a, key_b, key_d, key_e, key_f, key_g}) {
+        key.release();
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Rollover, UnchangedReportIsNotSentAgain) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Sending the report again without a change doesn't reach the host */
+    EXPECT_NO_REPORT(driver);
+    send_keyboard_report();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
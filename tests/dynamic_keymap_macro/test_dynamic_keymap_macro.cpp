@@ -0,0 +1,110 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+struct recorded_report_t {
+    report_keyboard_t report;
+    uint32_t          time;
+
+    bool operator==(const recorded_report_t &other) const {
+        return time == other.time && std::memcmp(&report, &other.report, sizeof(report)) == 0;
+    }
+};
+
+class DynamicKeymapMacro : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_macro_reset();
+    }
+
+    void store(const std::vector<std::string> &macros) {
+        std::string buffer;
+        for (const auto &macro : macros) {
+            buffer += macro;
+            buffer.push_back('\0');
+        }
+        dynamic_keymap_macro_set_buffer(0, buffer.size(), (uint8_t *)buffer.data());
+    }
+
+    // Runs the supplied action, returning every keyboard report it sends, timestamped relative to its start
+    template <typename F>
+    std::vector<recorded_report_t> record(F action) {
+        std::vector<recorded_report_t> reports;
+        uint32_t                       start = timer_read32();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            reports.push_back({report, timer_elapsed32(start)});
+        }));
+        action();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return reports;
+    }
+
+    // Checks that sending the stored macro matches sending its string directly
+    void expect_same_as_send_string(uint8_t id, const std::string &macro) {
+        auto expected = record([&] { send_string_with_delay(macro.c_str(), DYNAMIC_KEYMAP_MACRO_DELAY); });
+        auto actual   = record([&] { dynamic_keymap_macro_send(id); });
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(actual, expected);
+    }
+
+    TestDriver driver;
+};
+
+static const std::vector<std::string> macros = {
+    "hello",
+    SS_TAP(X_A) SS_DOWN(X_LSFT) "b" SS_UP(X_LSFT) SS_DELAY(25) "c",
+    "A much longer macro, which has to be streamed through several windows!",
+    SS_DELAY(5) SS_DELAY(1234) SS_TAP(X_ENTER) SS_TAP(X_ENTER) SS_TAP(X_ENTER) SS_TAP(X_ENTER) SS_TAP(X_ENTER) SS_TAP(X_ENTER),
+};
+
+TEST_F(DynamicKeymapMacro, MatchesSendString) {
+    store(macros);
+    for (uint8_t id = 0; id < macros.size(); id++) {
+        expect_same_as_send_string(id, macros[id]);
+    }
+}
+
+TEST_F(DynamicKeymapMacro, FollowsBufferChanges) {
+    store(macros);
+    expect_same_as_send_string(3, macros[3]);
+
+    // Shifts the start of every following macro
+    std::vector<std::string> updated = macros;
+    updated[0]                       = "hello world";
+    store(updated);
+    expect_same_as_send_string(3, updated[3]);
+}
+
+TEST_F(DynamicKeymapMacro, MissingMacroSendsNothing) {
+    store(macros);
+    EXPECT_TRUE(record([] { dynamic_keymap_macro_send(macros.size() + 1); }).empty());
+    EXPECT_TRUE(record([] { dynamic_keymap_macro_send(dynamic_keymap_macro_get_count()); }).empty());
+}
+
+TEST_F(DynamicKeymapMacro, IncompleteBufferSendsNothing) {
+    store(macros);
+
+    // A host marks the buffer invalid while writing it
+    uint8_t invalid = 0xFF;
+    dynamic_keymap_macro_set_buffer(dynamic_keymap_macro_get_buffer_size() - 1, 1, &invalid);
+    EXPECT_TRUE(record([] { dynamic_keymap_macro_send(0); }).empty());
+}
+
+TEST_F(DynamicKeymapMacro, TruncatedTokenStopsMacro) {
+    // The delay is too long to be valid, so only the text before it is sent
+    store({"ab\1\4" "123456|c"});
+    expect_same_as_send_string(0, "ab");
+}
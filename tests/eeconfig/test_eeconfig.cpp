@@ -0,0 +1,80 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeprom.h"
+}
+
+class EeconfigStaging : public TestFixture {
+   protected:
+    void SetUp() override {
+        // The fixture may have left configuration staged -- start each test from a clean slate
+        eeconfig_flush();
+    }
+
+    TestDriver driver;
+};
+
+TEST_F(EeconfigStaging, UpdateIsDeferred) {
+    eeconfig_update_keymap(0x1234);
+    EXPECT_TRUE(eeconfig_is_dirty());
+    EXPECT_EQ(eeconfig_read_keymap(), 0x1234);
+    EXPECT_NE(eeprom_read_word(EECONFIG_KEYMAP), 0x1234);
+
+    idle_for(EECONFIG_COMMIT_DELAY - 1);
+    EXPECT_TRUE(eeconfig_is_dirty());
+    EXPECT_NE(eeprom_read_word(EECONFIG_KEYMAP), 0x1234);
+
+    idle_for(2);
+    EXPECT_FALSE(eeconfig_is_dirty());
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), 0x1234);
+}
+
+TEST_F(EeconfigStaging, FurtherUpdatesRestartQuietPeriod) {
+    for (uint8_t layer = 1; layer <= 5; ++layer) {
+        eeconfig_update_default_layer(1 << layer);
+        idle_for(EECONFIG_COMMIT_DELAY / 2);
+        EXPECT_TRUE(eeconfig_is_dirty());
+    }
+    EXPECT_NE(eeprom_read_byte(EECONFIG_DEFAULT_LAYER), 1 << 5);
+
+    idle_for(EECONFIG_COMMIT_DELAY);
+    EXPECT_FALSE(eeconfig_is_dirty());
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEFAULT_LAYER), 1 << 5);
+}
+
+TEST_F(EeconfigStaging, BlocksAreCommittedTogether) {
+    eeconfig_update_keymap(0x0420);
+    eeconfig_update_handedness(true);
+    eeconfig_update_user(0xDEADBEEF);
+
+    idle_for(EECONFIG_COMMIT_DELAY + 1);
+    EXPECT_FALSE(eeconfig_is_dirty());
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), 0x0420);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_HANDEDNESS), 1);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_USER), 0xDEADBEEFu);
+}
+
+TEST_F(EeconfigStaging, UnchangedUpdateIsNotStaged) {
+    eeconfig_update_keymap(eeconfig_read_keymap());
+    EXPECT_FALSE(eeconfig_is_dirty());
+}
+
+TEST_F(EeconfigStaging, SuspendCommitsImmediately) {
+    eeconfig_update_kb(0x01020304);
+    EXPECT_TRUE(eeconfig_is_dirty());
+
+    suspend_power_down_quantum();
+    EXPECT_FALSE(eeconfig_is_dirty());
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_KEYBOARD), 0x01020304u);
+}
+
+TEST_F(EeconfigStaging, ResetDiscardsStagedChanges) {
+    eeconfig_update_user(0xCAFEF00D);
+    eeconfig_init_quantum();
+    EXPECT_FALSE(eeconfig_is_dirty());
+    EXPECT_EQ(eeconfig_read_user(), 0u);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_USER), 0u);
+}
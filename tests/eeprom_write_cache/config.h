@@ -0,0 +1,13 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TRANSIENT_EEPROM_SIZE 1024
+#define TRANSIENT_EEPROM_PAGE_SIZE 32
+#define TRANSIENT_EEPROM_WRITE_TIME 5
+
+#define EEPROM_WRITE_CACHE_PAGE_COUNT 4
+#define EEPROM_WRITE_CACHE_FLUSH_INTERVAL 10
@@ -0,0 +1,5 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+EEPROM_DRIVER = transient
+EEPROM_WRITE_CACHE_ENABLE = yes
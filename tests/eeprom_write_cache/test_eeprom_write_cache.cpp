@@ -0,0 +1,146 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeprom_driver.h"
+}
+
+class EepromWriteCache : public TestFixture {
+   protected:
+    void SetUp() override {
+        eeprom_driver_init();
+        // Let the erase settle, so that every test starts with an idle EEPROM
+        idle_for(TRANSIENT_EEPROM_WRITE_TIME);
+        start = timer_read32();
+    }
+
+    static void fill_pattern(uint8_t* buf, size_t len, uint8_t seed) {
+        for (size_t i = 0; i < len; ++i) {
+            buf[i] = (uint8_t)(seed + i * 7);
+        }
+    }
+
+    static bool backend_matches(const void* expected, uintptr_t addr, size_t len) {
+        uint8_t actual[TRANSIENT_EEPROM_SIZE];
+        eeprom_driver_backend_read_block(actual, (const void*)addr, len);
+        return std::memcmp(actual, expected, len) == 0;
+    }
+
+    TestDriver driver;
+    uint32_t   start;
+};
+
+TEST_F(EepromWriteCache, WritesDoNotWaitForDevice) {
+    uint8_t data[100];
+    fill_pattern(data, sizeof(data), 0x10);
+
+    // Spans four pages, each of which would take TRANSIENT_EEPROM_WRITE_TIME without the cache
+    eeprom_write_block(data, (void*)16, sizeof(data));
+    EXPECT_EQ(timer_elapsed32(start), 0u);
+    EXPECT_TRUE(eeprom_driver_is_dirty());
+
+    uint8_t readback[sizeof(data)];
+    eeprom_read_block(readback, (const void*)16, sizeof(readback));
+    EXPECT_EQ(std::memcmp(readback, data, sizeof(data)), 0);
+    EXPECT_EQ(timer_elapsed32(start), 0u);
+}
+
+TEST_F(EepromWriteCache, FlushesOnePagePerInterval) {
+    uint8_t data[100];
+    fill_pattern(data, sizeof(data), 0x20);
+    eeprom_write_block(data, (void*)16, sizeof(data));
+
+    EXPECT_FALSE(backend_matches(data, 16, 16));
+
+    // Pages are written out one at a time, oldest first
+    idle_for(EEPROM_WRITE_CACHE_FLUSH_INTERVAL);
+    EXPECT_TRUE(backend_matches(data, 16, 16));
+    EXPECT_FALSE(backend_matches(data + 16, 32, 32));
+    EXPECT_TRUE(eeprom_driver_is_dirty());
+
+    idle_for(3 * EEPROM_WRITE_CACHE_FLUSH_INTERVAL);
+    EXPECT_FALSE(eeprom_driver_is_dirty());
+    EXPECT_TRUE(backend_matches(data, 16, sizeof(data)));
+}
+
+TEST_F(EepromWriteCache, CoalescesRepeatedWrites) {
+    for (int i = 0; i < 100; ++i) {
+        eeprom_update_byte((uint8_t*)(uintptr_t)(i % 8), (uint8_t)i);
+    }
+    EXPECT_EQ(timer_elapsed32(start), 0u);
+
+    // All of the writes above land in the same page, so only a single device write is required
+    eeprom_driver_flush();
+    EXPECT_EQ(timer_elapsed32(start), 0u);
+    EXPECT_TRUE(eeprom_driver_backend_is_busy());
+
+    uint8_t expected[8] = {96, 97, 98, 99, 92, 93, 94, 95};
+    EXPECT_TRUE(backend_matches(expected, 0, sizeof(expected)));
+}
+
+TEST_F(EepromWriteCache, PreservesCleanBytesWithinPage) {
+    uint8_t original[32];
+    fill_pattern(original, sizeof(original), 0x30);
+    eeprom_write_block(original, (void*)64, sizeof(original));
+    eeprom_driver_flush();
+
+    // Dirty two bytes either side of a clean region
+    eeprom_write_byte((uint8_t*)66, 0xAA);
+    eeprom_write_byte((uint8_t*)90, 0xBB);
+
+    uint8_t readback[32];
+    eeprom_read_block(readback, (const void*)64, sizeof(readback));
+    original[2]  = 0xAA;
+    original[26] = 0xBB;
+    EXPECT_EQ(std::memcmp(readback, original, sizeof(original)), 0);
+
+    eeprom_driver_flush();
+    EXPECT_TRUE(backend_matches(original, 64, sizeof(original)));
+}
+
+TEST_F(EepromWriteCache, EvictsOldestPageWhenFull) {
+    uint8_t data[EEPROM_WRITE_CACHE_PAGE_COUNT + 2];
+    fill_pattern(data, sizeof(data), 0x40);
+
+    // Fill every cache page, writing one byte per page
+    for (int i = 0; i < EEPROM_WRITE_CACHE_PAGE_COUNT; ++i) {
+        eeprom_write_byte((uint8_t*)(uintptr_t)(i * TRANSIENT_EEPROM_PAGE_SIZE), data[i]);
+    }
+    EXPECT_EQ(timer_elapsed32(start), 0u);
+
+    // The next page forces the oldest out, the device is idle so there's no waiting
+    eeprom_write_byte((uint8_t*)(uintptr_t)(EEPROM_WRITE_CACHE_PAGE_COUNT * TRANSIENT_EEPROM_PAGE_SIZE), data[EEPROM_WRITE_CACHE_PAGE_COUNT]);
+    EXPECT_EQ(timer_elapsed32(start), 0u);
+    EXPECT_TRUE(backend_matches(&data[0], 0, 1));
+
+    // ...but a further page has to wait for the previous eviction to complete
+    eeprom_write_byte((uint8_t*)(uintptr_t)((EEPROM_WRITE_CACHE_PAGE_COUNT + 1) * TRANSIENT_EEPROM_PAGE_SIZE), data[EEPROM_WRITE_CACHE_PAGE_COUNT + 1]);
+    EXPECT_EQ(timer_elapsed32(start), (uint32_t)TRANSIENT_EEPROM_WRITE_TIME);
+
+    for (int i = 0; i < EEPROM_WRITE_CACHE_PAGE_COUNT + 2; ++i) {
+        EXPECT_EQ(eeprom_read_byte((const uint8_t*)(uintptr_t)(i * TRANSIENT_EEPROM_PAGE_SIZE)), data[i]);
+    }
+}
+
+TEST_F(EepromWriteCache, EraseDiscardsPendingWrites) {
+    eeprom_write_dword((uint32_t*)128, 0xDEADBEEF);
+    EXPECT_TRUE(eeprom_driver_is_dirty());
+
+    eeprom_driver_erase();
+    EXPECT_FALSE(eeprom_driver_is_dirty());
+    EXPECT_EQ(eeprom_read_dword((const uint32_t*)128), 0u);
+}
+
+TEST_F(EepromWriteCache, ResetFlushesPendingWrites) {
+    uint8_t data[40];
+    fill_pattern(data, sizeof(data), 0x50);
+    eeprom_write_block(data, (void*)200, sizeof(data));
+
+    soft_reset_keyboard();
+    EXPECT_FALSE(eeprom_driver_is_dirty());
+    EXPECT_TRUE(backend_matches(data, 200, sizeof(data)));
+}
@@ -0,0 +1,33 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define LED_MATRIX_LED_COUNT 48
+
+#define ENABLE_LED_MATRIX_ALPHAS_MODS
+#define ENABLE_LED_MATRIX_BAND
+#define ENABLE_LED_MATRIX_BAND_PINWHEEL
+#define ENABLE_LED_MATRIX_BAND_SPIRAL
+#define ENABLE_LED_MATRIX_BREATHING
+#define ENABLE_LED_MATRIX_CYCLE_LEFT_RIGHT
+#define ENABLE_LED_MATRIX_CYCLE_OUT_IN
+#define ENABLE_LED_MATRIX_CYCLE_UP_DOWN
+#define ENABLE_LED_MATRIX_DUAL_BEACON
+#define ENABLE_LED_MATRIX_MULTISPLASH
+#define ENABLE_LED_MATRIX_SOLID_MULTISPLASH
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_CROSS
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTICROSS
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTINEXUS
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTIWIDE
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_NEXUS
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_SIMPLE
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_WIDE
+#define ENABLE_LED_MATRIX_SOLID_SPLASH
+#define ENABLE_LED_MATRIX_SPLASH
+#define ENABLE_LED_MATRIX_WAVE_LEFT_RIGHT
+#define ENABLE_LED_MATRIX_WAVE_UP_DOWN
+
+#define LED_MATRIX_KEYPRESSES
@@ -0,0 +1,154 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "led_matrix.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void set_time(uint32_t t);
+}
+
+using testing::_;
+
+// A 4x10 grid of keys with modifiers in the bottom corners, and underglow around the edge
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {{4, 8}, {28, 8}, {52, 8}, {76, 8}, {100, 8}, {124, 8}, {148, 8}, {172, 8}, {196, 8}, {220, 8}, {4, 24}, {28, 24}, {52, 24}, {76, 24}, {100, 24}, {124, 24}, {148, 24}, {172, 24}, {196, 24}, {220, 24}, {4, 40}, {28, 40}, {52, 40}, {76, 40}, {100, 40}, {124, 40}, {148, 40}, {172, 40}, {196, 40}, {220, 40}, {4, 56}, {28, 56}, {52, 56}, {76, 56}, {100, 56}, {124, 56}, {148, 56}, {172, 56}, {196, 56}, {220, 56}, {0, 0}, {74, 0}, {150, 0}, {224, 0}, {224, 64}, {150, 64}, {74, 64}, {0, 64}},
+    {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 1, 4, 4, 4, 4, 4, 4, 4, 4, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+};
+
+/* Every effect's output over a fixed sequence of key presses is hashed, and
+ * compared with the output of the effects as they were first written, so that
+ * changes to the effects or the code driving them must keep every frame the same. */
+class LedEffectOutput : public TestFixture {
+   protected:
+    void expect_output(uint8_t mode, uint32_t expected) {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+        auto key_a = KeymapKey(0, 0, 0, KC_A);
+        auto key_b = KeymapKey(0, 4, 1, KC_B);
+        auto key_c = KeymapKey(0, 9, 3, KC_C);
+        set_keymap({key_a, key_b, key_c});
+
+        led_matrix_mode_noeeprom(LED_MATRIX_SOLID);
+        idle_for(LED_MATRIX_LED_FLUSH_LIMIT * 2);
+
+        led_matrix_init();
+        led_matrix_set_val_noeeprom(180);
+        led_matrix_set_speed_noeeprom(160);
+        set_time(1000);
+        led_matrix_mode_noeeprom(mode);
+        srand(1);
+        random16_set_seed(1337);
+        idle_for(LED_MATRIX_LED_FLUSH_LIMIT * 2);
+
+        test_led_matrix_frames.clear();
+        tap_key(key_a);
+        idle_for(150);
+        tap_key(key_b);
+        tap_key(key_c);
+        idle_for(400);
+        tap_key(key_b, 200);
+        idle_for(1000);
+
+        EXPECT_GT(test_led_matrix_frames.size(), 100u);
+        EXPECT_EQ(fnv1a(test_led_matrix_frames), expected);
+    }
+};
+
+TEST_F(LedEffectOutput, solid) {
+    expect_output(LED_MATRIX_SOLID, 0x8F620DD5);
+}
+
+TEST_F(LedEffectOutput, alphas_mods) {
+    expect_output(LED_MATRIX_ALPHAS_MODS, 0x5BC690F3);
+}
+
+TEST_F(LedEffectOutput, breathing) {
+    expect_output(LED_MATRIX_BREATHING, 0x5537AF75);
+}
+
+TEST_F(LedEffectOutput, band) {
+    expect_output(LED_MATRIX_BAND, 0x60514639);
+}
+
+TEST_F(LedEffectOutput, band_pinwheel) {
+    expect_output(LED_MATRIX_BAND_PINWHEEL, 0x401D7959);
+}
+
+TEST_F(LedEffectOutput, band_spiral) {
+    expect_output(LED_MATRIX_BAND_SPIRAL, 0x6682A0CC);
+}
+
+TEST_F(LedEffectOutput, cycle_left_right) {
+    expect_output(LED_MATRIX_CYCLE_LEFT_RIGHT, 0xFFB59861);
+}
+
+TEST_F(LedEffectOutput, cycle_up_down) {
+    expect_output(LED_MATRIX_CYCLE_UP_DOWN, 0x39AF167F);
+}
+
+TEST_F(LedEffectOutput, cycle_out_in) {
+    expect_output(LED_MATRIX_CYCLE_OUT_IN, 0x90971699);
+}
+
+TEST_F(LedEffectOutput, dual_beacon) {
+    expect_output(LED_MATRIX_DUAL_BEACON, 0x7FA2B1E6);
+}
+
+TEST_F(LedEffectOutput, solid_reactive_simple) {
+    expect_output(LED_MATRIX_SOLID_REACTIVE_SIMPLE, 0x6CAF4E9D);
+}
+
+TEST_F(LedEffectOutput, solid_reactive_wide) {
+    expect_output(LED_MATRIX_SOLID_REACTIVE_WIDE, 0x1CC8427E);
+}
+
+TEST_F(LedEffectOutput, solid_reactive_multiwide) {
+    expect_output(LED_MATRIX_SOLID_REACTIVE_MULTIWIDE, 0x4B516EC1);
+}
+
+TEST_F(LedEffectOutput, solid_reactive_cross) {
+    expect_output(LED_MATRIX_SOLID_REACTIVE_CROSS, 0xD0E03A3F);
+}
+
+TEST_F(LedEffectOutput, solid_reactive_multicross) {
+    expect_output(LED_MATRIX_SOLID_REACTIVE_MULTICROSS, 0x0CB43262);
+}
+
+TEST_F(LedEffectOutput, solid_reactive_nexus) {
+    expect_output(LED_MATRIX_SOLID_REACTIVE_NEXUS, 0x6663CD92);
+}
+
+TEST_F(LedEffectOutput, solid_reactive_multinexus) {
+    expect_output(LED_MATRIX_SOLID_REACTIVE_MULTINEXUS, 0xF39F0A39);
+}
+
+TEST_F(LedEffectOutput, solid_splash) {
+    expect_output(LED_MATRIX_SOLID_SPLASH, 0x5BF13E41);
+}
+
+TEST_F(LedEffectOutput, solid_multisplash) {
+    expect_output(LED_MATRIX_SOLID_MULTISPLASH, 0xD7F36F21);
+}
+
+TEST_F(LedEffectOutput, wave_left_right) {
+    expect_output(LED_MATRIX_WAVE_LEFT_RIGHT, 0x3A1EC597);
+}
+
+TEST_F(LedEffectOutput, wave_up_down) {
+    expect_output(LED_MATRIX_WAVE_UP_DOWN, 0xED3004CB);
+}
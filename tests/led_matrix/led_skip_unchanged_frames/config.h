@@ -0,0 +1,14 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define LED_MATRIX_LED_COUNT 8
+#define LED_MATRIX_SKIP_UNCHANGED_FRAMES
+
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_SIMPLE
+#define ENABLE_LED_MATRIX_BREATHING
+
+#define LED_MATRIX_KEYPRESSES
@@ -0,0 +1,146 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "led_matrix.h"
+#include "action_layer.h"
+}
+
+using testing::_;
+
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {4, 5, 6, 7, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    },
+    {{0, 0}, {74, 0}, {150, 0}, {224, 0}, {0, 64}, {74, 64}, {150, 64}, {224, 64}},
+    {4, 4, 4, 4, 4, 4, 4, 4},
+};
+
+extern "C" {
+bool led_matrix_indicators_user(void) {
+    if (layer_state_is(1)) {
+        led_matrix_set_value(0, 255);
+    }
+    return true;
+}
+}
+
+class LedSkipUnchangedFrames : public TestFixture {
+   protected:
+    /* Frames flushed and skipped over a stretch of time */
+    struct Counts {
+        size_t   flushed;
+        uint32_t rendered;
+        uint32_t skipped;
+    };
+
+    Counts count_for(uint32_t ms) {
+        size_t   flushed  = test_led_matrix_frames.size();
+        uint32_t rendered = led_matrix_get_rendered_frames();
+        uint32_t skipped  = led_matrix_get_skipped_frames();
+        idle_for(ms);
+        return {test_led_matrix_frames.size() - flushed, led_matrix_get_rendered_frames() - rendered, led_matrix_get_skipped_frames() - skipped};
+    }
+
+    void settle(uint8_t mode) {
+        led_matrix_mode_noeeprom(mode);
+        led_matrix_set_val_noeeprom(100);
+        idle_for(LED_MATRIX_LED_FLUSH_LIMIT * 4);
+    }
+};
+
+TEST_F(LedSkipUnchangedFrames, static_effect_is_flushed_once) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    led_matrix_mode_noeeprom(LED_MATRIX_BREATHING);
+    idle_for(LED_MATRIX_LED_FLUSH_LIMIT * 4);
+    settle(LED_MATRIX_SOLID);
+    Frame settled = test_led_matrix_frames.back();
+
+    Counts counts = count_for(1000);
+    EXPECT_EQ(counts.flushed, 0u);
+    EXPECT_EQ(counts.rendered, 0u);
+    EXPECT_GE(counts.skipped, 1000u / (LED_MATRIX_LED_FLUSH_LIMIT + 8));
+
+    /* What's on the LEDs is still the solid value */
+    EXPECT_GT(settled[0], 0);
+    for (int i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(settled[i], settled[0]);
+    }
+}
+
+TEST_F(LedSkipUnchangedFrames, config_change_renders_a_frame) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    settle(LED_MATRIX_SOLID);
+    uint8_t before = test_led_matrix_frames.back()[0];
+
+    led_matrix_set_val_noeeprom(50);
+    Counts counts = count_for(200);
+    EXPECT_EQ(counts.flushed, 1u);
+    EXPECT_EQ(counts.rendered, 1u);
+    EXPECT_LT(test_led_matrix_frames.back()[0], before);
+}
+
+TEST_F(LedSkipUnchangedFrames, layer_change_reruns_indicators) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    settle(LED_MATRIX_SOLID);
+    Frame plain = test_led_matrix_frames.back();
+
+    layer_on(1);
+    EXPECT_EQ(count_for(200).flushed, 1u);
+    EXPECT_GT(test_led_matrix_frames.back()[0], plain[0]);
+    EXPECT_EQ(test_led_matrix_frames.back()[1], plain[1]);
+
+    layer_off(1);
+    EXPECT_EQ(count_for(200).flushed, 1u);
+    EXPECT_EQ(test_led_matrix_frames.back(), plain);
+}
+
+TEST_F(LedSkipUnchangedFrames, timed_effect_renders_every_frame) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    settle(LED_MATRIX_BREATHING);
+
+    Counts counts = count_for(1000);
+    EXPECT_EQ(counts.skipped, 0u);
+    EXPECT_EQ(counts.flushed, counts.rendered);
+    EXPECT_GE(counts.rendered, 1000u / (LED_MATRIX_LED_FLUSH_LIMIT + 8));
+}
+
+TEST_F(LedSkipUnchangedFrames, reactive_effect_renders_while_hits_fade) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    auto key = KeymapKey(0, 1, 0, KC_A);
+    set_keymap({key});
+
+    settle(LED_MATRIX_SOLID_REACTIVE_SIMPLE);
+    EXPECT_EQ(count_for(500).rendered, 0u);
+
+    tap_key(key);
+    Counts counts = count_for(1000);
+    EXPECT_EQ(counts.skipped, 0u);
+    EXPECT_GE(counts.rendered, 1000u / (LED_MATRIX_LED_FLUSH_LIMIT + 8));
+
+    /* Once the hit is forgotten, the effect is back to its resting state */
+    idle_for(UINT16_MAX);
+    counts = count_for(1000);
+    EXPECT_EQ(counts.rendered, 0u);
+    EXPECT_GT(counts.skipped, 0u);
+}
@@ -0,0 +1,10 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define MK_KINETIC_SPEED
+#define MOUSEKEY_DELAY 100
+#define MOUSEKEY_DECELERATED_SPEED 150
@@ -0,0 +1,121 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "mousekey.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+struct Motion {
+    int      x          = 0;
+    int      v          = 0;
+    unsigned reports    = 0;
+    unsigned idle       = 0;
+    int      smallest_x = INT16_MAX;
+    int      largest_x  = 0;
+};
+
+/* Integrates one of the kinetic acceleration curves, in units per second, from
+ * the first repeat until `duration`. The first repeat moves as far as `lead`
+ * milliseconds at the speed it starts with. */
+double expected_distance(unsigned duration, unsigned first_repeat, unsigned lead, double initial, double delta, double base) {
+    double distance = 0;
+
+    for (unsigned t = first_repeat; t < duration; t++) {
+        double speed = initial + delta * t / 50 + delta * t * t / 5000;
+        distance += (speed < base ? speed : base) / 1000;
+    }
+    return distance + lead * (initial + delta * first_repeat / 50 + delta * first_repeat * first_repeat / 5000) / 1000;
+}
+
+} // namespace
+
+class KineticSpeed : public TestFixture {
+   protected:
+    Motion hold(TestDriver &driver, KeymapKey key, unsigned duration) {
+        Motion motion;
+
+        /* The acceleration curves treat a start time of 0 as not moving */
+        idle_for(1);
+
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([&motion](report_mouse_t &report) {
+            motion.reports++;
+            if (!report.x && !report.y && !report.v && !report.h) {
+                motion.idle++;
+                return;
+            }
+            motion.x += report.x;
+            motion.v += report.v;
+            if (report.x) {
+                motion.smallest_x = std::min<int>(motion.smallest_x, report.x);
+                motion.largest_x  = std::max<int>(motion.largest_x, report.x);
+            }
+        }));
+
+        key.press();
+        idle_for(duration);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+
+        EXPECT_CALL(driver, send_mouse_mock(_)).Times(testing::AnyNumber());
+        key.release();
+        run_one_scan_loop();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+
+        return motion;
+    }
+};
+
+TEST_F(KineticSpeed, cursor_distance_follows_the_curve) {
+    TestDriver driver;
+    auto       right = KeymapKey(0, 0, 0, KC_MS_RIGHT);
+
+    set_keymap({right});
+
+    Motion motion   = hold(driver, right, 1000);
+    double expected = 1 + expected_distance(1000, MOUSEKEY_DELAY + 1, MOUSEKEY_INTERVAL, MOUSEKEY_INITIAL_SPEED, MOUSEKEY_MOVE_DELTA, MOUSEKEY_BASE_SPEED);
+
+    EXPECT_NEAR(motion.x, expected, expected * 0.02);
+    /* Every report carries some movement */
+    EXPECT_EQ(motion.idle, 0u);
+}
+
+TEST_F(KineticSpeed, slow_movement_is_not_truncated) {
+    TestDriver driver;
+    auto       right = KeymapKey(0, 0, 0, KC_MS_RIGHT);
+    auto       slow  = KeymapKey(0, 1, 0, KC_MS_ACCEL0);
+
+    set_keymap({right, slow});
+
+    slow.press();
+    run_one_scan_loop();
+
+    /* 1.5 pixels per interval, which used to be reported as 1 */
+    Motion motion   = hold(driver, right, 1000);
+    double expected = 1 + (1000 - MOUSEKEY_DELAY - 1 + MOUSEKEY_INTERVAL) * MOUSEKEY_DECELERATED_SPEED / 1000.0;
+
+    EXPECT_NEAR(motion.x, expected, 2);
+    EXPECT_EQ(motion.smallest_x, 1);
+    EXPECT_EQ(motion.largest_x, 2);
+
+    slow.release();
+    run_one_scan_loop();
+}
+
+TEST_F(KineticSpeed, wheel_distance_follows_the_curve) {
+    TestDriver driver;
+    auto       down = KeymapKey(0, 0, 0, KC_MS_WH_DOWN);
+
+    set_keymap({down});
+
+    /* Fewer movements per second than reports, so most intervals carry over */
+    Motion motion   = hold(driver, down, 1000);
+    double expected = 1 + expected_distance(1000, MOUSEKEY_WHEEL_DELAY + 1, 1000 / MOUSEKEY_WHEEL_INITIAL_MOVEMENTS, MOUSEKEY_WHEEL_INITIAL_MOVEMENTS, 1, MOUSEKEY_WHEEL_BASE_MOVEMENTS);
+
+    EXPECT_NEAR(-motion.v, expected, 2);
+    EXPECT_EQ(motion.idle, 0u);
+    EXPECT_LT(motion.reports, 1000u / MOUSEKEY_INTERVAL);
+}
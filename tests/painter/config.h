@@ -0,0 +1,15 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB565_SURFACE_NUM_DEVICES 6
+#define QUANTUM_PAINTER_PIXDATA_BUFFER_COUNT 2
+
+// Room for three of the 8x16 test images once converted to RGB565, but not four
+#define QUANTUM_PAINTER_IMAGE_CACHE_SIZE 1024
+#define QUANTUM_PAINTER_IMAGE_CACHE_ENTRIES 8
+
+#define EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN NO_PIN
@@ -0,0 +1,48 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "qp.h"
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QGF/QFF construction
+
+inline void append_block(std::vector<uint8_t>& out, uint8_t type_id, const void* data, uint32_t length) {
+    const uint8_t header[] = {type_id, (uint8_t)~type_id, (uint8_t)length, (uint8_t)(length >> 8), (uint8_t)(length >> 16)};
+    out.insert(out.end(), header, header + sizeof(header));
+    out.insert(out.end(), (const uint8_t*)data, (const uint8_t*)data + length);
+}
+
+inline void patch_total_size(std::vector<uint8_t>& out) {
+    uint32_t total_size = out.size(), neg_total_size = ~total_size;
+    std::memcpy(&out[5 + 4], &total_size, sizeof(total_size));
+    std::memcpy(&out[5 + 8], &neg_total_size, sizeof(neg_total_size));
+}
+
+// Single-frame, uncompressed 1bpp grayscale image; the pixel data is always the last block
+inline std::vector<uint8_t> make_mono_image(uint16_t width, uint16_t height, const std::vector<uint8_t>& pixels) {
+    std::vector<uint8_t> out;
+
+    uint8_t graphics_descriptor[18] = {0x51, 0x47, 0x46, 0x01};
+    std::memcpy(&graphics_descriptor[12], &width, sizeof(width));
+    std::memcpy(&graphics_descriptor[14], &height, sizeof(height));
+    graphics_descriptor[16] = 1; // frame count
+    append_block(out, 0x00, graphics_descriptor, sizeof(graphics_descriptor));
+
+    uint32_t frame_offset = out.size() + 5 + sizeof(frame_offset);
+    append_block(out, 0x01, &frame_offset, sizeof(frame_offset));
+
+    const uint8_t frame_descriptor[6] = {GRAYSCALE_1BPP, 0, IMAGE_UNCOMPRESSED, 0, 0, 0};
+    append_block(out, 0x02, frame_descriptor, sizeof(frame_descriptor));
+    append_block(out, 0x05, pixels.data(), pixels.size());
+
+    patch_total_size(out);
+    return out;
+}
@@ -0,0 +1,13 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = rgb565_surface
+
+# External flash is provided by a file-backed mock within the tests
+OPT_DEFS += -DQP_STREAM_HAS_FLASH_IO
+VPATH += $(DRIVER_PATH)/flash
+
+# The shared TFT panel implementation is exercised through a mock comms driver
+VPATH += $(DRIVER_PATH)/painter/tft_panel
+SRC += $(DRIVER_PATH)/painter/tft_panel/qp_tft_panel.c
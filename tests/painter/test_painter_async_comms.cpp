@@ -0,0 +1,256 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "qgf_test_image.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_comms.h"
+#include "qp_draw.h"
+#include "color.h"
+}
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mock comms driver
+//
+// Asynchronous transfers are held in flight until they're waited upon, modelling a bus which is much slower than the
+// CPU. The transferred data is only captured on completion, so anything overwriting a buffer mid-transfer shows up as
+// corrupted output. Any command or synchronous transfer issued whilst a transfer is in flight is an ordering violation.
+
+struct mock_comms_t {
+    std::vector<uint8_t> received;
+    std::vector<uint8_t> commands;
+    const uint8_t*       in_flight;
+    uint32_t             in_flight_bytes;
+    uint32_t             sync_transfers;
+    uint32_t             async_transfers;
+    uint32_t             overlapped_transfers;
+    uint32_t             ordering_violations;
+} mock;
+
+void mock_reset(void) {
+    mock = {};
+}
+
+bool mock_comms_init(painter_device_t device) {
+    return true;
+}
+
+bool mock_comms_start(painter_device_t device) {
+    return true;
+}
+
+void mock_comms_stop(painter_device_t device) {
+    if (mock.in_flight) {
+        ++mock.ordering_violations;
+    }
+}
+
+uint32_t mock_comms_send(painter_device_t device, const void* data, uint32_t byte_count) {
+    if (mock.in_flight) {
+        ++mock.ordering_violations;
+    }
+    ++mock.sync_transfers;
+    const uint8_t* p = (const uint8_t*)data;
+    mock.received.insert(mock.received.end(), p, p + byte_count);
+    return byte_count;
+}
+
+uint32_t mock_comms_send_async(painter_device_t device, const void* data, uint32_t byte_count) {
+    if (mock.in_flight) {
+        ++mock.ordering_violations;
+    }
+    ++mock.async_transfers;
+    mock.in_flight       = (const uint8_t*)data;
+    mock.in_flight_bytes = byte_count;
+    return byte_count;
+}
+
+void mock_comms_wait(painter_device_t device) {
+    if (!mock.in_flight) {
+        return;
+    }
+
+    // If the producer has already moved on to the other buffer, it was preparing data during the transfer
+    if (mock.in_flight != qp_internal_global_pixdata_buffer) {
+        ++mock.overlapped_transfers;
+    }
+
+    mock.received.insert(mock.received.end(), mock.in_flight, mock.in_flight + mock.in_flight_bytes);
+    mock.in_flight = nullptr;
+}
+
+void mock_comms_send_command(painter_device_t device, uint8_t cmd) {
+    if (mock.in_flight) {
+        ++mock.ordering_violations;
+    }
+    mock.commands.push_back(cmd);
+}
+
+void mock_comms_bulk_command_sequence(painter_device_t device, const uint8_t* sequence, size_t sequence_len) {}
+
+const painter_comms_with_command_vtable_t mock_comms_vtable = {
+    .base =
+        {
+            .comms_init       = mock_comms_init,
+            .comms_start      = mock_comms_start,
+            .comms_stop       = mock_comms_stop,
+            .comms_send       = mock_comms_send,
+            .comms_send_async = mock_comms_send_async,
+            .comms_wait       = mock_comms_wait,
+        },
+    .send_command          = mock_comms_send_command,
+    .bulk_command_sequence = mock_comms_bulk_command_sequence,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Minimal RGB565 panel driver using the mock comms
+
+constexpr uint8_t MOCK_CMD_WRITE = 0x2C;
+
+bool mock_panel_noop(painter_device_t device) {
+    return true;
+}
+
+bool mock_panel_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+bool mock_panel_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+bool mock_panel_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    qp_comms_command(device, MOCK_CMD_WRITE);
+    return true;
+}
+
+bool mock_panel_pixdata(painter_device_t device, const void* pixel_data, uint32_t native_pixel_count) {
+    qp_comms_send(device, pixel_data, native_pixel_count * sizeof(uint16_t));
+    return true;
+}
+
+bool mock_panel_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t* palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        RGB      rgb      = hsv_to_rgb_nocie((HSV){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v});
+        uint16_t rgb565   = (((uint16_t)rgb.r) >> 3) << 11 | (((uint16_t)rgb.g) >> 2) << 5 | (((uint16_t)rgb.b) >> 3);
+        palette[i].rgb565 = __builtin_bswap16(rgb565);
+    }
+    return true;
+}
+
+bool mock_panel_append_pixels(painter_device_t device, uint8_t* target_buffer, qp_pixel_t* palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t* palette_indices) {
+    uint16_t* buf = (uint16_t*)target_buffer;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[pixel_offset + i] = palette[palette_indices[i]].rgb565;
+    }
+    return true;
+}
+
+bool mock_panel_append_pixdata(painter_device_t device, uint8_t* target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+const painter_driver_vtable_t mock_panel_vtable = {
+    .init            = mock_panel_init,
+    .power           = mock_panel_power,
+    .clear           = mock_panel_noop,
+    .flush           = mock_panel_noop,
+    .viewport        = mock_panel_viewport,
+    .pixdata         = mock_panel_pixdata,
+    .palette_convert = mock_panel_palette_convert,
+    .append_pixels   = mock_panel_append_pixels,
+    .append_pixdata  = mock_panel_append_pixdata,
+};
+
+constexpr uint16_t PANEL_WIDTH  = 64;
+constexpr uint16_t PANEL_HEIGHT = 48;
+
+painter_driver_t mock_panel;
+uint16_t         reference_framebuffer[PANEL_WIDTH * PANEL_HEIGHT];
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class QuantumPainterAsyncComms : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_panel                       = {};
+        mock_panel.driver_vtable         = &mock_panel_vtable;
+        mock_panel.comms_vtable          = (const painter_comms_vtable_t*)&mock_comms_vtable;
+        mock_panel.panel_width           = PANEL_WIDTH;
+        mock_panel.panel_height          = PANEL_HEIGHT;
+        mock_panel.native_bits_per_pixel = 16;
+        ASSERT_TRUE(qp_init(&mock_panel, QP_ROTATION_0));
+        mock_reset();
+    }
+
+    void TearDown() override {
+        EXPECT_EQ(mock.in_flight, nullptr) << "transfer still in flight after the operation completed";
+        EXPECT_EQ(mock.ordering_violations, 0u);
+    }
+};
+
+TEST_F(QuantumPainterAsyncComms, ImageChunksOverlapAndArriveInOrder) {
+    // Pseudo-random pixel data, so that any reordered or clobbered chunk is detected
+    std::vector<uint8_t> pixels(PANEL_WIDTH * PANEL_HEIGHT / 8);
+    uint32_t             lfsr = 0xACE1u;
+    for (auto& b : pixels) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+        b    = (uint8_t)lfsr;
+    }
+    std::vector<uint8_t> image = make_mono_image(PANEL_WIDTH, PANEL_HEIGHT, pixels);
+
+    // Render via the synchronous path into a surface for reference
+    painter_device_t       surface = qp_rgb565_make_surface(PANEL_WIDTH, PANEL_HEIGHT, reference_framebuffer);
+    painter_image_handle_t handle  = qp_load_image_mem(image.data());
+    ASSERT_NE(handle, nullptr);
+    ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+    ASSERT_TRUE(qp_drawimage(surface, 0, 0, handle));
+
+    ASSERT_TRUE(qp_drawimage(&mock_panel, 0, 0, handle));
+    ASSERT_TRUE(qp_close_image(handle));
+
+    // Every full chunk should have been prepared whilst the previous one was transferring
+    uint32_t chunks = (PANEL_WIDTH * PANEL_HEIGHT * sizeof(uint16_t) + QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE - 1) / QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE;
+    EXPECT_EQ(mock.async_transfers, chunks);
+    EXPECT_GE(mock.overlapped_transfers, chunks - 1);
+    EXPECT_EQ(mock.sync_transfers, 0u);
+
+    ASSERT_EQ(mock.received.size(), sizeof(reference_framebuffer));
+    EXPECT_EQ(std::memcmp(mock.received.data(), reference_framebuffer, sizeof(reference_framebuffer)), 0);
+}
+
+TEST_F(QuantumPainterAsyncComms, FilledRectResendsSameBuffer) {
+    ASSERT_TRUE(qp_rect(&mock_panel, 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 85, 255, 255, true));
+
+    uint32_t chunks = (PANEL_WIDTH * PANEL_HEIGHT * sizeof(uint16_t) + QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE - 1) / QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE;
+    EXPECT_EQ(mock.async_transfers, chunks);
+    ASSERT_EQ(mock.received.size(), PANEL_WIDTH * PANEL_HEIGHT * sizeof(uint16_t));
+
+    uint16_t first;
+    std::memcpy(&first, mock.received.data(), sizeof(first));
+    for (size_t i = 0; i < mock.received.size(); i += sizeof(uint16_t)) {
+        uint16_t px;
+        std::memcpy(&px, &mock.received[i], sizeof(px));
+        ASSERT_EQ(px, first) << "mismatch at pixel " << i / sizeof(uint16_t);
+    }
+}
+
+TEST_F(QuantumPainterAsyncComms, CommandsWaitForOutstandingTransfer) {
+    // Lines are drawn as a sequence of viewport/pixdata pairs, each viewport command must follow the previous pixdata
+    ASSERT_TRUE(qp_line(&mock_panel, 0, 0, 10, 7, 0, 0, 255));
+
+    EXPECT_GT(mock.async_transfers, 1u);
+    EXPECT_EQ(mock.commands.size(), mock.async_transfers);
+    EXPECT_EQ(mock.received.size(), mock.async_transfers * sizeof(uint16_t));
+}
+
+} // namespace
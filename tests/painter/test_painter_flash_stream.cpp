@@ -0,0 +1,233 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "qgf_test_image.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_stream.h"
+#include "flash_spi.h"
+}
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// File-backed SPI NOR flash mock
+//
+// Each read is counted as a separate transaction, so that the effectiveness of the read-ahead cache can be measured.
+// A SPI NOR read transaction costs a command byte plus three address bytes on top of the data itself.
+
+constexpr uint32_t FLASH_READ_OVERHEAD_BYTES = 4;
+
+struct mock_flash_t {
+    FILE*    file;
+    uint32_t transactions;
+    uint32_t bytes_read;
+} mock_flash;
+
+} // namespace
+
+extern "C" {
+
+void flash_init(void) {
+    if (!mock_flash.file) {
+        mock_flash.file = tmpfile();
+    }
+}
+
+flash_status_t flash_read_block(uint32_t addr, void* buf, size_t len) {
+    if (addr + len > EXTERNAL_FLASH_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+
+    ++mock_flash.transactions;
+    mock_flash.bytes_read += len;
+
+    // Unwritten flash reads back as erased
+    std::memset(buf, 0xFF, len);
+    std::fseek(mock_flash.file, addr, SEEK_SET);
+    std::fread(buf, 1, len, mock_flash.file);
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_write_block(uint32_t addr, const void* buf, size_t len) {
+    if (addr + len > EXTERNAL_FLASH_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+
+    std::fseek(mock_flash.file, addr, SEEK_SET);
+    std::fwrite(buf, 1, len, mock_flash.file);
+    std::fflush(mock_flash.file);
+    return FLASH_STATUS_SUCCESS;
+}
+
+} // extern "C"
+
+namespace {
+
+void mock_flash_reset_counters(void) {
+    mock_flash.transactions = 0;
+    mock_flash.bytes_read   = 0;
+    qp_flash_stream_invalidate_cache();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QGF/QFF construction
+
+std::vector<uint8_t> pseudo_random_bytes(size_t count) {
+    std::vector<uint8_t> bytes(count);
+    uint32_t             lfsr = 0xACE1u;
+    for (auto& b : bytes) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+        b    = (uint8_t)lfsr;
+    }
+    return bytes;
+}
+
+// Uncompressed 1bpp grayscale font with a full ascii table, every glyph 8x8 pixels
+constexpr uint8_t FONT_GLYPH_SIZE = 8;
+
+std::vector<uint8_t> make_mono_font(const std::vector<uint8_t>& glyph_data) {
+    std::vector<uint8_t> out;
+
+    uint8_t font_descriptor[20] = {0x51, 0x46, 0x46, 0x01};
+    font_descriptor[12]         = FONT_GLYPH_SIZE; // line height
+    font_descriptor[13]         = 1;               // has ascii table
+    font_descriptor[16]         = GRAYSCALE_1BPP;
+    font_descriptor[18]         = IMAGE_UNCOMPRESSED;
+    font_descriptor[19]         = 0xFF; // transparency index
+    append_block(out, 0x00, font_descriptor, sizeof(font_descriptor));
+
+    uint8_t ascii_table[95 * 3];
+    for (uint32_t i = 0; i < 95; ++i) {
+        uint32_t value         = FONT_GLYPH_SIZE | ((i * FONT_GLYPH_SIZE * FONT_GLYPH_SIZE / 8) << 6);
+        ascii_table[i * 3 + 0] = (uint8_t)value;
+        ascii_table[i * 3 + 1] = (uint8_t)(value >> 8);
+        ascii_table[i * 3 + 2] = (uint8_t)(value >> 16);
+    }
+    append_block(out, 0x01, ascii_table, sizeof(ascii_table));
+    append_block(out, 0x04, glyph_data.data(), glyph_data.size());
+
+    patch_total_size(out);
+    return out;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr uint16_t SURFACE_WIDTH  = 96;
+constexpr uint16_t SURFACE_HEIGHT = 64;
+
+uint16_t framebuffer_from_mem[SURFACE_WIDTH * SURFACE_HEIGHT];
+uint16_t framebuffer_from_flash[SURFACE_WIDTH * SURFACE_HEIGHT];
+
+class QuantumPainterFlashStream : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        flash_init();
+        from_mem   = qp_rgb565_make_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffer_from_mem);
+        from_flash = qp_rgb565_make_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffer_from_flash);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(from_mem, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(from_flash, QP_ROTATION_0));
+        std::memset(framebuffer_from_mem, 0, sizeof(framebuffer_from_mem));
+        std::memset(framebuffer_from_flash, 0, sizeof(framebuffer_from_flash));
+        mock_flash_reset_counters();
+    }
+
+    static painter_device_t from_mem;
+    static painter_device_t from_flash;
+};
+
+painter_device_t QuantumPainterFlashStream::from_mem   = nullptr;
+painter_device_t QuantumPainterFlashStream::from_flash = nullptr;
+
+TEST_F(QuantumPainterFlashStream, ImageMatchesMemory) {
+    constexpr uint32_t   address = 0x1000;
+    std::vector<uint8_t> image   = make_mono_image(SURFACE_WIDTH, SURFACE_HEIGHT, pseudo_random_bytes(SURFACE_WIDTH * SURFACE_HEIGHT / 8));
+    ASSERT_EQ(flash_write_block(address, image.data(), image.size()), FLASH_STATUS_SUCCESS);
+
+    painter_image_handle_t mem_image   = qp_load_image_mem(image.data());
+    painter_image_handle_t flash_image = qp_load_image_flash(address);
+    ASSERT_NE(mem_image, nullptr);
+    ASSERT_NE(flash_image, nullptr);
+    EXPECT_EQ(flash_image->width, SURFACE_WIDTH);
+    EXPECT_EQ(flash_image->height, SURFACE_HEIGHT);
+
+    ASSERT_TRUE(qp_drawimage(from_mem, 0, 0, mem_image));
+    ASSERT_TRUE(qp_drawimage(from_flash, 0, 0, flash_image));
+    EXPECT_EQ(std::memcmp(framebuffer_from_mem, framebuffer_from_flash, sizeof(framebuffer_from_mem)), 0);
+
+    ASSERT_TRUE(qp_close_image(mem_image));
+    ASSERT_TRUE(qp_close_image(flash_image));
+}
+
+TEST_F(QuantumPainterFlashStream, FontMatchesMemory) {
+    constexpr uint32_t   address = 0x3000;
+    std::vector<uint8_t> font    = make_mono_font(pseudo_random_bytes(95 * FONT_GLYPH_SIZE * FONT_GLYPH_SIZE / 8));
+    ASSERT_EQ(flash_write_block(address, font.data(), font.size()), FLASH_STATUS_SUCCESS);
+
+    painter_font_handle_t mem_font   = qp_load_font_mem(font.data());
+    painter_font_handle_t flash_font = qp_load_font_flash(address);
+    ASSERT_NE(mem_font, nullptr);
+    ASSERT_NE(flash_font, nullptr);
+    EXPECT_EQ(flash_font->line_height, FONT_GLYPH_SIZE);
+
+    const char* text = "Hello, flash!";
+    EXPECT_EQ(qp_textwidth(flash_font, text), qp_textwidth(mem_font, text));
+    EXPECT_GT(qp_drawtext(from_mem, 2, 2, mem_font, text), 0);
+    EXPECT_GT(qp_drawtext(from_flash, 2, 2, flash_font, text), 0);
+    EXPECT_EQ(std::memcmp(framebuffer_from_mem, framebuffer_from_flash, sizeof(framebuffer_from_mem)), 0);
+
+    ASSERT_TRUE(qp_close_font(mem_font));
+    ASSERT_TRUE(qp_close_font(flash_font));
+}
+
+TEST_F(QuantumPainterFlashStream, ErasedFlashFailsToLoad) {
+    EXPECT_EQ(qp_load_image_flash(0x8000), nullptr);
+    EXPECT_EQ(qp_load_font_flash(0x8000), nullptr);
+}
+
+TEST_F(QuantumPainterFlashStream, ReadAheadThroughput) {
+    constexpr uint32_t   address = 0x1000;
+    std::vector<uint8_t> image   = make_mono_image(SURFACE_WIDTH, SURFACE_HEIGHT, pseudo_random_bytes(SURFACE_WIDTH * SURFACE_HEIGHT / 8));
+    ASSERT_EQ(flash_write_block(address, image.data(), image.size()), FLASH_STATUS_SUCCESS);
+
+    painter_image_handle_t flash_image = qp_load_image_flash(address);
+    ASSERT_NE(flash_image, nullptr);
+
+    constexpr int iterations = 50;
+    mock_flash_reset_counters();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        ASSERT_TRUE(qp_drawimage(from_flash, 0, 0, flash_image));
+    }
+    auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_TRUE(qp_close_image(flash_image));
+
+    // Without read-ahead every byte consumed by the decoder is its own flash transaction, and the decoder consumes at
+    // least the whole image on each draw.
+    uint64_t uncached_transactions = (uint64_t)image.size() * iterations;
+    uint64_t cached_wire_bytes     = mock_flash.bytes_read + (uint64_t)mock_flash.transactions * FLASH_READ_OVERHEAD_BYTES;
+    uint64_t uncached_wire_bytes   = uncached_transactions * (1 + FLASH_READ_OVERHEAD_BYTES);
+
+    RecordProperty("read_ahead_cache_size", QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE);
+    RecordProperty("draw_time_us", (int)(elapsed_us / iterations));
+    RecordProperty("flash_transactions_per_draw", (int)(mock_flash.transactions / iterations));
+    RecordProperty("flash_wire_bytes_per_draw", (int)(cached_wire_bytes / iterations));
+    RecordProperty("flash_wire_bytes_per_draw_without_read_ahead", (int)(uncached_wire_bytes / iterations));
+
+#if QUANTUM_PAINTER_FLASH_STREAM_CACHE_SIZE >= 32
+    EXPECT_LT(mock_flash.transactions * 8, uncached_transactions);
+    EXPECT_LT(cached_wire_bytes * 3, uncached_wire_bytes);
+#endif
+}
+
+} // namespace
@@ -0,0 +1,181 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "qgf_test_image.hpp"
+
+extern "C" {
+#include "qp.h"
+}
+
+namespace {
+
+// Each image converts to 8*16*2 = 256 bytes of RGB565 plus its frame table, so three fit within the configured
+// QUANTUM_PAINTER_IMAGE_CACHE_SIZE and a fourth does not.
+constexpr uint16_t IMAGE_WIDTH  = 8;
+constexpr uint16_t IMAGE_HEIGHT = 16;
+constexpr size_t   IMAGE_BYTES  = IMAGE_WIDTH * IMAGE_HEIGHT / 8;
+constexpr int      IMAGE_COUNT  = 4;
+
+static_assert(3 * IMAGE_WIDTH * IMAGE_HEIGHT * 2 < QUANTUM_PAINTER_IMAGE_CACHE_SIZE, "three test images must fit in the cache");
+static_assert(4 * IMAGE_WIDTH * IMAGE_HEIGHT * 2 >= QUANTUM_PAINTER_IMAGE_CACHE_SIZE, "four test images must not fit in the cache");
+
+constexpr uint16_t WHITE = 0xFFFF;
+constexpr uint16_t BLACK = 0x0000;
+
+uint16_t framebuffer[IMAGE_WIDTH * IMAGE_HEIGHT];
+
+// Whether an image was served from the cache is observed by rewriting its source pixels after caching it: a cached
+// draw still shows the pixels as they were when cached, whereas a decoded draw picks up the new source data.
+class QuantumPainterImageCache : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        surface = qp_rgb565_make_surface(IMAGE_WIDTH, IMAGE_HEIGHT, framebuffer);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        for (int i = 0; i < IMAGE_COUNT; ++i) {
+            sources[i] = make_mono_image(IMAGE_WIDTH, IMAGE_HEIGHT, std::vector<uint8_t>(IMAGE_BYTES, 0x00));
+            images[i]  = qp_load_image_mem(sources[i].data());
+            ASSERT_NE(images[i], nullptr);
+        }
+    }
+
+    void TearDown() override {
+        // Closing an image also releases any cached copy, so nothing leaks into the next test
+        for (int i = 0; i < IMAGE_COUNT; ++i) {
+            qp_close_image(images[i]);
+        }
+    }
+
+    // Rewrites every source pixel of an image; the pixel data block is always at the end of the QGF
+    void set_source(int index, uint8_t value) {
+        std::fill(sources[index].end() - IMAGE_BYTES, sources[index].end(), value);
+    }
+
+    // Caches an image, then blanks its source so that only a cached draw shows white
+    bool cache(int index) {
+        set_source(index, 0xFF);
+        bool ok = qp_cache_image(surface, images[index]);
+        set_source(index, 0x00);
+        return ok;
+    }
+
+    // Draws the image, marking it as most recently used if it's cached
+    uint16_t draw(int index) {
+        std::memset(framebuffer, 0x55, sizeof(framebuffer));
+        EXPECT_TRUE(qp_drawimage(surface, 0, 0, images[index]));
+        uint16_t native = framebuffer[0];
+        for (uint16_t pixel : framebuffer) {
+            EXPECT_EQ(pixel, native);
+        }
+        return native;
+    }
+
+    bool is_cached(int index) {
+        return draw(index) == WHITE;
+    }
+
+    static painter_device_t surface;
+    std::vector<uint8_t>    sources[IMAGE_COUNT];
+    painter_image_handle_t  images[IMAGE_COUNT];
+};
+
+painter_device_t QuantumPainterImageCache::surface = nullptr;
+
+} // namespace
+
+TEST_F(QuantumPainterImageCache, CachedImageIsNotDecodedAgain) {
+    EXPECT_EQ(draw(0), BLACK);
+    ASSERT_TRUE(cache(0));
+    EXPECT_EQ(draw(0), WHITE);
+    EXPECT_EQ(draw(1), BLACK);
+}
+
+TEST_F(QuantumPainterImageCache, FillingPastBudgetEvictsLeastRecentlyCached) {
+    ASSERT_TRUE(cache(0));
+    ASSERT_TRUE(cache(1));
+    ASSERT_TRUE(cache(2));
+    ASSERT_TRUE(cache(3));
+
+    EXPECT_FALSE(is_cached(0));
+    EXPECT_TRUE(is_cached(1));
+    EXPECT_TRUE(is_cached(2));
+    EXPECT_TRUE(is_cached(3));
+}
+
+TEST_F(QuantumPainterImageCache, DrawingRefreshesRecency) {
+    ASSERT_TRUE(cache(0));
+    ASSERT_TRUE(cache(1));
+    ASSERT_TRUE(cache(2));
+    ASSERT_TRUE(is_cached(0));
+    ASSERT_TRUE(cache(3));
+
+    EXPECT_TRUE(is_cached(0));
+    EXPECT_FALSE(is_cached(1));
+    EXPECT_TRUE(is_cached(2));
+    EXPECT_TRUE(is_cached(3));
+}
+
+TEST_F(QuantumPainterImageCache, RecachingRefreshesRecency) {
+    ASSERT_TRUE(cache(0));
+    ASSERT_TRUE(cache(1));
+    ASSERT_TRUE(cache(2));
+
+    // Already cached, so this only bumps recency; the blanked source must not be re-read
+    ASSERT_TRUE(qp_cache_image(surface, images[0]));
+    ASSERT_TRUE(cache(3));
+
+    EXPECT_TRUE(is_cached(0));
+    EXPECT_FALSE(is_cached(1));
+}
+
+TEST_F(QuantumPainterImageCache, EvictedImageIsReloaded) {
+    ASSERT_TRUE(cache(0));
+    ASSERT_TRUE(cache(1));
+    ASSERT_TRUE(cache(2));
+    ASSERT_TRUE(cache(3));
+    ASSERT_FALSE(is_cached(0));
+
+    // Reloading the evicted image pushes out the next least-recently-used one, and picks up the current source data
+    ASSERT_TRUE(cache(0));
+    EXPECT_TRUE(is_cached(0));
+    EXPECT_FALSE(is_cached(1));
+    EXPECT_TRUE(is_cached(2));
+    EXPECT_TRUE(is_cached(3));
+}
+
+TEST_F(QuantumPainterImageCache, UncacheFreesBudget) {
+    ASSERT_TRUE(cache(0));
+    ASSERT_TRUE(cache(1));
+    ASSERT_TRUE(cache(2));
+    qp_uncache_image(images[1]);
+    ASSERT_TRUE(cache(3));
+
+    EXPECT_TRUE(is_cached(0));
+    EXPECT_FALSE(is_cached(1));
+    EXPECT_TRUE(is_cached(2));
+    EXPECT_TRUE(is_cached(3));
+}
+
+TEST_F(QuantumPainterImageCache, OversizedImageIsRejectedWithoutEvicting) {
+    ASSERT_TRUE(cache(0));
+    ASSERT_TRUE(cache(1));
+    ASSERT_TRUE(cache(2));
+
+    constexpr uint16_t   large_size = 32; // 32*32*2 bytes exceeds the whole cache
+    std::vector<uint8_t> large      = make_mono_image(large_size, large_size, std::vector<uint8_t>(large_size * large_size / 8, 0xFF));
+    painter_image_handle_t large_image = qp_load_image_mem(large.data());
+    ASSERT_NE(large_image, nullptr);
+    EXPECT_FALSE(qp_cache_image(surface, large_image));
+    qp_close_image(large_image);
+
+    EXPECT_TRUE(is_cached(0));
+    EXPECT_TRUE(is_cached(1));
+    EXPECT_TRUE(is_cached(2));
+}
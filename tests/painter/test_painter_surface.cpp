@@ -0,0 +1,160 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+}
+
+namespace {
+
+constexpr uint16_t SURFACE_WIDTH  = 37; // odd width, so rows straddle 32-bit boundaries
+constexpr uint16_t SURFACE_HEIGHT = 23;
+
+uint16_t framebuffer_under_test[SURFACE_WIDTH * SURFACE_HEIGHT];
+uint16_t framebuffer_reference[SURFACE_WIDTH * SURFACE_HEIGHT];
+
+class QuantumPainterSurface : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        under_test = qp_rgb565_make_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffer_under_test);
+        reference  = qp_rgb565_make_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffer_reference);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(under_test, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(reference, QP_ROTATION_0));
+    }
+
+    // Determines the native pixel value for a color, using the non-accelerated single-pixel path.
+    static uint16_t native_color(uint8_t hue, uint8_t sat, uint8_t val) {
+        uint16_t saved = framebuffer_reference[0];
+        EXPECT_TRUE(qp_setpixel(reference, 0, 0, hue, sat, val));
+        uint16_t native          = framebuffer_reference[0];
+        framebuffer_reference[0] = saved;
+        return native;
+    }
+
+    // Fills the reference surface by streaming raw pixel data, i.e. without any accelerated operations.
+    static void reference_fill(uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint16_t native) {
+        std::vector<uint16_t> pixels((right - left + 1) * (bottom - top + 1), native);
+        ASSERT_TRUE(qp_viewport(reference, left, top, right, bottom));
+        ASSERT_TRUE(qp_pixdata(reference, pixels.data(), pixels.size()));
+    }
+
+    static void expect_framebuffers_equal() {
+        for (uint16_t y = 0; y < SURFACE_HEIGHT; ++y) {
+            for (uint16_t x = 0; x < SURFACE_WIDTH; ++x) {
+                ASSERT_EQ(framebuffer_under_test[y * SURFACE_WIDTH + x], framebuffer_reference[y * SURFACE_WIDTH + x]) << "mismatch at (" << x << ", " << y << ")";
+            }
+        }
+    }
+
+    static painter_device_t under_test;
+    static painter_device_t reference;
+};
+
+painter_device_t QuantumPainterSurface::under_test = nullptr;
+painter_device_t QuantumPainterSurface::reference  = nullptr;
+
+} // namespace
+
+TEST_F(QuantumPainterSurface, FilledRectMatchesPixdata) {
+    uint16_t native = native_color(85, 255, 255);
+
+    // Cover odd/even starting columns and widths to exercise the partial-word paths
+    for (uint16_t left = 0; left < 4; ++left) {
+        for (uint16_t width = 1; width < 6; ++width) {
+            ASSERT_TRUE(qp_rect(under_test, left, left + 2, left + width - 1, left + 5, 85, 255, 255, true));
+            reference_fill(left, left + 2, left + width - 1, left + 5, native);
+        }
+    }
+    expect_framebuffers_equal();
+}
+
+TEST_F(QuantumPainterSurface, FilledRectWithReversedCoordinates) {
+    uint16_t native = native_color(170, 255, 128);
+    ASSERT_TRUE(qp_rect(under_test, 30, 20, 3, 1, 170, 255, 128, true));
+    reference_fill(3, 1, 30, 20, native);
+    expect_framebuffers_equal();
+}
+
+TEST_F(QuantumPainterSurface, OutlineRectMatchesPixdata) {
+    uint16_t native = native_color(0, 255, 255);
+    ASSERT_TRUE(qp_rect(under_test, 5, 4, 20, 12, 0, 255, 255, false));
+    reference_fill(5, 4, 20, 4, native);
+    reference_fill(5, 12, 20, 12, native);
+    reference_fill(5, 5, 5, 11, native);
+    reference_fill(20, 5, 20, 11, native);
+    expect_framebuffers_equal();
+}
+
+TEST_F(QuantumPainterSurface, FillIsClippedToSurface) {
+    uint16_t native = native_color(42, 255, 255);
+    ASSERT_TRUE(qp_rect(under_test, SURFACE_WIDTH - 3, SURFACE_HEIGHT - 2, SURFACE_WIDTH + 10, SURFACE_HEIGHT + 10, 42, 255, 255, true));
+    reference_fill(SURFACE_WIDTH - 3, SURFACE_HEIGHT - 2, SURFACE_WIDTH - 1, SURFACE_HEIGHT - 1, native);
+    expect_framebuffers_equal();
+}
+
+TEST_F(QuantumPainterSurface, ClearBlanksAndMarksDirty) {
+    ASSERT_TRUE(qp_rect(under_test, 0, 0, SURFACE_WIDTH - 1, SURFACE_HEIGHT - 1, 128, 255, 255, true));
+    ASSERT_TRUE(qp_rgb565_surface_draw(under_test, reference, 0, 0));
+    expect_framebuffers_equal();
+
+    // Clearing must propagate to the target, which is only possible if the surface was marked dirty
+    ASSERT_TRUE(qp_clear(under_test));
+    for (auto px : framebuffer_under_test) {
+        ASSERT_EQ(px, 0);
+    }
+    ASSERT_TRUE(qp_rgb565_surface_draw(under_test, reference, 0, 0));
+    expect_framebuffers_equal();
+}
+
+TEST_F(QuantumPainterSurface, CopyRect) {
+    // Populate a recognisable pattern, mirroring it in a plain array as the expected output
+    std::vector<uint16_t> expected(SURFACE_WIDTH * SURFACE_HEIGHT);
+    for (uint16_t y = 0; y < SURFACE_HEIGHT; ++y) {
+        for (uint16_t x = 0; x < SURFACE_WIDTH; ++x) {
+            expected[y * SURFACE_WIDTH + x] = y * SURFACE_WIDTH + x + 1;
+        }
+    }
+    ASSERT_TRUE(qp_viewport(under_test, 0, 0, SURFACE_WIDTH - 1, SURFACE_HEIGHT - 1));
+    ASSERT_TRUE(qp_pixdata(under_test, expected.data(), expected.size()));
+
+    struct {
+        uint16_t l, t, r, b, x, y;
+    } copies[] = {
+        {0, 0, 9, 9, 20, 10},  // disjoint
+        {2, 2, 12, 12, 4, 5},  // overlapping, moving down/right
+        {6, 8, 16, 18, 3, 1},  // overlapping, moving up/left
+        {30, 0, 36, 5, 33, 20} // clipped by the surface edges
+    };
+
+    for (auto &c : copies) {
+        ASSERT_TRUE(qp_copyrect(under_test, c.l, c.t, c.r, c.b, c.x, c.y));
+
+        uint16_t              w = std::min<uint16_t>(c.r - c.l + 1, std::min<uint16_t>(SURFACE_WIDTH - c.l, SURFACE_WIDTH - c.x));
+        uint16_t              h = std::min<uint16_t>(c.b - c.t + 1, std::min<uint16_t>(SURFACE_HEIGHT - c.t, SURFACE_HEIGHT - c.y));
+        std::vector<uint16_t> source(expected);
+        for (uint16_t y = 0; y < h; ++y) {
+            for (uint16_t x = 0; x < w; ++x) {
+                expected[(c.y + y) * SURFACE_WIDTH + c.x + x] = source[(c.t + y) * SURFACE_WIDTH + c.l + x];
+            }
+        }
+    }
+
+    ASSERT_EQ(0, memcmp(framebuffer_under_test, expected.data(), sizeof(framebuffer_under_test)));
+
+    // Copied regions must be transferred when drawing the dirty area elsewhere
+    ASSERT_TRUE(qp_rgb565_surface_draw(under_test, reference, 0, 0));
+    expect_framebuffers_equal();
+}
+
+TEST_F(QuantumPainterSurface, ScrollUnsupported) {
+    EXPECT_FALSE(qp_scroll(under_test, 0, 0, 5));
+}
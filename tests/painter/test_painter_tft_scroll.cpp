@@ -0,0 +1,183 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_comms.h"
+#include "qp_tft_panel.h"
+}
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mock comms driver, recording each command along with the data sent after it
+
+constexpr uint8_t MIPI_DCS_SET_SCROLL_AREA  = 0x33;
+constexpr uint8_t MIPI_DCS_SET_SCROLL_START = 0x37;
+
+struct command_t {
+    uint8_t              cmd;
+    std::vector<uint8_t> data;
+};
+
+std::vector<command_t> commands;
+
+bool mock_comms_noop(painter_device_t device) {
+    return true;
+}
+
+void mock_comms_stop(painter_device_t device) {}
+
+uint32_t mock_comms_send(painter_device_t device, const void* data, uint32_t byte_count) {
+    const uint8_t* p = (const uint8_t*)data;
+    if (!commands.empty()) {
+        commands.back().data.insert(commands.back().data.end(), p, p + byte_count);
+    }
+    return byte_count;
+}
+
+void mock_comms_send_command(painter_device_t device, uint8_t cmd) {
+    commands.push_back({cmd, {}});
+}
+
+void mock_comms_bulk_command_sequence(painter_device_t device, const uint8_t* sequence, size_t sequence_len) {}
+
+const painter_comms_with_command_vtable_t mock_comms_vtable = {
+    .base =
+        {
+            .comms_init  = mock_comms_noop,
+            .comms_start = mock_comms_noop,
+            .comms_stop  = mock_comms_stop,
+            .comms_send  = mock_comms_send,
+        },
+    .send_command          = mock_comms_send_command,
+    .bulk_command_sequence = mock_comms_bulk_command_sequence,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// TFT panels with 320 rows of GRAM, like the ST7789, and without a known GRAM size
+
+tft_panel_dc_reset_painter_driver_vtable_t make_panel_vtable(uint16_t gram_height) {
+    tft_panel_dc_reset_painter_driver_vtable_t vtable = {};
+    vtable.base.scroll                                = qp_tft_panel_scroll;
+    vtable.num_window_bytes                           = 2;
+    vtable.gram_height                                = gram_height;
+    vtable.opcodes.set_scroll_area                    = MIPI_DCS_SET_SCROLL_AREA;
+    vtable.opcodes.set_scroll_start                   = MIPI_DCS_SET_SCROLL_START;
+    return vtable;
+}
+
+const tft_panel_dc_reset_painter_driver_vtable_t gram_320_vtable     = make_panel_vtable(320);
+const tft_panel_dc_reset_painter_driver_vtable_t gram_unknown_vtable = make_panel_vtable(0);
+
+struct scroll_registers_t {
+    uint16_t top_area;
+    uint16_t scroll_area;
+    uint16_t bottom_area;
+    uint16_t start_line;
+};
+
+class QuantumPainterTftScroll : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        commands.clear();
+    }
+
+    static void make_panel(const tft_panel_dc_reset_painter_driver_vtable_t* vtable, uint16_t width, uint16_t height, painter_rotation_t rotation, uint16_t offset_x, uint16_t offset_y) {
+        panel                            = {};
+        panel.base.driver_vtable         = (const painter_driver_vtable_t*)vtable;
+        panel.base.comms_vtable          = (const painter_comms_vtable_t*)&mock_comms_vtable;
+        panel.base.validate_ok           = true;
+        panel.base.panel_width           = width;
+        panel.base.panel_height          = height;
+        panel.base.rotation              = rotation;
+        panel.base.offset_x              = offset_x;
+        panel.base.offset_y              = offset_y;
+        panel.base.native_bits_per_pixel = 16;
+    }
+
+    static scroll_registers_t scroll(uint16_t top_fixed, uint16_t bottom_fixed, uint16_t scroll_offset) {
+        EXPECT_TRUE(qp_scroll(&panel, top_fixed, bottom_fixed, scroll_offset));
+        EXPECT_EQ(commands.size(), 2u);
+        if (commands.size() != 2 || commands[0].data.size() != 6 || commands[1].data.size() != 2) {
+            ADD_FAILURE() << "unexpected scroll command sequence";
+            return {};
+        }
+
+        EXPECT_EQ(commands[0].cmd, MIPI_DCS_SET_SCROLL_AREA);
+        EXPECT_EQ(commands[1].cmd, MIPI_DCS_SET_SCROLL_START);
+        const std::vector<uint8_t>& area  = commands[0].data;
+        const std::vector<uint8_t>& start = commands[1].data;
+        return {
+            .top_area    = (uint16_t)(area[0] << 8 | area[1]),
+            .scroll_area = (uint16_t)(area[2] << 8 | area[3]),
+            .bottom_area = (uint16_t)(area[4] << 8 | area[5]),
+            .start_line  = (uint16_t)(start[0] << 8 | start[1]),
+        };
+    }
+
+    static tft_panel_dc_reset_painter_device_t panel;
+};
+
+tft_panel_dc_reset_painter_device_t QuantumPainterTftScroll::panel;
+
+} // namespace
+
+TEST_F(QuantumPainterTftScroll, FullHeightPanel) {
+    make_panel(&gram_320_vtable, 240, 320, QP_ROTATION_0, 0, 0);
+    scroll_registers_t regs = scroll(10, 20, 5);
+    EXPECT_EQ(regs.top_area, 10);
+    EXPECT_EQ(regs.scroll_area, 290);
+    EXPECT_EQ(regs.bottom_area, 20);
+    EXPECT_EQ(regs.start_line, 15);
+}
+
+TEST_F(QuantumPainterTftScroll, UnusedGramRowsBelowPanel) {
+    // 240x240 ST7789 unrotated: visible rows are GRAM rows 0-239, leaving 80 unused rows at the bottom
+    make_panel(&gram_320_vtable, 240, 240, QP_ROTATION_0, 0, 0);
+    scroll_registers_t regs = scroll(10, 20, 5);
+    EXPECT_EQ(regs.top_area, 10);
+    EXPECT_EQ(regs.scroll_area, 210);
+    EXPECT_EQ(regs.bottom_area, 20 + 80);
+    EXPECT_EQ(regs.top_area + regs.scroll_area + regs.bottom_area, 320);
+    EXPECT_EQ(regs.start_line, 15);
+}
+
+TEST_F(QuantumPainterTftScroll, UnusedGramRowsAbovePanel) {
+    // 240x240 ST7789 rotated 180 degrees: visible rows are GRAM rows 80-319
+    make_panel(&gram_320_vtable, 240, 240, QP_ROTATION_180, 0, 80);
+    scroll_registers_t regs = scroll(10, 20, 5);
+    EXPECT_EQ(regs.top_area, 80 + 10);
+    EXPECT_EQ(regs.scroll_area, 210);
+    EXPECT_EQ(regs.bottom_area, 20);
+    EXPECT_EQ(regs.start_line, 80 + 10 + 5);
+}
+
+TEST_F(QuantumPainterTftScroll, SidewaysRotationUsesXOffset) {
+    // 240x240 ST7789 rotated 270 degrees: the x offset moves the panel along the GRAM rows
+    make_panel(&gram_320_vtable, 240, 240, QP_ROTATION_270, 80, 0);
+    scroll_registers_t regs = scroll(0, 0, 250);
+    EXPECT_EQ(regs.top_area, 80);
+    EXPECT_EQ(regs.scroll_area, 240);
+    EXPECT_EQ(regs.bottom_area, 0);
+    EXPECT_EQ(regs.start_line, 80 + 10);
+}
+
+TEST_F(QuantumPainterTftScroll, UnknownGramHeightAssumesPanelEndsGram) {
+    make_panel(&gram_unknown_vtable, 240, 240, QP_ROTATION_0, 0, 16);
+    scroll_registers_t regs = scroll(4, 8, 0);
+    EXPECT_EQ(regs.top_area, 16 + 4);
+    EXPECT_EQ(regs.scroll_area, 228);
+    EXPECT_EQ(regs.bottom_area, 8);
+    EXPECT_EQ(regs.start_line, 20);
+}
+
+TEST_F(QuantumPainterTftScroll, PanelLargerThanGramIsRejected) {
+    make_panel(&gram_320_vtable, 240, 240, QP_ROTATION_180, 0, 100);
+    EXPECT_FALSE(qp_scroll(&panel, 0, 0, 0));
+}
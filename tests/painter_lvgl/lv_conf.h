@@ -0,0 +1,11 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Matches the byte order of RGB565 surfaces, so LVGL renders straight into them
+#define LV_COLOR_DEPTH 16
+#define LV_COLOR_16_SWAP 1
+
+// Allocated from the heap, as the tests attach to displays of different sizes
+#define LV_MEM_CUSTOM 1
@@ -0,0 +1,8 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = rgb565_surface
+
+# Builds the LVGL submodule for the host, with lv_conf.h from this directory
+QUANTUM_PAINTER_LVGL_INTEGRATION = yes
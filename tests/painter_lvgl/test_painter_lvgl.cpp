@@ -0,0 +1,386 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_comms.h"
+#include "qp_lvgl.h"
+void advance_time(uint32_t ms);
+void qp_internal_task(void);
+}
+
+namespace {
+
+constexpr uint16_t PANEL_WIDTH  = 240;
+constexpr uint16_t PANEL_HEIGHT = 135;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mock comms driver
+//
+// Asynchronous transfers are held in flight until they're waited upon, and only then written into the panel's
+// framebuffer, so anything overwriting a draw buffer mid-transfer shows up as corrupted output. Transfers can also take
+// a simulated amount of bus time, for comparing how much of it is hidden behind rendering.
+
+struct mock_comms_t {
+    const uint8_t*                        in_flight;
+    uint32_t                              in_flight_bytes;
+    std::chrono::steady_clock::time_point bus_free;
+    uint32_t                              bus_ns_per_byte;
+    uint16_t                              left, top, right;
+    uint32_t                              window_pixels;
+    uint32_t                              received_pixels;
+    uint32_t                              sync_transfers;
+    uint32_t                              async_transfers;
+    uint32_t                              overlapped_transfers;
+    uint32_t                              ordering_violations;
+    bool                                  in_lvgl_wait;
+} mock;
+
+uint16_t panel_framebuffer[PANEL_WIDTH * PANEL_HEIGHT];
+uint16_t surface_framebuffer[PANEL_WIDTH * PANEL_HEIGHT];
+
+void mock_reset(void) {
+    mock = {};
+}
+
+void mock_bus_transfer(uint32_t byte_count) {
+    mock.bus_free = std::chrono::steady_clock::now() + std::chrono::nanoseconds((uint64_t)byte_count * mock.bus_ns_per_byte);
+}
+
+void mock_bus_wait(void) {
+    while (std::chrono::steady_clock::now() < mock.bus_free) {
+    }
+}
+
+// Writes pixels into the panel framebuffer, continuing where the previous transfer within the viewport left off
+void mock_receive(const uint8_t* data, uint32_t byte_count) {
+    uint16_t width = mock.right - mock.left + 1;
+    for (uint32_t i = 0; i < byte_count / sizeof(uint16_t); ++i, ++mock.window_pixels) {
+        uint16_t x = mock.left + mock.window_pixels % width;
+        uint16_t y = mock.top + mock.window_pixels / width;
+        std::memcpy(&panel_framebuffer[y * PANEL_WIDTH + x], data + i * sizeof(uint16_t), sizeof(uint16_t));
+    }
+    mock.received_pixels += byte_count / sizeof(uint16_t);
+}
+
+bool mock_comms_init(painter_device_t device) {
+    return true;
+}
+
+bool mock_comms_start(painter_device_t device) {
+    return true;
+}
+
+void mock_comms_stop(painter_device_t device) {
+    if (mock.in_flight) {
+        ++mock.ordering_violations;
+    }
+}
+
+uint32_t mock_comms_send(painter_device_t device, const void* data, uint32_t byte_count) {
+    if (mock.in_flight) {
+        ++mock.ordering_violations;
+    }
+    ++mock.sync_transfers;
+    mock_bus_transfer(byte_count);
+    mock_bus_wait();
+    mock_receive((const uint8_t*)data, byte_count);
+    return byte_count;
+}
+
+uint32_t mock_comms_send_async(painter_device_t device, const void* data, uint32_t byte_count) {
+    if (mock.in_flight) {
+        ++mock.ordering_violations;
+    }
+    ++mock.async_transfers;
+    mock.in_flight       = (const uint8_t*)data;
+    mock.in_flight_bytes = byte_count;
+    mock_bus_transfer(byte_count);
+    return byte_count;
+}
+
+void mock_comms_wait(painter_device_t device) {
+    if (!mock.in_flight) {
+        return;
+    }
+
+    // LVGL only waits on a draw buffer once it has rendered the next area into the other one
+    if (mock.in_lvgl_wait) {
+        ++mock.overlapped_transfers;
+    }
+
+    mock_bus_wait();
+    mock_receive(mock.in_flight, mock.in_flight_bytes);
+    mock.in_flight = nullptr;
+}
+
+void mock_comms_send_command(painter_device_t device, uint8_t cmd) {
+    if (mock.in_flight) {
+        ++mock.ordering_violations;
+    }
+}
+
+void mock_comms_bulk_command_sequence(painter_device_t device, const uint8_t* sequence, size_t sequence_len) {}
+
+const painter_comms_with_command_vtable_t mock_async_comms_vtable = {
+    .base =
+        {
+            .comms_init       = mock_comms_init,
+            .comms_start      = mock_comms_start,
+            .comms_stop       = mock_comms_stop,
+            .comms_send       = mock_comms_send,
+            .comms_send_async = mock_comms_send_async,
+            .comms_wait       = mock_comms_wait,
+        },
+    .send_command          = mock_comms_send_command,
+    .bulk_command_sequence = mock_comms_bulk_command_sequence,
+};
+
+const painter_comms_with_command_vtable_t mock_sync_comms_vtable = {
+    .base =
+        {
+            .comms_init  = mock_comms_init,
+            .comms_start = mock_comms_start,
+            .comms_stop  = mock_comms_stop,
+            .comms_send  = mock_comms_send,
+        },
+    .send_command          = mock_comms_send_command,
+    .bulk_command_sequence = mock_comms_bulk_command_sequence,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Minimal RGB565 panel driver using the mock comms
+
+bool mock_panel_noop(painter_device_t device) {
+    return true;
+}
+
+bool mock_panel_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+bool mock_panel_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+bool mock_panel_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    qp_comms_command(device, 0x2C);
+    mock.left          = left;
+    mock.top           = top;
+    mock.right         = right;
+    mock.window_pixels = 0;
+    return true;
+}
+
+bool mock_panel_pixdata(painter_device_t device, const void* pixel_data, uint32_t native_pixel_count) {
+    qp_comms_send(device, pixel_data, native_pixel_count * sizeof(uint16_t));
+    return true;
+}
+
+bool mock_panel_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t* palette) {
+    return true;
+}
+
+bool mock_panel_append_pixels(painter_device_t device, uint8_t* target_buffer, qp_pixel_t* palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t* palette_indices) {
+    return true;
+}
+
+bool mock_panel_append_pixdata(painter_device_t device, uint8_t* target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    return true;
+}
+
+const painter_driver_vtable_t mock_panel_vtable = {
+    .init            = mock_panel_init,
+    .power           = mock_panel_power,
+    .clear           = mock_panel_noop,
+    .flush           = mock_panel_noop,
+    .viewport        = mock_panel_viewport,
+    .pixdata         = mock_panel_pixdata,
+    .palette_convert = mock_panel_palette_convert,
+    .append_pixels   = mock_panel_append_pixels,
+    .append_pixdata  = mock_panel_append_pixdata,
+};
+
+painter_driver_t mock_panel;
+painter_device_t surface;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LVGL helpers
+
+void (*lvgl_wait_cb)(lv_disp_drv_t* disp_drv);
+
+// Lets the mock tell waits issued by LVGL, before it reuses a draw buffer, apart from the integration's own
+void tracking_wait_cb(lv_disp_drv_t* disp_drv) {
+    mock.in_lvgl_wait = true;
+    lvgl_wait_cb(disp_drv);
+    mock.in_lvgl_wait = false;
+}
+
+void attach(painter_device_t device) {
+    ASSERT_TRUE(qp_init(device, QP_ROTATION_0));
+    ASSERT_TRUE(qp_lvgl_attach(device));
+    lv_disp_drv_t* disp_drv = lv_disp_get_default()->driver;
+    lvgl_wait_cb            = disp_drv->wait_cb;
+    disp_drv->wait_cb       = tracking_wait_cb;
+}
+
+// A rounded box with a label on a plain background, returning the label
+lv_obj_t* build_scene(void) {
+    lv_obj_t* screen = lv_scr_act();
+    lv_obj_set_style_bg_color(screen, lv_color_make(0x20, 0x40, 0x80), 0);
+
+    lv_obj_t* box = lv_obj_create(screen);
+    lv_obj_set_size(box, 140, 70);
+    lv_obj_center(box);
+    lv_obj_set_style_radius(box, 12, 0);
+    lv_obj_set_style_bg_color(box, lv_color_make(0xF0, 0x80, 0x10), 0);
+
+    lv_obj_t* label = lv_label_create(box);
+    lv_label_set_text(label, "QMK");
+    lv_obj_center(label);
+    return label;
+}
+
+// Runs the Quantum Painter task, and with it LVGL's, which releases the display once LVGL is done
+void run_tasks(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; ++i) {
+        advance_time(1);
+        qp_internal_task();
+    }
+}
+
+void render(void) {
+    lv_refr_now(NULL);
+    run_tasks(10);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class QuantumPainterLvgl : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        surface = qp_rgb565_make_surface(PANEL_WIDTH, PANEL_HEIGHT, surface_framebuffer);
+    }
+
+    void SetUp() override {
+        mock_panel                       = {};
+        mock_panel.driver_vtable         = &mock_panel_vtable;
+        mock_panel.comms_vtable          = (const painter_comms_vtable_t*)&mock_async_comms_vtable;
+        mock_panel.panel_width           = PANEL_WIDTH;
+        mock_panel.panel_height          = PANEL_HEIGHT;
+        mock_panel.native_bits_per_pixel = 16;
+        ASSERT_TRUE(qp_init(&mock_panel, QP_ROTATION_0));
+        std::memset(panel_framebuffer, 0, sizeof(panel_framebuffer));
+        std::memset(surface_framebuffer, 0, sizeof(surface_framebuffer));
+        mock_reset();
+    }
+
+    void TearDown() override {
+        qp_lvgl_detach();
+        EXPECT_EQ(mock.in_flight, nullptr) << "transfer still in flight after LVGL released the display";
+        EXPECT_EQ(mock.ordering_violations, 0u);
+    }
+};
+
+} // namespace
+
+TEST_F(QuantumPainterLvgl, DualBuffersOverlapTransfersWithRendering) {
+    attach(&mock_panel);
+    build_scene();
+    render();
+
+    // Every area but the last was still being sent while LVGL rendered the next one into the other buffer
+    EXPECT_EQ(mock.sync_transfers, 0u);
+    EXPECT_GT(mock.async_transfers, 1u);
+    EXPECT_EQ(mock.overlapped_transfers, mock.async_transfers - 1);
+    EXPECT_EQ(mock.received_pixels, PANEL_WIDTH * PANEL_HEIGHT);
+}
+
+TEST_F(QuantumPainterLvgl, DualBufferedOutputMatchesDirectMode) {
+    attach(surface);
+    build_scene();
+    render();
+    qp_lvgl_detach();
+    EXPECT_EQ(mock.received_pixels, 0u) << "direct mode should only render into the surface";
+
+    attach(&mock_panel);
+    build_scene();
+    render();
+
+    ASSERT_EQ(mock.received_pixels, PANEL_WIDTH * PANEL_HEIGHT);
+    for (uint16_t y = 0; y < PANEL_HEIGHT; ++y) {
+        for (uint16_t x = 0; x < PANEL_WIDTH; ++x) {
+            ASSERT_EQ(panel_framebuffer[y * PANEL_WIDTH + x], surface_framebuffer[y * PANEL_WIDTH + x]) << "mismatch at (" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST_F(QuantumPainterLvgl, DirectModeMarksRenderedAreasDirty) {
+    attach(surface);
+    lv_obj_t* label = build_scene();
+    render();
+
+    // The first frame covers the whole screen
+    ASSERT_TRUE(qp_rgb565_surface_draw(surface, &mock_panel, 0, 0));
+    EXPECT_EQ(mock.received_pixels, PANEL_WIDTH * PANEL_HEIGHT);
+    EXPECT_EQ(std::memcmp(panel_framebuffer, surface_framebuffer, sizeof(panel_framebuffer)), 0);
+
+    // Nothing changed, so nothing is sent
+    mock.received_pixels = 0;
+    render();
+    ASSERT_TRUE(qp_rgb565_surface_draw(surface, &mock_panel, 0, 0));
+    EXPECT_EQ(mock.received_pixels, 0u);
+
+    // Only the area around the label is sent
+    lv_label_set_text(label, "LVGL");
+    render();
+    ASSERT_TRUE(qp_rgb565_surface_draw(surface, &mock_panel, 0, 0));
+    EXPECT_GT(mock.received_pixels, 0u);
+    EXPECT_LT(mock.received_pixels, PANEL_WIDTH * PANEL_HEIGHT / 4);
+    EXPECT_EQ(std::memcmp(panel_framebuffer, surface_framebuffer, sizeof(panel_framebuffer)), 0);
+}
+
+/* Not a pass/fail test; run with --gtest_also_run_disabled_tests to compare the flush modes over a simulated bus */
+TEST_F(QuantumPainterLvgl, DISABLED_frame_cost) {
+    const unsigned frames = 20;
+
+    // Roughly a 40MHz SPI bus
+    mock.bus_ns_per_byte = 200;
+
+    struct {
+        const char*      name;
+        painter_device_t device;
+        const void*      comms_vtable;
+    } modes[] = {
+        {"single transfers", &mock_panel, &mock_sync_comms_vtable},
+        {"dual buffers", &mock_panel, &mock_async_comms_vtable},
+        {"direct mode", surface, &mock_async_comms_vtable},
+    };
+
+    for (auto& mode : modes) {
+        mock_panel.comms_vtable = (const painter_comms_vtable_t*)mode.comms_vtable;
+        ASSERT_TRUE(qp_init(&mock_panel, QP_ROTATION_0));
+        attach(mode.device);
+        build_scene();
+        render();
+
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < frames; ++i) {
+            lv_obj_invalidate(lv_scr_act());
+            render();
+            if (mode.device == surface) {
+                ASSERT_TRUE(qp_rgb565_surface_draw(surface, &mock_panel, 0, 0));
+            }
+        }
+        double frame = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+        printf("%-16s %6.2fms per frame\n", mode.name, frame);
+        qp_lvgl_detach();
+    }
+}
@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 120
+#define RGB_MATRIX_CURRENT_LIMIT 500
+#define RGB_MATRIX_CHANNEL_CURRENT 20
+
+#define ENABLE_RGB_MATRIX_SOLID_COLOR
@@ -0,0 +1,178 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "led_tables.h"
+
+void rgb_matrix_update_pwm_buffers(void);
+}
+
+using testing::_;
+
+// 40 keys, and 80 underglow LEDs that aren't on the matrix
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {{0, 0}, {12, 0}, {24, 0}, {35, 0}, {47, 0}, {59, 0}, {71, 0}, {83, 0}, {94, 0}, {106, 0}, {118, 0}, {130, 0}, {141, 0}, {153, 0}, {165, 0}, {177, 0}, {189, 0}, {200, 0}, {212, 0}, {224, 0}, {0, 13}, {12, 13}, {24, 13}, {35, 13}, {47, 13}, {59, 13}, {71, 13}, {83, 13}, {94, 13}, {106, 13}, {118, 13}, {130, 13}, {141, 13}, {153, 13}, {165, 13}, {177, 13}, {189, 13}, {200, 13}, {212, 13}, {224, 13}, {0, 26}, {12, 26}, {24, 26}, {35, 26}, {47, 26}, {59, 26}, {71, 26}, {83, 26}, {94, 26}, {106, 26}, {118, 26}, {130, 26}, {141, 26}, {153, 26}, {165, 26}, {177, 26}, {189, 26}, {200, 26}, {212, 26}, {224, 26}, {0, 38}, {12, 38}, {24, 38}, {35, 38}, {47, 38}, {59, 38}, {71, 38}, {83, 38}, {94, 38}, {106, 38}, {118, 38}, {130, 38}, {141, 38}, {153, 38}, {165, 38}, {177, 38}, {189, 38}, {200, 38}, {212, 38}, {224, 38}, {0, 51}, {12, 51}, {24, 51}, {35, 51}, {47, 51}, {59, 51}, {71, 51}, {83, 51}, {94, 51}, {106, 51}, {118, 51}, {130, 51}, {141, 51}, {153, 51}, {165, 51}, {177, 51}, {189, 51}, {200, 51}, {212, 51}, {224, 51}, {0, 64}, {12, 64}, {24, 64}, {35, 64}, {47, 64}, {59, 64}, {71, 64}, {83, 64}, {94, 64}, {106, 64}, {118, 64}, {130, 64}, {141, 64}, {153, 64}, {165, 64}, {177, 64}, {189, 64}, {200, 64}, {212, 64}, {224, 64}},
+    {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+};
+
+// What the LEDs would draw, worked out from scratch
+static uint32_t frame_level(const uint8_t (*frame)[3]) {
+    uint32_t level = 0;
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        level += frame[i][0] + frame[i][1] + frame[i][2];
+    }
+    return level;
+}
+
+static double frame_current(const uint8_t (*frame)[3]) {
+    return frame_level(frame) * RGB_MATRIX_CHANNEL_CURRENT / 255.0;
+}
+
+class CurrentLimit : public TestFixture {
+   protected:
+    uint8_t frame[RGB_MATRIX_LED_COUNT][3];
+
+    void SetUp() override {
+        rgb_matrix_set_color_all(0, 0, 0);
+        rgb_matrix_update_pwm_buffers();
+    }
+
+    // Writes a random frame, going over some LEDs several times as indicators would
+    void random_frame(unsigned lit_percent) {
+        for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            bool lit = (unsigned)(rand() % 100) < lit_percent;
+            for (int c = 0; c < 3; c++) {
+                frame[i][c] = lit ? rand() % 256 : 0;
+            }
+        }
+        for (int pass = 0; pass < 3; pass++) {
+            for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+                if (pass == 2 || rand() % 2) {
+                    rgb_matrix_set_color(i, pass == 2 ? frame[i][0] : rand() % 256, pass == 2 ? frame[i][1] : rand() % 256, pass == 2 ? frame[i][2] : rand() % 256);
+                }
+            }
+        }
+    }
+};
+
+TEST_F(CurrentLimit, estimate_follows_every_write) {
+    srand(1);
+    for (unsigned lit_percent : {0u, 5u, 20u, 50u, 100u}) {
+        for (int n = 0; n < 20; n++) {
+            random_frame(lit_percent);
+            uint32_t expected = (frame_level(frame) * RGB_MATRIX_CHANNEL_CURRENT + 254) / 255;
+            EXPECT_EQ(rgb_matrix_get_current_estimate(), expected) << lit_percent << "% lit, frame " << n;
+        }
+    }
+
+    rgb_matrix_set_color_all(255, 255, 255);
+    EXPECT_EQ(rgb_matrix_get_current_estimate(), RGB_MATRIX_LED_COUNT * 3 * RGB_MATRIX_CHANNEL_CURRENT);
+    rgb_matrix_set_color_all(10, 0, 0);
+    EXPECT_EQ(rgb_matrix_get_current_estimate(), (RGB_MATRIX_LED_COUNT * 10 * RGB_MATRIX_CHANNEL_CURRENT + 254) / 255);
+}
+
+TEST_F(CurrentLimit, frames_within_budget_are_untouched) {
+    srand(2);
+    for (int n = 0; n < 50; n++) {
+        random_frame(5);
+        ASSERT_LE(frame_current(frame), RGB_MATRIX_CURRENT_LIMIT);
+        rgb_matrix_update_pwm_buffers();
+
+        EXPECT_FALSE(rgb_matrix_is_current_limited());
+        EXPECT_EQ(memcmp(test_rgb_matrix_leds, frame, sizeof(test_rgb_matrix_leds)), 0) << "frame " << n;
+    }
+}
+
+TEST_F(CurrentLimit, frames_over_budget_are_dimmed_evenly) {
+    srand(3);
+    for (int n = 0; n < 50; n++) {
+        random_frame(40 + n);
+        ASSERT_GT(frame_current(frame), RGB_MATRIX_CURRENT_LIMIT);
+        rgb_matrix_update_pwm_buffers();
+
+        EXPECT_TRUE(rgb_matrix_is_current_limited());
+        // Under the budget, but not by more than rounding down each channel costs
+        EXPECT_LE(frame_current(test_rgb_matrix_leds), RGB_MATRIX_CURRENT_LIMIT) << "frame " << n;
+        EXPECT_GT(frame_current(test_rgb_matrix_leds), RGB_MATRIX_CURRENT_LIMIT - RGB_MATRIX_LED_COUNT * 3 * RGB_MATRIX_CHANNEL_CURRENT / 255.0 - 1) << "frame " << n;
+
+        // Every channel is scaled by the same amount, so colors keep their hue
+        uint16_t scale = 256;
+        for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            for (int c = 0; c < 3; c++) {
+                if (frame[i][c] > 128) {
+                    scale = MIN(scale, (test_rgb_matrix_leds[i][c] + 1) * 256 / frame[i][c]);
+                }
+            }
+        }
+        for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            for (int c = 0; c < 3; c++) {
+                EXPECT_NEAR(test_rgb_matrix_leds[i][c], frame[i][c] * scale >> 8, 1) << "frame " << n << ", LED " << i;
+            }
+        }
+    }
+}
+
+TEST_F(CurrentLimit, full_brightness_is_restored_once_within_budget) {
+    rgb_matrix_set_color_all(255, 255, 255);
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_TRUE(rgb_matrix_is_current_limited());
+    EXPECT_LT(test_rgb_matrix_leds[0][0], 255);
+
+    // Only a few LEDs are written again, the rest must go back to full brightness too
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i += 2) {
+        rgb_matrix_set_color(i, 0, 0, 0);
+    }
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_TRUE(rgb_matrix_is_current_limited());
+
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (i % 20 != 1) {
+            rgb_matrix_set_color(i, 0, 0, 0);
+        }
+    }
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_FALSE(rgb_matrix_is_current_limited());
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t expected = i % 20 == 1 ? 255 : 0;
+        EXPECT_EQ(test_rgb_matrix_leds[i][0], expected) << "LED " << i;
+        EXPECT_EQ(test_rgb_matrix_leds[i][1], expected) << "LED " << i;
+        EXPECT_EQ(test_rgb_matrix_leds[i][2], expected) << "LED " << i;
+    }
+}
+
+TEST_F(CurrentLimit, effects_are_limited) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 0, 255);
+    size_t first = test_rgb_matrix_frames.size();
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    EXPECT_GT(test_rgb_matrix_frames.size(), first);
+
+    // White at full brightness would draw 7.2A, so it is brought down to 500mA
+    EXPECT_EQ(rgb_matrix_get_current_estimate(), RGB_MATRIX_LED_COUNT * 3 * RGB_MATRIX_CHANNEL_CURRENT);
+    EXPECT_TRUE(rgb_matrix_is_current_limited());
+    EXPECT_LE(frame_current(test_rgb_matrix_leds), RGB_MATRIX_CURRENT_LIMIT);
+    uint16_t scale = RGB_MATRIX_CURRENT_LIMIT * 255 * 256 / (RGB_MATRIX_LED_COUNT * 3 * 255 * RGB_MATRIX_CHANNEL_CURRENT);
+    EXPECT_EQ(test_rgb_matrix_leds[0][0], 255 * scale >> 8);
+
+    // A dim color fits, and is shown as it is
+    rgb_matrix_sethsv_noeeprom(0, 0, 40);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    EXPECT_FALSE(rgb_matrix_is_current_limited());
+    EXPECT_EQ(test_rgb_matrix_leds[0][0], pgm_read_byte(&CIE1931_CURVE[40]));
+}
@@ -0,0 +1,13 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 40
+#define RGB_MATRIX_OUTPUT_LUT
+#define RGB_MATRIX_WHITE_BALANCE \
+    { 255, 200, 128 }
+
+#define ENABLE_RGB_MATRIX_CYCLE_LEFT_RIGHT
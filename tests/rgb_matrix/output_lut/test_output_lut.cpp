@@ -0,0 +1,121 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "led_tables.h"
+void advance_time(uint32_t ms);
+}
+
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {{0, 0}, {24, 0}, {49, 0}, {74, 0}, {99, 0}, {124, 0}, {149, 0}, {174, 0}, {199, 0}, {224, 0}, {0, 21}, {24, 21}, {49, 21}, {74, 21}, {99, 21}, {124, 21}, {149, 21}, {174, 21}, {199, 21}, {224, 21}, {0, 42}, {24, 42}, {49, 42}, {74, 42}, {99, 42}, {124, 42}, {149, 42}, {174, 42}, {199, 42}, {224, 42}, {0, 64}, {24, 64}, {49, 64}, {74, 64}, {99, 64}, {124, 64}, {149, 64}, {174, 64}, {199, 64}, {224, 64}},
+    {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4},
+};
+
+class OutputLut : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgb_matrix_set_white_balance(255, 200, 128);
+    }
+};
+
+TEST_F(OutputLut, follows_curve_scaled_by_white_balance) {
+    const uint8_t balance[3] = {255, 200, 128};
+
+    for (uint8_t channel = 0; channel < 3; channel++) {
+        for (int value = 0; value < 256; value++) {
+            uint8_t level = pgm_read_byte(&CIE1931_CURVE[value]);
+            EXPECT_EQ(rgb_matrix_get_output_level(channel, value), level * (balance[channel] + 1) >> 8) << "channel " << (int)channel << ", value " << value;
+        }
+    }
+
+    /* Full balance leaves the curve untouched at both ends */
+    EXPECT_EQ(rgb_matrix_get_output_level(0, 0), 0);
+    EXPECT_EQ(rgb_matrix_get_output_level(0, 255), 255);
+}
+
+TEST_F(OutputLut, is_monotonic) {
+    for (uint8_t channel = 0; channel < 3; channel++) {
+        for (int value = 1; value < 256; value++) {
+            EXPECT_GE(rgb_matrix_get_output_level(channel, value), rgb_matrix_get_output_level(channel, value - 1));
+        }
+    }
+}
+
+TEST_F(OutputLut, is_rebuilt_when_white_balance_changes) {
+    rgb_matrix_set_white_balance(128, 128, 128);
+    for (uint8_t channel = 0; channel < 3; channel++) {
+        EXPECT_EQ(rgb_matrix_get_output_level(channel, 255), 128);
+        EXPECT_EQ(rgb_matrix_get_output_level(channel, 0), 0);
+    }
+
+    rgb_matrix_set_white_balance(0, 255, 255);
+    EXPECT_EQ(rgb_matrix_get_output_level(0, 255), 0);
+    EXPECT_EQ(rgb_matrix_get_output_level(1, 255), 255);
+}
+
+TEST_F(OutputLut, applies_to_every_write) {
+    rgb_matrix_set_color(3, 255, 255, 255);
+    EXPECT_EQ(test_rgb_matrix_leds[3][0], 255);
+    EXPECT_EQ(test_rgb_matrix_leds[3][1], 200);
+    EXPECT_EQ(test_rgb_matrix_leds[3][2], 128);
+
+    rgb_matrix_set_color_all(128, 128, 128);
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(test_rgb_matrix_leds[i][0], rgb_matrix_get_output_level(0, 128));
+        EXPECT_EQ(test_rgb_matrix_leds[i][1], rgb_matrix_get_output_level(1, 128));
+        EXPECT_EQ(test_rgb_matrix_leds[i][2], rgb_matrix_get_output_level(2, 128));
+    }
+}
+
+TEST_F(OutputLut, effects_write_linear_values) {
+    TestDriver driver;
+
+    /* A grey is written as is by the effect, and only then put through the curve once */
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 0, 128);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+
+    EXPECT_EQ(test_rgb_matrix_leds[0][0], pgm_read_byte(&CIE1931_CURVE[128]));
+    EXPECT_EQ(test_rgb_matrix_leds[0][1], pgm_read_byte(&CIE1931_CURVE[128]) * 201 >> 8);
+    EXPECT_EQ(test_rgb_matrix_leds[0][2], pgm_read_byte(&CIE1931_CURVE[128]) * 129 >> 8);
+}
+
+/* Not a pass/fail test; run with --gtest_also_run_disabled_tests to time the LUT */
+TEST_F(OutputLut, DISABLED_render_cost) {
+    TestDriver     driver;
+    const unsigned frames = 20000;
+
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+
+    test_rgb_matrix_frames.clear();
+    auto start = std::chrono::steady_clock::now();
+    while (test_rgb_matrix_frames.size() < frames) {
+        rgb_matrix_task();
+        advance_time(1);
+    }
+    double frame = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < 1000; i++) {
+        rgb_matrix_set_white_balance(255, 200, i);
+    }
+    double rebuild = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / 1000;
+
+    printf("%d LEDs: %.1fns per frame, %.1fns per LUT rebuild\n", RGB_MATRIX_LED_COUNT, frame, rebuild);
+}
@@ -0,0 +1,368 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <vector>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "action_layer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+// 40 keys, and 80 underglow LEDs that aren't on the matrix
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {{0, 0}, {12, 0}, {24, 0}, {35, 0}, {47, 0}, {59, 0}, {71, 0}, {83, 0}, {94, 0}, {106, 0}, {118, 0}, {130, 0}, {141, 0}, {153, 0}, {165, 0}, {177, 0}, {189, 0}, {200, 0}, {212, 0}, {224, 0}, {0, 13}, {12, 13}, {24, 13}, {35, 13}, {47, 13}, {59, 13}, {71, 13}, {83, 13}, {94, 13}, {106, 13}, {118, 13}, {130, 13}, {141, 13}, {153, 13}, {165, 13}, {177, 13}, {189, 13}, {200, 13}, {212, 13}, {224, 13}, {0, 26}, {12, 26}, {24, 26}, {35, 26}, {47, 26}, {59, 26}, {71, 26}, {83, 26}, {94, 26}, {106, 26}, {118, 26}, {130, 26}, {141, 26}, {153, 26}, {165, 26}, {177, 26}, {189, 26}, {200, 26}, {212, 26}, {224, 26}, {0, 38}, {12, 38}, {24, 38}, {35, 38}, {47, 38}, {59, 38}, {71, 38}, {83, 38}, {94, 38}, {106, 38}, {118, 38}, {130, 38}, {141, 38}, {153, 38}, {165, 38}, {177, 38}, {189, 38}, {200, 38}, {212, 38}, {224, 38}, {0, 51}, {12, 51}, {24, 51}, {35, 51}, {47, 51}, {59, 51}, {71, 51}, {83, 51}, {94, 51}, {106, 51}, {118, 51}, {130, 51}, {141, 51}, {153, 51}, {165, 51}, {177, 51}, {189, 51}, {200, 51}, {212, 51}, {224, 51}, {0, 64}, {12, 64}, {24, 64}, {35, 64}, {47, 64}, {59, 64}, {71, 64}, {83, 64}, {94, 64}, {106, 64}, {118, 64}, {130, 64}, {141, 64}, {153, 64}, {165, 64}, {177, 64}, {189, 64}, {200, 64}, {212, 64}, {224, 64}},
+    {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+};
+
+static uint8_t caps_lock(void) {
+    led_t state     = {};
+    state.caps_lock = true;
+    return state.raw;
+}
+
+enum { CAPS_OVERLAY, LAYER_OVERLAY, MARKER_OVERLAY, TINT_OVERLAY };
+
+/* The same drawing is done either as indicators, over every render iteration, or as overlays */
+static bool     use_indicators;
+static bool     marker_enabled;
+static unsigned indicator_calls;
+static unsigned overlay_calls;
+static uint8_t  indicator_min, indicator_max;
+
+static void indicator_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t led_min = indicator_min, led_max = indicator_max;
+    RGB_MATRIX_INDICATOR_SET_COLOR(index, r, g, b);
+}
+
+static void draw(uint8_t overlay, void (*set)(int, uint8_t, uint8_t, uint8_t)) {
+    switch (overlay) {
+        case CAPS_OVERLAY:
+            if (host_keyboard_led_state().caps_lock) {
+                for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+                    if (HAS_FLAGS(g_led_config.flags[i], LED_FLAG_KEYLIGHT) && i >= 10 && i < 20) {
+                        set(i, RGB_RED);
+                    }
+                }
+            }
+            break;
+        case LAYER_OVERLAY:
+            for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+                switch (get_highest_layer(layer_state | default_layer_state)) {
+                    case 2:
+                        if (HAS_FLAGS(g_led_config.flags[i], LED_FLAG_UNDERGLOW)) {
+                            set(i, RGB_YELLOW);
+                        }
+                        break;
+                    case 1:
+                        if (i % 3 == 0) {
+                            set(i, RGB_BLUE);
+                        }
+                        break;
+                }
+            }
+            break;
+        case MARKER_OVERLAY:
+            // Overlaps both of the others
+            set(12, RGB_WHITE);
+            set(45, RGB_WHITE);
+            break;
+    }
+}
+
+extern "C" {
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    indicator_calls++;
+    if (use_indicators) {
+        indicator_min = led_min;
+        indicator_max = led_max;
+        draw(CAPS_OVERLAY, indicator_set_color);
+        draw(LAYER_OVERLAY, indicator_set_color);
+        if (marker_enabled) {
+            draw(MARKER_OVERLAY, indicator_set_color);
+        }
+    }
+    return false;
+}
+
+bool rgb_matrix_overlay_user(uint8_t overlay) {
+    overlay_calls++;
+    if (overlay == TINT_OVERLAY) {
+        rgb_matrix_overlay_set_color_all(RGB_GREEN);
+    } else {
+        draw(overlay, rgb_matrix_overlay_set_color);
+    }
+    return false;
+}
+}
+
+class Overlays : public TestFixture {
+   protected:
+    void SetUp() override {
+        use_indicators = false;
+        marker_enabled = false;
+        for (uint8_t overlay = 0; overlay < RGB_MATRIX_MAX_OVERLAYS; overlay++) {
+            rgb_matrix_set_overlay_state(overlay, false);
+            rgb_matrix_set_overlay_alpha(overlay, UINT8_MAX);
+        }
+        rgb_matrix_set_flags_noeeprom(LED_FLAG_ALL);
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(HSV_PURPLE);
+        layer_clear();
+    }
+
+    void set_marker(bool enabled) {
+        marker_enabled = enabled;
+        rgb_matrix_set_overlay_state(MARKER_OVERLAY, enabled);
+    }
+
+    void settle(uint8_t mode) {
+        rgb_matrix_mode_noeeprom(mode);
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    }
+
+    // Renders and flushes whole frames
+    void run_frames(unsigned count) {
+        for (unsigned n = 0; n < count; n++) {
+            advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+            size_t flushed = test_rgb_matrix_frames.size();
+            while (test_rgb_matrix_frames.size() == flushed) {
+                rgb_matrix_task();
+            }
+        }
+    }
+
+    // Switches the indicators on and off over an effect, and records every frame. Changes are
+    // made between frames, as overlays are only redrawn as a frame starts, while indicators
+    // would pick them up halfway through one.
+    std::vector<Frame> record(TestDriver &driver, uint8_t mode) {
+        settle(RGB_MATRIX_NONE);
+        set_time(100000);
+        test_rgb_matrix_frames.clear();
+        rgb_matrix_mode_noeeprom(mode);
+        run_frames(8);
+        driver.set_leds(caps_lock());
+        run_frames(8);
+        layer_on(1);
+        run_frames(8);
+        set_marker(true);
+        run_frames(8);
+        layer_on(2);
+        run_frames(8);
+        driver.set_leds(0);
+        run_frames(8);
+        layer_off(2);
+        set_marker(false);
+        run_frames(8);
+        layer_off(1);
+        run_frames(8);
+        return test_rgb_matrix_frames;
+    }
+};
+
+TEST_F(Overlays, replace_overlays_match_indicators) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    for (uint8_t mode : {RGB_MATRIX_SOLID_COLOR, RGB_MATRIX_BREATHING, RGB_MATRIX_CYCLE_LEFT_RIGHT, RGB_MATRIX_RAINBOW_MOVING_CHEVRON}) {
+        use_indicators            = true;
+        std::vector<Frame> expect = record(driver, mode);
+
+        use_indicators = false;
+        rgb_matrix_set_overlay_state(CAPS_OVERLAY, true);
+        rgb_matrix_set_overlay_state(LAYER_OVERLAY, true);
+        std::vector<Frame> actual = record(driver, mode);
+        rgb_matrix_set_overlay_state(CAPS_OVERLAY, false);
+        rgb_matrix_set_overlay_state(LAYER_OVERLAY, false);
+
+        ASSERT_GT(expect.size(), 50u);
+        ASSERT_EQ(actual.size(), expect.size()) << "mode " << (int)mode;
+        for (size_t n = 0; n < expect.size(); n++) {
+            ASSERT_EQ(actual[n], expect[n]) << "mode " << (int)mode << ", frame " << n;
+        }
+    }
+}
+
+TEST_F(Overlays, overlays_are_only_drawn_when_they_change) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    rgb_matrix_set_overlay_state(CAPS_OVERLAY, true);
+    rgb_matrix_set_overlay_state(LAYER_OVERLAY, true);
+    settle(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+
+    // Indicators run on every render iteration, overlays not at all
+    overlay_calls   = 0;
+    indicator_calls = 0;
+    size_t flushed  = test_rgb_matrix_frames.size();
+    idle_for(1000);
+    EXPECT_GE(test_rgb_matrix_frames.size() - flushed, 1000u / (RGB_MATRIX_LED_FLUSH_LIMIT + 8));
+    EXPECT_GE(indicator_calls, (test_rgb_matrix_frames.size() - flushed) * RGB_MATRIX_LED_PROCESS_MAX_ITERATIONS);
+    EXPECT_EQ(overlay_calls, 0u);
+
+    // Each enabled overlay is drawn once for every change
+    layer_on(1);
+    idle_for(500);
+    EXPECT_EQ(overlay_calls, 2u);
+    driver.set_leds(caps_lock());
+    idle_for(500);
+    EXPECT_EQ(overlay_calls, 4u);
+    set_marker(true);
+    idle_for(500);
+    EXPECT_EQ(overlay_calls, 7u);
+    rgb_matrix_overlays_changed();
+    idle_for(500);
+    EXPECT_EQ(overlay_calls, 10u);
+
+    // Settings that change nothing don't redraw them
+    set_marker(true);
+    rgb_matrix_set_overlay_alpha(TINT_OVERLAY, 100);
+    idle_for(500);
+    EXPECT_EQ(overlay_calls, 10u);
+
+    driver.set_leds(0);
+    layer_off(1);
+    set_marker(false);
+    rgb_matrix_set_overlay_state(CAPS_OVERLAY, false);
+    rgb_matrix_set_overlay_state(LAYER_OVERLAY, false);
+    idle_for(500);
+}
+
+TEST_F(Overlays, alpha_overlays_blend_over_the_effect) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+    RGB base = hsv_to_rgb({HSV_PURPLE});
+    auto mix = [](uint8_t under, uint8_t over, uint8_t alpha) { return (uint8_t)((under * (256 - alpha) + over * (alpha + 1)) >> 8); };
+
+    // Green over the whole board, at a quarter
+    rgb_matrix_set_overlay_alpha(TINT_OVERLAY, 64);
+    rgb_matrix_set_overlay_state(TINT_OVERLAY, true);
+    idle_for(100);
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(test_rgb_matrix_leds[i][0], mix(base.r, 0, 64)) << "LED " << i;
+        EXPECT_EQ(test_rgb_matrix_leds[i][1], mix(base.g, 255, 64)) << "LED " << i;
+        EXPECT_EQ(test_rgb_matrix_leds[i][2], mix(base.b, 0, 64)) << "LED " << i;
+    }
+
+    // An opaque overlay underneath is tinted in turn, and the effect no longer shows through it
+    set_marker(true);
+    idle_for(100);
+    EXPECT_EQ(test_rgb_matrix_leds[12][0], mix(255, 0, 64));
+    EXPECT_EQ(test_rgb_matrix_leds[12][1], mix(255, 255, 64));
+    EXPECT_EQ(test_rgb_matrix_leds[12][2], mix(255, 0, 64));
+    EXPECT_EQ(test_rgb_matrix_leds[13][0], mix(base.r, 0, 64));
+
+    // Half the marker, then the tint: the effect comes through the two of them
+    rgb_matrix_set_overlay_alpha(MARKER_OVERLAY, 128);
+    idle_for(100);
+    for (int c = 0; c < 3; c++) {
+        uint8_t effect = c == 0 ? base.r : c == 1 ? base.g : base.b;
+        EXPECT_NEAR(test_rgb_matrix_leds[12][c], mix(mix(effect, 255, 128), c == 1 ? 255 : 0, 64), 1) << "channel " << c;
+    }
+
+    // Fully transparent overlays leave the effect as it is
+    rgb_matrix_set_overlay_alpha(MARKER_OVERLAY, 0);
+    rgb_matrix_set_overlay_alpha(TINT_OVERLAY, 0);
+    idle_for(100);
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(test_rgb_matrix_leds[i][0], base.r) << "LED " << i;
+        EXPECT_EQ(test_rgb_matrix_leds[i][1], base.g) << "LED " << i;
+        EXPECT_EQ(test_rgb_matrix_leds[i][2], base.b) << "LED " << i;
+    }
+
+    set_marker(false);
+    rgb_matrix_set_overlay_state(TINT_OVERLAY, false);
+    idle_for(100);
+}
+
+TEST_F(Overlays, leds_the_effect_leaves_alone_are_restored) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    // The effect only draws the keys, so the underglow stays off
+    rgb_matrix_set_flags_noeeprom(LED_FLAG_KEYLIGHT);
+    settle(RGB_MATRIX_SOLID_COLOR);
+    RGB base = hsv_to_rgb({HSV_PURPLE});
+
+    set_marker(true);
+    idle_for(100);
+    EXPECT_EQ(test_rgb_matrix_leds[45][0], 255);
+    EXPECT_EQ(test_rgb_matrix_leds[12][0], 255);
+
+    set_marker(false);
+    idle_for(100);
+    EXPECT_EQ(test_rgb_matrix_leds[45][0], 0);
+    EXPECT_EQ(test_rgb_matrix_leds[45][1], 0);
+    EXPECT_EQ(test_rgb_matrix_leds[45][2], 0);
+    EXPECT_EQ(test_rgb_matrix_leds[12][0], base.r);
+    EXPECT_EQ(test_rgb_matrix_leds[12][1], base.g);
+    EXPECT_EQ(test_rgb_matrix_leds[12][2], base.b);
+}
+
+TEST_F(Overlays, overlays_are_not_drawn_without_an_effect) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    set_marker(true);
+    settle(RGB_MATRIX_SOLID_COLOR);
+    EXPECT_EQ(test_rgb_matrix_leds[45][0], 255);
+
+    // Like the indicators, they go off along with the effect
+    rgb_matrix_disable_noeeprom();
+    idle_for(100);
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(test_rgb_matrix_leds[i][0], 0) << "LED " << i;
+    }
+
+    rgb_matrix_enable_noeeprom();
+    idle_for(100);
+    EXPECT_EQ(test_rgb_matrix_leds[45][0], 255);
+    set_marker(false);
+    idle_for(100);
+}
+
+/* Not a pass/fail test; run with --gtest_also_run_disabled_tests to compare overlays with indicators */
+TEST_F(Overlays, DISABLED_frame_cost) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    const unsigned count = 2000;
+
+    driver.set_leds(caps_lock());
+    layer_on(2);
+    for (uint8_t mode : {RGB_MATRIX_SOLID_COLOR, RGB_MATRIX_CYCLE_LEFT_RIGHT}) {
+        for (bool indicators : {true, false}) {
+            use_indicators = indicators;
+            rgb_matrix_set_overlay_state(CAPS_OVERLAY, !indicators);
+            rgb_matrix_set_overlay_state(LAYER_OVERLAY, !indicators);
+            settle(mode);
+
+            auto start = std::chrono::steady_clock::now();
+            run_frames(count);
+            double frame = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+            printf("%-22s %-10s %7.1fns per frame\n", mode == RGB_MATRIX_SOLID_COLOR ? "solid color" : "cycle left right", indicators ? "indicators" : "overlays", frame);
+            test_rgb_matrix_frames.clear();
+        }
+    }
+    rgb_matrix_set_overlay_state(CAPS_OVERLAY, false);
+    rgb_matrix_set_overlay_state(LAYER_OVERLAY, false);
+    layer_off(2);
+    driver.set_leds(0);
+    idle_for(100);
+}
@@ -0,0 +1,144 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+void set_time(uint32_t t);
+}
+
+using testing::_;
+
+// g_led_config and its tables are generated from info.json
+extern "C" {
+extern const led_polar_t g_led_polar[];
+extern const uint8_t     g_led_distance[];
+}
+
+class PolarTables : public TestFixture {
+   protected:
+    /* Renders an effect from a known starting point, with or without the tables */
+    std::vector<Frame> record(uint8_t mode, bool tables, std::vector<KeymapKey> keys) {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+        /* Switching through another effect makes the next one initialise itself */
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+
+        rgb_matrix_init();
+        if (!tables) {
+            g_rgb_led_polar    = NULL;
+            g_rgb_led_distance = NULL;
+        }
+
+        set_time(1000);
+        test_rgb_matrix_frames.clear();
+        rgb_matrix_mode_noeeprom(mode);
+        for (auto &key : keys) {
+            tap_key(key);
+            idle_for(50);
+        }
+        idle_for(500);
+        VERIFY_AND_CLEAR(driver);
+
+        return test_rgb_matrix_frames;
+    }
+
+    void expect_identical_frames(uint8_t mode) {
+        auto key_a = KeymapKey(0, 0, 0, KC_A);
+        auto key_b = KeymapKey(0, 5, 2, KC_B);
+        auto key_c = KeymapKey(0, 15, 5, KC_C);
+
+        set_keymap({key_a, key_b, key_c});
+
+        auto with_tables    = record(mode, true, {key_a, key_b, key_c});
+        auto without_tables = record(mode, false, {key_a, key_b, key_c});
+
+        ASSERT_GT(with_tables.size(), 30u);
+        ASSERT_EQ(with_tables.size(), without_tables.size());
+        EXPECT_NE(with_tables.front(), with_tables.back());
+        for (size_t i = 0; i < with_tables.size(); i++) {
+            EXPECT_EQ(with_tables[i], without_tables[i]) << "frame " << i;
+        }
+    }
+};
+
+TEST_F(PolarTables, tables_are_used_when_they_match_the_layout) {
+    rgb_matrix_init();
+    EXPECT_EQ(g_rgb_led_polar, g_led_polar);
+    EXPECT_EQ(g_rgb_led_distance, g_led_distance);
+
+    g_led_config.point[0].x++;
+    rgb_matrix_init();
+    EXPECT_EQ(g_rgb_led_polar, nullptr);
+    EXPECT_EQ(g_rgb_led_distance, nullptr);
+
+    g_led_config.point[0].x--;
+    rgb_matrix_init();
+    EXPECT_EQ(g_rgb_led_polar, g_led_polar);
+}
+
+TEST_F(PolarTables, cycle_pinwheel) {
+    expect_identical_frames(RGB_MATRIX_CYCLE_PINWHEEL);
+}
+
+TEST_F(PolarTables, cycle_spiral) {
+    expect_identical_frames(RGB_MATRIX_CYCLE_SPIRAL);
+}
+
+TEST_F(PolarTables, band_pinwheel_sat) {
+    expect_identical_frames(RGB_MATRIX_BAND_PINWHEEL_SAT);
+}
+
+TEST_F(PolarTables, band_spiral_val) {
+    expect_identical_frames(RGB_MATRIX_BAND_SPIRAL_VAL);
+}
+
+TEST_F(PolarTables, cycle_out_in) {
+    expect_identical_frames(RGB_MATRIX_CYCLE_OUT_IN);
+}
+
+TEST_F(PolarTables, solid_multisplash) {
+    expect_identical_frames(RGB_MATRIX_SOLID_MULTISPLASH);
+}
+
+TEST_F(PolarTables, typing_heatmap) {
+    expect_identical_frames(RGB_MATRIX_TYPING_HEATMAP);
+}
+
+/* Not a pass/fail test; run with --gtest_also_run_disabled_tests to compare the two */
+TEST_F(PolarTables, DISABLED_render_cost) {
+    TestDriver driver;
+    const int  renders = 2000;
+
+    for (uint8_t mode : {RGB_MATRIX_CYCLE_SPIRAL, RGB_MATRIX_SOLID_MULTISPLASH}) {
+        double elapsed[2];
+        for (bool tables : {false, true}) {
+            rgb_matrix_init();
+            if (!tables) {
+                g_rgb_led_polar    = NULL;
+                g_rgb_led_distance = NULL;
+            }
+            rgb_matrix_mode_noeeprom(mode);
+            process_rgb_matrix(0, 0, true);
+            process_rgb_matrix(5, 15, true);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < renders; i++) {
+                idle_for(RGB_MATRIX_LED_FLUSH_LIMIT);
+            }
+            elapsed[tables] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / renders;
+        }
+        printf("mode %u: %.2fus per frame computed, %.2fus per frame from the tables\n", mode, elapsed[false], elapsed[true]);
+    }
+}
@@ -0,0 +1,246 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void set_time(uint32_t t);
+}
+
+using testing::_;
+
+// A 4x10 grid of keys with modifiers in the bottom corners, and underglow around the edge
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {{4, 8}, {28, 8}, {52, 8}, {76, 8}, {100, 8}, {124, 8}, {148, 8}, {172, 8}, {196, 8}, {220, 8}, {4, 24}, {28, 24}, {52, 24}, {76, 24}, {100, 24}, {124, 24}, {148, 24}, {172, 24}, {196, 24}, {220, 24}, {4, 40}, {28, 40}, {52, 40}, {76, 40}, {100, 40}, {124, 40}, {148, 40}, {172, 40}, {196, 40}, {220, 40}, {4, 56}, {28, 56}, {52, 56}, {76, 56}, {100, 56}, {124, 56}, {148, 56}, {172, 56}, {196, 56}, {220, 56}, {0, 0}, {74, 0}, {150, 0}, {224, 0}, {224, 64}, {150, 64}, {74, 64}, {0, 64}},
+    {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 1, 4, 4, 4, 4, 4, 4, 4, 4, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+};
+
+/* Every effect's output over a fixed sequence of key presses is hashed, and
+ * compared with the output of the effects as they were first written, so that
+ * changes to the effects or the code driving them must keep every frame the same. */
+class RgbEffectOutput : public TestFixture {
+   protected:
+    void expect_output(uint8_t mode, uint32_t expected) {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+        auto key_a = KeymapKey(0, 0, 0, KC_A);
+        auto key_b = KeymapKey(0, 4, 1, KC_B);
+        auto key_c = KeymapKey(0, 9, 3, KC_C);
+        set_keymap({key_a, key_b, key_c});
+
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+
+        rgb_matrix_init();
+        rgb_matrix_sethsv_noeeprom(100, 200, 180);
+        rgb_matrix_set_speed_noeeprom(160);
+        set_time(1000);
+        rgb_matrix_mode_noeeprom(mode);
+        srand(1);
+        random16_set_seed(1337);
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+
+        test_rgb_matrix_frames.clear();
+        tap_key(key_a);
+        idle_for(150);
+        tap_key(key_b);
+        tap_key(key_c);
+        idle_for(400);
+        tap_key(key_b, 200);
+        idle_for(1000);
+
+        EXPECT_GT(test_rgb_matrix_frames.size(), 100u);
+        EXPECT_EQ(fnv1a(test_rgb_matrix_frames), expected);
+    }
+};
+
+TEST_F(RgbEffectOutput, solid_color) {
+    expect_output(RGB_MATRIX_SOLID_COLOR, 0xF541A7C5);
+}
+
+TEST_F(RgbEffectOutput, alphas_mods) {
+    expect_output(RGB_MATRIX_ALPHAS_MODS, 0xC2B7C2A9);
+}
+
+TEST_F(RgbEffectOutput, gradient_up_down) {
+    expect_output(RGB_MATRIX_GRADIENT_UP_DOWN, 0x0CA18703);
+}
+
+TEST_F(RgbEffectOutput, gradient_left_right) {
+    expect_output(RGB_MATRIX_GRADIENT_LEFT_RIGHT, 0x860BF619);
+}
+
+TEST_F(RgbEffectOutput, breathing) {
+    expect_output(RGB_MATRIX_BREATHING, 0x4C7CA005);
+}
+
+TEST_F(RgbEffectOutput, band_sat) {
+    expect_output(RGB_MATRIX_BAND_SAT, 0x70F2CF6B);
+}
+
+TEST_F(RgbEffectOutput, band_val) {
+    expect_output(RGB_MATRIX_BAND_VAL, 0x7A8934B1);
+}
+
+TEST_F(RgbEffectOutput, band_pinwheel_sat) {
+    expect_output(RGB_MATRIX_BAND_PINWHEEL_SAT, 0xCF630C2A);
+}
+
+TEST_F(RgbEffectOutput, band_pinwheel_val) {
+    expect_output(RGB_MATRIX_BAND_PINWHEEL_VAL, 0xADBC6D54);
+}
+
+TEST_F(RgbEffectOutput, band_spiral_sat) {
+    expect_output(RGB_MATRIX_BAND_SPIRAL_SAT, 0xB1AF2659);
+}
+
+TEST_F(RgbEffectOutput, band_spiral_val) {
+    expect_output(RGB_MATRIX_BAND_SPIRAL_VAL, 0x637BAB29);
+}
+
+TEST_F(RgbEffectOutput, cycle_all) {
+    expect_output(RGB_MATRIX_CYCLE_ALL, 0x527B7225);
+}
+
+TEST_F(RgbEffectOutput, cycle_left_right) {
+    expect_output(RGB_MATRIX_CYCLE_LEFT_RIGHT, 0x80A1AC21);
+}
+
+TEST_F(RgbEffectOutput, cycle_up_down) {
+    expect_output(RGB_MATRIX_CYCLE_UP_DOWN, 0x7DE5FA17);
+}
+
+TEST_F(RgbEffectOutput, rainbow_moving_chevron) {
+    expect_output(RGB_MATRIX_RAINBOW_MOVING_CHEVRON, 0x420B2A13);
+}
+
+TEST_F(RgbEffectOutput, cycle_out_in) {
+    expect_output(RGB_MATRIX_CYCLE_OUT_IN, 0xC3938F5D);
+}
+
+TEST_F(RgbEffectOutput, cycle_out_in_dual) {
+    expect_output(RGB_MATRIX_CYCLE_OUT_IN_DUAL, 0xA41C02A5);
+}
+
+TEST_F(RgbEffectOutput, cycle_pinwheel) {
+    expect_output(RGB_MATRIX_CYCLE_PINWHEEL, 0x1132CC55);
+}
+
+TEST_F(RgbEffectOutput, cycle_spiral) {
+    expect_output(RGB_MATRIX_CYCLE_SPIRAL, 0x4229D794);
+}
+
+TEST_F(RgbEffectOutput, dual_beacon) {
+    expect_output(RGB_MATRIX_DUAL_BEACON, 0x8C8861FF);
+}
+
+TEST_F(RgbEffectOutput, rainbow_beacon) {
+    expect_output(RGB_MATRIX_RAINBOW_BEACON, 0x3CA2AA0B);
+}
+
+TEST_F(RgbEffectOutput, rainbow_pinwheels) {
+    expect_output(RGB_MATRIX_RAINBOW_PINWHEELS, 0xC718E197);
+}
+
+TEST_F(RgbEffectOutput, raindrops) {
+    expect_output(RGB_MATRIX_RAINDROPS, 0x621B8795);
+}
+
+TEST_F(RgbEffectOutput, jellybean_raindrops) {
+    expect_output(RGB_MATRIX_JELLYBEAN_RAINDROPS, 0x9891E420);
+}
+
+TEST_F(RgbEffectOutput, hue_breathing) {
+    expect_output(RGB_MATRIX_HUE_BREATHING, 0x9A1237E5);
+}
+
+TEST_F(RgbEffectOutput, hue_pendulum) {
+    expect_output(RGB_MATRIX_HUE_PENDULUM, 0xC3A71D8B);
+}
+
+TEST_F(RgbEffectOutput, hue_wave) {
+    expect_output(RGB_MATRIX_HUE_WAVE, 0x1746F03D);
+}
+
+TEST_F(RgbEffectOutput, pixel_fractal) {
+    expect_output(RGB_MATRIX_PIXEL_FRACTAL, 0xFBFFDFD5);
+}
+
+TEST_F(RgbEffectOutput, pixel_flow) {
+    expect_output(RGB_MATRIX_PIXEL_FLOW, 0x905FC6C1);
+}
+
+TEST_F(RgbEffectOutput, pixel_rain) {
+    expect_output(RGB_MATRIX_PIXEL_RAIN, 0x3FEBD84A);
+}
+
+TEST_F(RgbEffectOutput, typing_heatmap) {
+    expect_output(RGB_MATRIX_TYPING_HEATMAP, 0x78DB8C57);
+}
+
+TEST_F(RgbEffectOutput, digital_rain) {
+    expect_output(RGB_MATRIX_DIGITAL_RAIN, 0x58E28611);
+}
+
+TEST_F(RgbEffectOutput, solid_reactive_simple) {
+    expect_output(RGB_MATRIX_SOLID_REACTIVE_SIMPLE, 0x0454147E);
+}
+
+TEST_F(RgbEffectOutput, solid_reactive) {
+    expect_output(RGB_MATRIX_SOLID_REACTIVE, 0x943D8B64);
+}
+
+TEST_F(RgbEffectOutput, solid_reactive_wide) {
+    expect_output(RGB_MATRIX_SOLID_REACTIVE_WIDE, 0x5C788C25);
+}
+
+TEST_F(RgbEffectOutput, solid_reactive_multiwide) {
+    expect_output(RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE, 0x913FF5BA);
+}
+
+TEST_F(RgbEffectOutput, solid_reactive_cross) {
+    expect_output(RGB_MATRIX_SOLID_REACTIVE_CROSS, 0x21670174);
+}
+
+TEST_F(RgbEffectOutput, solid_reactive_multicross) {
+    expect_output(RGB_MATRIX_SOLID_REACTIVE_MULTICROSS, 0xB89EA675);
+}
+
+TEST_F(RgbEffectOutput, solid_reactive_nexus) {
+    expect_output(RGB_MATRIX_SOLID_REACTIVE_NEXUS, 0x06F7CAEC);
+}
+
+TEST_F(RgbEffectOutput, solid_reactive_multinexus) {
+    expect_output(RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS, 0x983582E6);
+}
+
+TEST_F(RgbEffectOutput, splash) {
+    expect_output(RGB_MATRIX_SPLASH, 0x597DF00B);
+}
+
+TEST_F(RgbEffectOutput, multisplash) {
+    expect_output(RGB_MATRIX_MULTISPLASH, 0xE2A75503);
+}
+
+TEST_F(RgbEffectOutput, solid_splash) {
+    expect_output(RGB_MATRIX_SOLID_SPLASH, 0x16720C0C);
+}
+
+TEST_F(RgbEffectOutput, solid_multisplash) {
+    expect_output(RGB_MATRIX_SOLID_MULTISPLASH, 0x6A095D19);
+}
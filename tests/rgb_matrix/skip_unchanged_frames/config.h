@@ -0,0 +1,15 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 8
+#define RGB_MATRIX_SKIP_UNCHANGED_FRAMES
+#define RGB_MATRIX_OVERLAYS
+
+#define ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
+#define ENABLE_RGB_MATRIX_CYCLE_ALL
+
+#define RGB_MATRIX_KEYPRESSES
@@ -0,0 +1,179 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "action_layer.h"
+}
+
+using testing::_;
+
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {4, 5, 6, 7, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    },
+    {{0, 0}, {74, 0}, {150, 0}, {224, 0}, {0, 64}, {74, 64}, {150, 64}, {224, 64}},
+    {4, 4, 4, 4, 4, 4, 4, 4},
+};
+
+extern "C" {
+bool rgb_matrix_indicators_user(void) {
+    if (layer_state_is(1)) {
+        rgb_matrix_set_color(0, 255, 0, 0);
+    }
+    return true;
+}
+
+bool rgb_matrix_overlay_user(uint8_t overlay) {
+    rgb_matrix_overlay_set_color(3, 0, 255, 0);
+    return true;
+}
+}
+
+class SkipUnchangedFrames : public TestFixture {
+   protected:
+    /* Frames flushed and skipped over a stretch of time */
+    struct Counts {
+        size_t   flushed;
+        uint32_t rendered;
+        uint32_t skipped;
+    };
+
+    Counts count_for(uint32_t ms) {
+        size_t   flushed  = test_rgb_matrix_frames.size();
+        uint32_t rendered = rgb_matrix_get_rendered_frames();
+        uint32_t skipped  = rgb_matrix_get_skipped_frames();
+        idle_for(ms);
+        return {test_rgb_matrix_frames.size() - flushed, rgb_matrix_get_rendered_frames() - rendered, rgb_matrix_get_skipped_frames() - skipped};
+    }
+
+    void settle(uint8_t mode) {
+        rgb_matrix_mode_noeeprom(mode);
+        rgb_matrix_sethsv_noeeprom(HSV_BLUE);
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    }
+};
+
+TEST_F(SkipUnchangedFrames, static_effect_is_flushed_once) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CYCLE_ALL);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    settle(RGB_MATRIX_SOLID_COLOR);
+    Frame settled = test_rgb_matrix_frames.back();
+
+    Counts counts = count_for(1000);
+    EXPECT_EQ(counts.flushed, 0u);
+    EXPECT_EQ(counts.rendered, 0u);
+    EXPECT_GE(counts.skipped, 1000u / (RGB_MATRIX_LED_FLUSH_LIMIT + 8));
+
+    /* What's on the LEDs is still the solid colour */
+    RGB rgb = hsv_to_rgb({HSV_BLUE});
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(settled[i * 3 + 0], rgb.r);
+        EXPECT_EQ(settled[i * 3 + 1], rgb.g);
+        EXPECT_EQ(settled[i * 3 + 2], rgb.b);
+    }
+}
+
+TEST_F(SkipUnchangedFrames, config_change_renders_a_frame) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+
+    rgb_matrix_sethsv_noeeprom(HSV_RED);
+    Counts counts = count_for(200);
+    EXPECT_EQ(counts.flushed, 1u);
+    EXPECT_EQ(counts.rendered, 1u);
+
+    RGB rgb = hsv_to_rgb({HSV_RED});
+    EXPECT_EQ(test_rgb_matrix_frames.back()[0], rgb.r);
+    EXPECT_EQ(test_rgb_matrix_frames.back()[1], rgb.g);
+    EXPECT_EQ(test_rgb_matrix_frames.back()[2], rgb.b);
+}
+
+TEST_F(SkipUnchangedFrames, layer_change_reruns_indicators) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+    Frame plain = test_rgb_matrix_frames.back();
+
+    layer_on(1);
+    EXPECT_EQ(count_for(200).flushed, 1u);
+    EXPECT_EQ(test_rgb_matrix_frames.back()[0], 255);
+    EXPECT_EQ(test_rgb_matrix_frames.back()[1], 0);
+    EXPECT_EQ(test_rgb_matrix_frames.back()[2], 0);
+
+    layer_off(1);
+    EXPECT_EQ(count_for(200).flushed, 1u);
+    EXPECT_EQ(test_rgb_matrix_frames.back(), plain);
+}
+
+TEST_F(SkipUnchangedFrames, timed_effect_renders_every_frame) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    settle(RGB_MATRIX_CYCLE_ALL);
+
+    Counts counts = count_for(1000);
+    EXPECT_EQ(counts.skipped, 0u);
+    EXPECT_EQ(counts.flushed, counts.rendered);
+    EXPECT_GE(counts.rendered, 1000u / (RGB_MATRIX_LED_FLUSH_LIMIT + 8));
+}
+
+TEST_F(SkipUnchangedFrames, reactive_effect_renders_while_hits_fade) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    auto key = KeymapKey(0, 1, 0, KC_A);
+    set_keymap({key});
+
+    settle(RGB_MATRIX_SOLID_REACTIVE_SIMPLE);
+    EXPECT_EQ(count_for(500).rendered, 0u);
+
+    tap_key(key);
+    Counts counts = count_for(1000);
+    EXPECT_EQ(counts.skipped, 0u);
+    EXPECT_GE(counts.rendered, 1000u / (RGB_MATRIX_LED_FLUSH_LIMIT + 8));
+
+    /* Once the hit is forgotten, the effect is back to its resting state */
+    idle_for(UINT16_MAX);
+    counts = count_for(1000);
+    EXPECT_EQ(counts.rendered, 0u);
+    EXPECT_GT(counts.skipped, 0u);
+}
+
+TEST_F(SkipUnchangedFrames, overlay_change_flushes_a_frame) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    settle(RGB_MATRIX_SOLID_COLOR);
+    Frame plain = test_rgb_matrix_frames.back();
+
+    /* The overlay is drawn over the last frame, which isn't rendered again */
+    rgb_matrix_set_overlay_state(0, true);
+    Counts counts = count_for(200);
+    EXPECT_EQ(counts.flushed, 1u);
+    EXPECT_EQ(counts.rendered, 1u);
+    EXPECT_EQ(test_rgb_matrix_frames.back()[9], 0);
+    EXPECT_EQ(test_rgb_matrix_frames.back()[10], 255);
+    EXPECT_EQ(test_rgb_matrix_frames.back()[11], 0);
+    EXPECT_EQ(count_for(200).flushed, 0u);
+
+    rgb_matrix_set_overlay_state(0, false);
+    EXPECT_EQ(count_for(200).flushed, 1u);
+    EXPECT_EQ(test_rgb_matrix_frames.back(), plain);
+}
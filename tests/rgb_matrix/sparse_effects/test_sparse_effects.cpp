@@ -0,0 +1,153 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+void set_time(uint32_t t);
+}
+
+using testing::_;
+
+// g_led_config and its tables are generated from info.json
+extern "C" {
+extern const uint16_t       g_led_neighbor_index[];
+extern const led_neighbor_t g_led_neighbors[];
+}
+
+class SparseEffects : public TestFixture {
+   protected:
+    KeymapKey keys[6] = {KeymapKey(0, 0, 0, KC_A), KeymapKey(0, 4, 1, KC_B), KeymapKey(0, 9, 3, KC_C), KeymapKey(0, 5, 2, KC_D), KeymapKey(0, 1, 3, KC_E), KeymapKey(0, 8, 0, KC_F)};
+
+    void SetUp() override {
+        set_keymap({keys[0], keys[1], keys[2], keys[3], keys[4], keys[5]});
+    }
+
+    /* Renders an effect for a sequence of key presses, from a known starting point */
+    std::vector<Frame> record(uint8_t mode, bool neighbors) {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+        /* Switching through another effect makes the next one initialise itself */
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+
+        rgb_matrix_init();
+        if (!neighbors) {
+            g_rgb_led_neighbor_index = NULL;
+            g_rgb_led_neighbors      = NULL;
+        }
+
+        set_time(1000);
+        test_rgb_matrix_frames.clear();
+        rgb_matrix_mode_noeeprom(mode);
+
+        /* A burst of typing that overflows the hit tracker, a pause long enough
+         * for every splash to die out, and then a single key press */
+        for (int i = 0; i < 12; i++) {
+            tap_key(keys[i % 6]);
+            idle_for(40 + 20 * (i % 3));
+        }
+        idle_for(1500);
+        tap_key(keys[3]);
+        idle_for(800);
+        VERIFY_AND_CLEAR(driver);
+
+        return test_rgb_matrix_frames;
+    }
+
+    void expect_identical_frames(const std::vector<Frame> &expected, const std::vector<Frame> &actual) {
+        ASSERT_GT(expected.size(), 100u);
+        ASSERT_EQ(expected.size(), actual.size());
+        EXPECT_TRUE(std::any_of(expected.begin(), expected.end(), [&](const Frame &frame) { return frame != expected.front(); }));
+        for (size_t i = 0; i < expected.size(); i++) {
+            EXPECT_EQ(expected[i], actual[i]) << "frame " << i;
+        }
+    }
+
+    void expect_identical_frames(uint8_t mode, uint8_t reference) {
+        auto expected = record(reference, true);
+        auto actual   = record(mode, true);
+        expect_identical_frames(expected, actual);
+    }
+};
+
+TEST_F(SparseEffects, neighbors_are_used_when_they_match_the_matrix) {
+    rgb_matrix_init();
+    EXPECT_EQ(g_rgb_led_neighbor_index, g_led_neighbor_index);
+    EXPECT_EQ(g_rgb_led_neighbors, g_led_neighbors);
+
+    std::swap(g_led_config.matrix_co[0][0], g_led_config.matrix_co[0][1]);
+    rgb_matrix_init();
+    EXPECT_EQ(g_rgb_led_neighbors, nullptr);
+
+    std::swap(g_led_config.matrix_co[0][0], g_led_config.matrix_co[0][1]);
+    rgb_matrix_init();
+    EXPECT_EQ(g_rgb_led_neighbors, g_led_neighbors);
+}
+
+TEST_F(SparseEffects, typing_heatmap) {
+    auto expected = record(RGB_MATRIX_TYPING_HEATMAP, false);
+    auto actual   = record(RGB_MATRIX_TYPING_HEATMAP, true);
+    expect_identical_frames(expected, actual);
+}
+
+TEST_F(SparseEffects, splash) {
+    expect_identical_frames(RGB_MATRIX_SPLASH, RGB_MATRIX_CUSTOM_REFERENCE_SPLASH);
+}
+
+TEST_F(SparseEffects, multisplash) {
+    expect_identical_frames(RGB_MATRIX_MULTISPLASH, RGB_MATRIX_CUSTOM_REFERENCE_MULTISPLASH);
+}
+
+TEST_F(SparseEffects, solid_multisplash) {
+    expect_identical_frames(RGB_MATRIX_SOLID_MULTISPLASH, RGB_MATRIX_CUSTOM_REFERENCE_SOLID_MULTISPLASH);
+}
+
+TEST_F(SparseEffects, solid_reactive_multiwide) {
+    expect_identical_frames(RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE, RGB_MATRIX_CUSTOM_REFERENCE_SOLID_REACTIVE_MULTIWIDE);
+}
+
+TEST_F(SparseEffects, solid_reactive_multicross) {
+    expect_identical_frames(RGB_MATRIX_SOLID_REACTIVE_MULTICROSS, RGB_MATRIX_CUSTOM_REFERENCE_SOLID_REACTIVE_MULTICROSS);
+}
+
+TEST_F(SparseEffects, solid_reactive_nexus) {
+    expect_identical_frames(RGB_MATRIX_SOLID_REACTIVE_NEXUS, RGB_MATRIX_CUSTOM_REFERENCE_SOLID_REACTIVE_NEXUS);
+}
+
+TEST_F(SparseEffects, solid_reactive_multinexus) {
+    expect_identical_frames(RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS, RGB_MATRIX_CUSTOM_REFERENCE_SOLID_REACTIVE_MULTINEXUS);
+}
+
+TEST_F(SparseEffects, render_cost) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    const int renders = 1000;
+
+    for (uint8_t mode : {RGB_MATRIX_CUSTOM_REFERENCE_MULTISPLASH, RGB_MATRIX_MULTISPLASH}) {
+        rgb_matrix_init();
+        rgb_matrix_mode_noeeprom(mode);
+
+        /* A full hit tracker, with splashes at every stage */
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < renders; i++) {
+            if (i % 8 == 0) {
+                tap_key(keys[i / 8 % 6]);
+            }
+            idle_for(RGB_MATRIX_LED_FLUSH_LIMIT);
+        }
+        double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / renders;
+        printf("mode %u: %.2fus per frame\n", mode, elapsed);
+    }
+}
@@ -0,0 +1,166 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+void set_time(uint32_t t);
+}
+
+using testing::_;
+
+typedef std::vector<rgb_matrix_event_sync_t> Syncs;
+
+static bool master = true;
+
+/* The left half is on rows 0 and 1, the right half on rows 2 and 3 */
+led_config_t g_led_config = {
+    {
+        {0, 1, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {2, 3, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {4, 5, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {6, 7, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    },
+    {{0, 0}, {74, 0}, {0, 64}, {74, 64}, {150, 0}, {224, 0}, {150, 64}, {224, 64}},
+    {4, 4, 4, 4, 4, 4, 4, 4},
+};
+
+extern "C" {
+bool is_keyboard_master(void) {
+    return master;
+}
+
+bool is_keyboard_left(void) {
+    return false;
+}
+}
+
+class SplitReplication : public TestFixture {
+   protected:
+    static const unsigned typing_scans = 400;
+    static const unsigned scans        = 600;
+
+    uint32_t lost_before = 0;
+
+    /* Types on both halves, one scan at a time, and returns the right half's frames.
+     * The master records its event sync after every scan, which the slave is later
+     * fed delay scans late. */
+    std::vector<Frame> run(bool as_master, uint8_t mode, Syncs *record, const Syncs *replay, unsigned delay = 0) {
+        TestDriver driver;
+        auto       left_key  = KeymapKey(0, 1, 0, KC_A);
+        auto       right_key = KeymapKey(0, 0, 2, KC_B);
+        auto       far_key   = KeymapKey(0, 1, 3, KC_C);
+        KeymapKey *keys[]    = {&left_key, &right_key, &far_key, &left_key};
+
+        set_keymap({left_key, right_key, far_key});
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+        master = as_master;
+        set_time(1000);
+        rgb_matrix_mode_noeeprom(mode);
+        rgb_matrix_sethsv_noeeprom(100, 200, 180);
+        rgb_matrix_set_speed_noeeprom(160);
+        test_rgb_matrix_frames.clear();
+
+        if (replay) {
+            /* Caught up with the master before it starts typing */
+            rgb_matrix_event_sync_t caught_up = (*replay)[0];
+            caught_up.count                   = 0;
+            rgb_matrix_update_event_sync(&caught_up);
+            /* Catching up from whatever this process last ran as isn't a loss */
+            lost_before = rgb_matrix_get_lost_split_events();
+        }
+
+        for (unsigned scan = 0; scan < scans; scan++) {
+            if (replay && scan >= delay) {
+                rgb_matrix_update_event_sync(&(*replay)[scan - delay]);
+            }
+            if (scan < typing_scans && scan % 40 == 10) {
+                keys[scan / 40 % 4]->press();
+            }
+            if (scan < typing_scans && scan % 40 == 25) {
+                keys[scan / 40 % 4]->release();
+            }
+            run_one_scan_loop();
+            if (record) {
+                rgb_matrix_event_sync_t sync;
+                rgb_matrix_get_event_sync(&sync);
+                record->push_back(sync);
+            }
+        }
+        testing::Mock::VerifyAndClearExpectations(&driver);
+
+        master = true;
+
+        /* Only the right half is rendered */
+        std::vector<Frame> frames;
+        for (auto &frame : test_rgb_matrix_frames) {
+            frames.push_back(Frame(frame.begin() + 4 * 3, frame.end()));
+        }
+        return frames;
+    }
+
+    void expect_replicated(uint8_t mode) {
+        Syncs              syncs;
+        std::vector<Frame> expected = run(true, mode, &syncs, nullptr);
+        std::vector<Frame> actual   = run(false, mode, nullptr, &syncs);
+
+        ASSERT_GT(expected.size(), 30u);
+        EXPECT_EQ(actual, expected);
+        EXPECT_EQ(rgb_matrix_get_lost_split_events(), lost_before);
+        /* Something actually happened */
+        EXPECT_NE(expected.front(), expected[expected.size() / 2]);
+    }
+};
+
+TEST_F(SplitReplication, slave_reproduces_reactive_frames) {
+    expect_replicated(RGB_MATRIX_SOLID_REACTIVE_SIMPLE);
+}
+
+TEST_F(SplitReplication, slave_reproduces_splash_frames) {
+    expect_replicated(RGB_MATRIX_SPLASH);
+}
+
+TEST_F(SplitReplication, slave_ignores_its_own_switch_events) {
+    Syncs              idle(scans, rgb_matrix_event_sync_t{});
+    std::vector<Frame> actual = run(false, RGB_MATRIX_SOLID_REACTIVE_SIMPLE, nullptr, &idle);
+
+    ASSERT_GT(actual.size(), 30u);
+    for (const Frame &frame : actual) {
+        EXPECT_EQ(frame, actual.front());
+    }
+}
+
+TEST_F(SplitReplication, late_syncs_converge) {
+    Syncs              syncs;
+    std::vector<Frame> expected = run(true, RGB_MATRIX_SPLASH, &syncs, nullptr);
+    std::vector<Frame> actual   = run(false, RGB_MATRIX_SPLASH, nullptr, &syncs, 5);
+
+    /* Hits are aged from when the master recorded them, so once they have
+     * arrived the slave renders the same frames */
+    ASSERT_EQ(actual.size(), expected.size());
+    EXPECT_EQ(actual.back(), expected.back());
+    EXPECT_EQ(actual[actual.size() - 5], expected[expected.size() - 5]);
+}
+
+TEST_F(SplitReplication, events_missed_between_syncs_are_counted) {
+    Syncs syncs;
+    run(true, RGB_MATRIX_SPLASH, &syncs, nullptr);
+
+    /* Only every 200th sync gets through, by which time ten events have
+     * happened, more than the four the master keeps */
+    Syncs sparse;
+    for (unsigned scan = 0; scan < syncs.size(); scan++) {
+        sparse.push_back(syncs[scan - scan % 200]);
+    }
+    run(false, RGB_MATRIX_SPLASH, nullptr, &sparse);
+
+    EXPECT_EQ(rgb_matrix_get_lost_split_events() - lost_before, 12u);
+}
@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGBLED_NUM 150
+#define RGBLIGHT_CURRENT_LIMIT 500
+#define RGBLIGHT_CHANNEL_CURRENT 20
+
+#define RGBLIGHT_EFFECT_RAINBOW_SWIRL
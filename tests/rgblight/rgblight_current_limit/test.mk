@@ -0,0 +1,5 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGBLIGHT_ENABLE = yes
+WS2812_DRIVER = custom
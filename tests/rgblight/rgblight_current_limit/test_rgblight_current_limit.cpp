@@ -0,0 +1,101 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "rgblight.h"
+#include "test_ws2812.h"
+}
+
+using testing::_;
+
+static uint32_t frame_level(const LED_TYPE *frame, uint8_t num_leds) {
+    uint32_t level = 0;
+    for (uint8_t i = 0; i < num_leds; i++) {
+        level += frame[i].r + frame[i].g + frame[i].b;
+    }
+    return level;
+}
+
+static double frame_current(const LED_TYPE *frame, uint8_t num_leds) {
+    return frame_level(frame, num_leds) * RGBLIGHT_CHANNEL_CURRENT / 255.0;
+}
+
+class RgblightCurrentLimit : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgblight_set_clipping_range(0, RGBLED_NUM);
+        rgblight_enable_noeeprom();
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+    }
+
+    void random_frame(unsigned lit_percent) {
+        for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+            bool lit = (unsigned)(rand() % 100) < lit_percent;
+            setrgb(lit ? rand() % 256 : 0, lit ? rand() % 256 : 0, lit ? rand() % 256 : 0, &led[i]);
+        }
+    }
+};
+
+TEST_F(RgblightCurrentLimit, frames_within_budget_are_untouched) {
+    srand(1);
+    for (int n = 0; n < 50; n++) {
+        random_frame(5);
+        ASSERT_LE(frame_current(led, RGBLED_NUM), RGBLIGHT_CURRENT_LIMIT);
+        rgblight_set();
+
+        EXPECT_EQ(rgblight_get_current_estimate(), (frame_level(led, RGBLED_NUM) * RGBLIGHT_CHANNEL_CURRENT + 254) / 255);
+        EXPECT_FALSE(rgblight_is_current_limited());
+        EXPECT_EQ(memcmp(test_ws2812_leds, led, sizeof(led)), 0) << "frame " << n;
+    }
+}
+
+TEST_F(RgblightCurrentLimit, frames_over_budget_are_dimmed) {
+    srand(2);
+    for (int n = 0; n < 50; n++) {
+        random_frame(30 + n);
+        LED_TYPE frame[RGBLED_NUM];
+        memcpy(frame, led, sizeof(frame));
+        ASSERT_GT(frame_current(frame, RGBLED_NUM), RGBLIGHT_CURRENT_LIMIT);
+        rgblight_set();
+
+        EXPECT_EQ(rgblight_get_current_estimate(), (frame_level(frame, RGBLED_NUM) * RGBLIGHT_CHANNEL_CURRENT + 254) / 255);
+        EXPECT_TRUE(rgblight_is_current_limited());
+        EXPECT_LE(frame_current(test_ws2812_leds, RGBLED_NUM), RGBLIGHT_CURRENT_LIMIT) << "frame " << n;
+        EXPECT_GT(frame_current(test_ws2812_leds, RGBLED_NUM), RGBLIGHT_CURRENT_LIMIT - RGBLED_NUM * 3 * RGBLIGHT_CHANNEL_CURRENT / 255.0 - 1) << "frame " << n;
+        // The effects' own buffer is left alone, so static modes aren't dimmed further on every update
+        EXPECT_EQ(memcmp(led, frame, sizeof(frame)), 0) << "frame " << n;
+    }
+}
+
+TEST_F(RgblightCurrentLimit, only_the_clipped_leds_count) {
+    rgblight_setrgb(255, 255, 255);
+    EXPECT_TRUE(rgblight_is_current_limited());
+
+    // 8 white LEDs draw 480mA, so they are sent as they are
+    rgblight_set_clipping_range(10, 8);
+    rgblight_set();
+    EXPECT_EQ(test_ws2812_num_leds, 8);
+    EXPECT_EQ(rgblight_get_current_estimate(), 480);
+    EXPECT_FALSE(rgblight_is_current_limited());
+    EXPECT_EQ(test_ws2812_leds[0].r, 255);
+}
+
+TEST_F(RgblightCurrentLimit, effects_are_limited) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    rgblight_sethsv_noeeprom(0, 255, 255);
+    rgblight_mode_noeeprom(RGBLIGHT_MODE_RAINBOW_SWIRL);
+    uint32_t writes = test_ws2812_writes;
+    idle_for(1000);
+    EXPECT_GT(test_ws2812_writes, writes);
+
+    EXPECT_GT(rgblight_get_current_estimate(), RGBLIGHT_CURRENT_LIMIT);
+    EXPECT_TRUE(rgblight_is_current_limited());
+    EXPECT_LE(frame_current(test_ws2812_leds, RGBLED_NUM), RGBLIGHT_CURRENT_LIMIT);
+}
@@ -0,0 +1,157 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdlib>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#include "rgblight.h"
+#include "test_ws2812.h"
+
+void set_time(uint32_t t);
+}
+
+using testing::_;
+
+// Overlapping layers near the start of the strip, and one that only the long strip reaches
+const rgblight_segment_t PROGMEM caps_layer[]   = RGBLIGHT_LAYER_SEGMENTS({0, 4, 0, 255, 255}, {10, 5, 43, 255, 200});
+const rgblight_segment_t PROGMEM raise_layer[]  = RGBLIGHT_LAYER_SEGMENTS({2, 6, 170, 255, 255});
+const rgblight_segment_t PROGMEM adjust_layer[] = RGBLIGHT_LAYER_SEGMENTS({40, 30, 85, 128, 255}, {150, 20, 213, 255, 100});
+
+const rgblight_segment_t *const PROGMEM test_layers[] = RGBLIGHT_LAYERS_LIST(caps_layer, raise_layer, adjust_layer);
+
+/* Every effect's output, while layers are switched on and off, is hashed and
+ * compared with the output of the effects as they were first written, so that
+ * changes to the effects or to rgblight_set() must keep every frame the same.
+ *
+ * Snake and knight keep their position in static variables, so each hash also
+ * depends on the tests that ran before it. */
+class RgblightEffects : public TestFixture {
+   protected:
+    void start(uint8_t mode, uint8_t num_leds) {
+        rgblight_layers = test_layers;
+        for (uint8_t i = 0; i < RGBLIGHT_MAX_LAYERS; i++) {
+            rgblight_set_layer_state(i, false);
+        }
+        rgblight_set_clipping_range(0, num_leds);
+        rgblight_set_effect_range(0, num_leds);
+        rgblight_enable_noeeprom();
+        rgblight_sethsv_noeeprom(100, 200, 180);
+        set_time(1000);
+        rgblight_mode_noeeprom(mode);
+        srand(1);
+    }
+
+    void expect_output(uint8_t mode, uint8_t num_leds, uint32_t expected) {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+        start(mode, num_leds);
+        uint32_t hash   = 2166136261u;
+        uint32_t writes = test_ws2812_writes;
+        for (unsigned step = 0; step < 5; step++) {
+            rgblight_set_layer_state(0, step == 1 || step == 2);
+            rgblight_set_layer_state(1, step == 2 || step == 3);
+            rgblight_set_layer_state(2, step == 4);
+            for (unsigned ms = 0; ms < 400; ms++) {
+                uint32_t before = test_ws2812_writes;
+                run_one_scan_loop();
+                if (test_ws2812_writes != before) {
+                    EXPECT_EQ(test_ws2812_num_leds, num_leds);
+                    hash = fnv1a(hash, (const uint8_t *)test_ws2812_leds, test_ws2812_num_leds * sizeof(LED_TYPE));
+                }
+            }
+        }
+
+        EXPECT_GT(test_ws2812_writes - writes, 10u);
+        EXPECT_EQ(hash, expected);
+    }
+
+    void benchmark(const char *name, uint8_t mode, uint8_t num_leds, void (*effect)(animation_status_t *)) {
+        const unsigned ticks = 20000;
+
+        start(mode, num_leds);
+        rgblight_set_layer_state(0, true);
+        rgblight_set_layer_state(2, true);
+        rgblight_task();
+
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < ticks; i++) {
+            effect(&animation_status);
+        }
+        double tick = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ticks;
+
+        printf("%-14s %3d LEDs: %7.1fns per tick\n", name, num_leds, tick);
+    }
+};
+
+TEST_F(RgblightEffects, breathing) {
+    expect_output(RGBLIGHT_MODE_BREATHING, 60, 0x646CD8C4);
+    expect_output(RGBLIGHT_MODE_BREATHING + 3, 200, 0x128725EE);
+}
+
+TEST_F(RgblightEffects, rainbow_swirl) {
+    expect_output(RGBLIGHT_MODE_RAINBOW_SWIRL, 60, 0xAEBE08A6);
+    expect_output(RGBLIGHT_MODE_RAINBOW_SWIRL + 5, 200, 0xC43FBF40);
+}
+
+TEST_F(RgblightEffects, snake) {
+    expect_output(RGBLIGHT_MODE_SNAKE + 4, 60, 0x8653EA16);
+    expect_output(RGBLIGHT_MODE_SNAKE + 5, 60, 0x0B704033);
+    expect_output(RGBLIGHT_MODE_SNAKE + 5, 200, 0x96F65EDD);
+}
+
+TEST_F(RgblightEffects, snake_past_127_leds) {
+    TestDriver driver;
+    start(RGBLIGHT_MODE_SNAKE + 5, 200);
+
+    // The head moves up one LED at a time, with its dimmer tail behind it, all the way round the strip
+    int last_head = -1;
+    for (unsigned tick = 0; tick < 400; tick++) {
+        rgblight_effect_snake(&animation_status);
+
+        uint8_t  head = 0;
+        unsigned lit  = 0;
+        for (uint8_t i = 0; i < 200; i++) {
+            lit += test_ws2812_leds[i].r || test_ws2812_leds[i].g || test_ws2812_leds[i].b;
+            if (test_ws2812_leds[i].g > test_ws2812_leds[head].g) {
+                head = i;
+            }
+        }
+        ASSERT_EQ(lit, (unsigned)RGBLIGHT_EFFECT_SNAKE_LENGTH) << "tick " << tick;
+        for (uint8_t j = 1; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
+            uint8_t tail = (head + 200 - j) % 200;
+            ASSERT_LT(test_ws2812_leds[tail].g, test_ws2812_leds[(tail + 1) % 200].g) << "tick " << tick;
+            ASSERT_GT(test_ws2812_leds[tail].g, 0) << "tick " << tick;
+        }
+        if (last_head >= 0) {
+            ASSERT_EQ(head, (last_head + 1) % 200) << "tick " << tick;
+        }
+        last_head = head;
+    }
+}
+
+TEST_F(RgblightEffects, knight) {
+    expect_output(RGBLIGHT_MODE_KNIGHT + 2, 60, 0x7B62318B);
+    expect_output(RGBLIGHT_MODE_KNIGHT + 2, 100, 0x2B0A5BDF);
+}
+
+TEST_F(RgblightEffects, twinkle) {
+    expect_output(RGBLIGHT_MODE_TWINKLE + 2, 60, 0xBEDC55C4);
+    expect_output(RGBLIGHT_MODE_TWINKLE + 5, 200, 0xFCDED716);
+}
+
+/* Not a pass/fail test; run with --gtest_also_run_disabled_tests to time each effect's tick */
+TEST_F(RgblightEffects, DISABLED_tick_benchmark) {
+    for (uint8_t num_leds : {60, 200}) {
+        benchmark("breathing", RGBLIGHT_MODE_BREATHING, num_leds, rgblight_effect_breathing);
+        benchmark("rainbow swirl", RGBLIGHT_MODE_RAINBOW_SWIRL, num_leds, rgblight_effect_rainbow_swirl);
+        benchmark("snake", RGBLIGHT_MODE_SNAKE, num_leds, rgblight_effect_snake);
+        benchmark("knight", RGBLIGHT_MODE_KNIGHT, num_leds, rgblight_effect_knight);
+        benchmark("twinkle", RGBLIGHT_MODE_TWINKLE, num_leds, rgblight_effect_twinkle);
+    }
+}
@@ -0,0 +1,215 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static const uint16_t slow_mod_tap_keycode  = SFT_T(KC_P);
+static const uint16_t eager_mod_tap_keycode = ALT_T(KC_O);
+static const uint16_t slow_tapping_term     = TAPPING_TERM + 100;
+
+static unsigned tapping_term_lookups;
+static unsigned quick_tap_term_lookups;
+static unsigned permissive_hold_lookups;
+static unsigned hold_on_other_key_press_lookups;
+
+extern "C" {
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    tapping_term_lookups++;
+    return keycode == slow_mod_tap_keycode ? slow_tapping_term : TAPPING_TERM;
+}
+
+uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record) {
+    quick_tap_term_lookups++;
+    return QUICK_TAP_TERM;
+}
+
+bool get_permissive_hold(uint16_t keycode, keyrecord_t *record) {
+    permissive_hold_lookups++;
+    return keycode == slow_mod_tap_keycode;
+}
+
+bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) {
+    hold_on_other_key_press_lookups++;
+    return keycode == eager_mod_tap_keycode;
+}
+}
+
+class PerKeySettings : public TestFixture {
+   protected:
+    void SetUp() override {
+        tapping_term_lookups            = 0;
+        quick_tap_term_lookups          = 0;
+        permissive_hold_lookups         = 0;
+        hold_on_other_key_press_lookups = 0;
+    }
+
+    unsigned total_lookups() {
+        return tapping_term_lookups + quick_tap_term_lookups + permissive_hold_lookups + hold_on_other_key_press_lookups;
+    }
+};
+
+TEST_F(PerKeySettings, tapping_term_is_per_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       slow_mod_tap_key = KeymapKey(0, 1, 0, slow_mod_tap_keycode);
+    auto       mod_tap_key      = KeymapKey(0, 2, 0, CTL_T(KC_Q));
+
+    set_keymap({slow_mod_tap_key, mod_tap_key});
+
+    /* Held past the default tapping term, but within its own */
+    EXPECT_NO_REPORT(driver);
+    slow_mod_tap_key.press();
+    idle_for(TAPPING_TERM + 50);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    slow_mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Held past the default tapping term */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PerKeySettings, permissive_hold_is_per_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       slow_mod_tap_key = KeymapKey(0, 1, 0, slow_mod_tap_keycode);
+    auto       mod_tap_key      = KeymapKey(0, 2, 0, CTL_T(KC_Q));
+    auto       regular_key      = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({slow_mod_tap_key, mod_tap_key, regular_key});
+
+    /* Tapping another key within the tapping term holds the permissive key */
+    EXPECT_NO_REPORT(driver);
+    slow_mod_tap_key.press();
+    run_one_scan_loop();
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    slow_mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* ...but taps the other one */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_Q));
+    EXPECT_REPORT(driver, (KC_Q, KC_A));
+    EXPECT_REPORT(driver, (KC_Q));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PerKeySettings, hold_on_other_key_press_is_per_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       eager_mod_tap_key = KeymapKey(0, 1, 0, eager_mod_tap_keycode);
+    auto       regular_key       = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({eager_mod_tap_key, regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    eager_mod_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_ALT));
+    EXPECT_REPORT(driver, (KC_LEFT_ALT, KC_A));
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_ALT));
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    eager_mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PerKeySettings, settings_are_looked_up_once_per_press) {
+    TestDriver driver;
+    auto       slow_mod_tap_key = KeymapKey(0, 1, 0, slow_mod_tap_keycode);
+    auto       regular_key      = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({slow_mod_tap_key, regular_key});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    /* Undecided for the whole tapping term, with another key waiting */
+    slow_mod_tap_key.press();
+    run_one_scan_loop();
+    regular_key.press();
+    idle_for(slow_tapping_term - 10);
+    regular_key.release();
+    slow_mod_tap_key.release();
+    idle_for(slow_tapping_term);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(tapping_term_lookups, 1u);
+    EXPECT_EQ(quick_tap_term_lookups, 1u);
+    EXPECT_EQ(permissive_hold_lookups, 1u);
+    /* action.c asks once more when the mod-tap action itself is resolved */
+    EXPECT_EQ(hold_on_other_key_press_lookups, 2u);
+}
+
+TEST_F(PerKeySettings, held_key_throughput) {
+    TestDriver driver;
+    auto       slow_mod_tap_key = KeymapKey(0, 1, 0, slow_mod_tap_keycode);
+
+    set_keymap({slow_mod_tap_key});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    /* Thousands of scans while a key is held and after it has settled cost
+     * no further lookups, however long it is held for */
+    for (unsigned press = 0; press < 10; press++) {
+        slow_mod_tap_key.press();
+        idle_for(5000);
+        slow_mod_tap_key.release();
+        idle_for(slow_tapping_term);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(total_lookups(), 10u * 4);
+}
@@ -13,4 +13,16 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-CUSTOM_MATRIX=yes
\ No newline at end of file
+CUSTOM_MATRIX=yes
+
+# Tests with an info.json get g_led_config, and the tables that go with it,
+# generated from it as keyboards do
+ifneq ("$(wildcard $(TEST_PATH)/info.json)","")
+    SRC += $(TEST_OBJ)/$(TEST)/src/led_config.c
+endif
+
+$(TEST_OBJ)/$(TEST)/src/led_config.c: $(TEST_PATH)/info.json tests/test_common/led_config.py $(LIB_PATH)/python/qmk/led_geometry.py
+	@mkdir -p $(@D)
+	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
+	$(eval CMD=PYTHONPATH=$(LIB_PATH)/python python3 tests/test_common/led_config.py $(TEST_PATH)/info.json $@)
+	@$(BUILD_CMD)
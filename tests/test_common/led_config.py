@@ -0,0 +1,36 @@
+"""Generates g_led_config and its precomputed tables from a test's info.json, the same way `qmk generate-keyboard-c` does for a keyboard.
+"""
+import json
+import sys
+
+from qmk.led_geometry import DEFAULT_CENTER, geometry_lines, neighbor_lines
+
+info_json, output = sys.argv[1:]
+with open(info_json) as f:
+    info_data = json.load(f)
+
+config_type = 'rgb_matrix' if 'rgb_matrix' in info_data else 'led_matrix'
+cols = info_data['matrix_size']['cols']
+rows = info_data['matrix_size']['rows']
+led_layout = info_data[config_type]['layout']
+
+matrix = [[None] * cols for _ in range(rows)]
+for index, led_data in enumerate(led_layout):
+    if 'matrix' in led_data:
+        row, col = led_data['matrix']
+        matrix[row][col] = index
+points = [(led_data.get('x', 0), led_data.get('y', 0)) for led_data in led_layout]
+center = tuple(info_data[config_type].get('center_point', DEFAULT_CENTER))
+
+lines = [f'#include "{config_type}.h"', '#include "progmem.h"', '', 'led_config_t g_led_config = {', '  {']
+lines.extend(f'    {{ {", ".join("NO_LED" if led is None else str(led) for led in line)} }},' for line in matrix)
+lines.append('  },')
+lines.append(f'  {{ {", ".join(f"{{{x}, {y}}}" for x, y in points)} }},')
+lines.append(f'  {{ {", ".join(str(led_data.get("flags", 0)) for led_data in led_layout)} }},')
+lines.append('};')
+if config_type == 'rgb_matrix':
+    lines.extend(geometry_lines(center, points))
+    lines.extend(neighbor_lines(matrix, points))
+
+with open(output, 'w') as f:
+    f.write('\n'.join(lines) + '\n')
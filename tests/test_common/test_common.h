@@ -1,4 +1,9 @@
 #pragma once
 
 #define MATRIX_ROWS 4
-#define MATRIX_COLS 10
\ No newline at end of file
+#define MATRIX_COLS 10
+
+/* Feature headers check their EEPROM layouts with C11 static assertions, which C++ spells differently */
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
@@ -0,0 +1,71 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_lighting_driver.hpp"
+
+extern "C" {
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+#ifdef LED_MATRIX_ENABLE
+#    include "led_matrix.h"
+#endif
+}
+
+#ifdef RGB_MATRIX_ENABLE
+uint8_t            test_rgb_matrix_leds[RGB_MATRIX_LED_COUNT][3];
+std::vector<Frame> test_rgb_matrix_frames;
+
+static void rgb_init(void) {}
+
+static void rgb_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    test_rgb_matrix_leds[index][0] = r;
+    test_rgb_matrix_leds[index][1] = g;
+    test_rgb_matrix_leds[index][2] = b;
+}
+
+static void rgb_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_set_color(i, r, g, b);
+    }
+}
+
+static void rgb_flush(void) {
+    test_rgb_matrix_frames.push_back(Frame(&test_rgb_matrix_leds[0][0], &test_rgb_matrix_leds[0][0] + sizeof(test_rgb_matrix_leds)));
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = rgb_init,
+    .set_color     = rgb_set_color,
+    .set_color_all = rgb_set_color_all,
+    .flush         = rgb_flush,
+};
+#endif
+
+#ifdef LED_MATRIX_ENABLE
+uint8_t            test_led_matrix_leds[LED_MATRIX_LED_COUNT];
+std::vector<Frame> test_led_matrix_frames;
+
+static void led_init(void) {}
+
+static void led_set_value(int index, uint8_t value) {
+    test_led_matrix_leds[index] = value;
+}
+
+static void led_set_value_all(uint8_t value) {
+    for (int i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        led_set_value(i, value);
+    }
+}
+
+static void led_flush(void) {
+    test_led_matrix_frames.push_back(Frame(test_led_matrix_leds, test_led_matrix_leds + sizeof(test_led_matrix_leds)));
+}
+
+const led_matrix_driver_t led_matrix_driver = {
+    .init          = led_init,
+    .set_value     = led_set_value,
+    .set_value_all = led_set_value_all,
+    .flush         = led_flush,
+};
+#endif
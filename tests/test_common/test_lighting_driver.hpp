@@ -0,0 +1,38 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef std::vector<uint8_t> Frame;
+
+/* FNV-1a, for reducing everything an effect renders to a single value */
+inline uint32_t fnv1a(uint32_t hash, const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+inline uint32_t fnv1a(const std::vector<Frame> &frames) {
+    uint32_t hash = 2166136261u;
+    for (auto &frame : frames) {
+        hash = fnv1a(hash, frame.data(), frame.size());
+    }
+    return hash;
+}
+
+/* A custom rgb_matrix or led_matrix driver that keeps every frame it flushes.
+ * Tests that use it add test_lighting_driver.cpp to SRC in their test.mk. */
+#ifdef RGB_MATRIX_ENABLE
+extern uint8_t            test_rgb_matrix_leds[RGB_MATRIX_LED_COUNT][3];
+extern std::vector<Frame> test_rgb_matrix_frames;
+#endif
+
+#ifdef LED_MATRIX_ENABLE
+extern uint8_t            test_led_matrix_leds[LED_MATRIX_LED_COUNT];
+extern std::vector<Frame> test_led_matrix_frames;
+#endif
@@ -0,0 +1,11 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "ws2812.h"
+
+// Whatever rgblight last sent to the strip, for tests built with WS2812_DRIVER = custom
+extern LED_TYPE test_ws2812_leds[RGBLED_NUM];
+extern uint16_t test_ws2812_num_leds;
+extern uint32_t test_ws2812_writes;
@@ -0,0 +1,16 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "ws2812.h"
+#include "test_ws2812.h"
+
+LED_TYPE test_ws2812_leds[RGBLED_NUM];
+uint16_t test_ws2812_num_leds;
+uint32_t test_ws2812_writes;
+
+void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds) {
+    memcpy(test_ws2812_leds, ledarray, number_of_leds * sizeof(LED_TYPE));
+    test_ws2812_num_leds = number_of_leds;
+    test_ws2812_writes++;
+}
@@ -0,0 +1,113 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "action_util.h"
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class TickEvents : public TestFixture {
+   protected:
+    /* Lets anything left over from start up or a previous test run its
+     * course, then returns the count to measure from */
+    uint32_t start_counting() {
+        idle_for(TAPPING_TERM * 10);
+        return get_action_exec_count();
+    }
+
+    uint32_t action_exec_calls_since(uint32_t start) {
+        return get_action_exec_count() - start;
+    }
+};
+
+TEST_F(TickEvents, idle_keyboard_generates_no_ticks) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_NO_REPORT(driver);
+    const uint32_t start = start_counting();
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(action_exec_calls_since(start), 0u);
+}
+
+TEST_F(TickEvents, typing_only_processes_key_events) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    /* Ten taps spread over a second */
+    const uint32_t start = start_counting();
+    for (unsigned tap = 0; tap < 10; tap++) {
+        tap_key(key);
+        idle_for(98);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(action_exec_calls_since(start), 10u * 2);
+}
+
+TEST_F(TickEvents, mod_tap_is_decided_at_tapping_term) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, CTL_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    const uint32_t start = start_counting();
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    /* The only tick is the one at the end of the tapping term */
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(action_exec_calls_since(start), 2u);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TickEvents, oneshot_mods_time_out) {
+    TestDriver driver;
+    auto       osm_key = KeymapKey(0, 0, 0, OSM(MOD_LSFT));
+
+    set_keymap({osm_key});
+
+    const uint32_t start = start_counting();
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(osm_key);
+    EXPECT_EQ(get_oneshot_mods(), MOD_BIT(KC_LEFT_SHIFT));
+    idle_for(ONESHOT_TIMEOUT - 1);
+    EXPECT_EQ(get_oneshot_mods(), MOD_BIT(KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    EXPECT_EQ(get_oneshot_mods(), 0);
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Press and release, a tick at the end of the tapping term started by
+     * each of them, and one at the timeout */
+    EXPECT_EQ(action_exec_calls_since(start), 5u);
+}
@@ -0,0 +1,181 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "via.h"
+#include "raw_hid.h"
+#include "dynamic_keymap.h"
+}
+
+using report_t = std::array<uint8_t, 32>;
+
+static std::vector<report_t> sent_reports;
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    report_t report{};
+    std::copy(data, data + length, report.begin());
+    sent_reports.push_back(report);
+}
+
+static constexpr uint16_t keymap_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+static constexpr uint8_t  payload     = sizeof(report_t) - 2;
+
+static uint16_t crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+class ViaStream : public TestFixture {
+   protected:
+    void SetUp() override {
+        sent_reports.clear();
+    }
+
+    static void receive(report_t report) {
+        raw_hid_receive(report.data(), report.size());
+    }
+
+    static report_t header(uint8_t command_id, uint16_t offset, uint16_t size) {
+        return report_t{command_id, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), (uint8_t)(size >> 8), (uint8_t)(size & 0xFF)};
+    }
+
+    static void expect_trailer(const report_t &report, uint8_t command_id, uint16_t offset, uint16_t size, uint8_t status) {
+        EXPECT_EQ(report[0], command_id);
+        EXPECT_EQ((report[1] << 8) | report[2], offset);
+        EXPECT_EQ((report[3] << 8) | report[4], size);
+        EXPECT_EQ(report[5], status);
+    }
+
+    static uint16_t trailer_crc(const report_t &report) {
+        return (report[6] << 8) | report[7];
+    }
+
+    // Sends a streamed write the same way a host would, without waiting between reports
+    static void stream_write(uint16_t offset, const std::vector<uint8_t> &data) {
+        receive(header(id_dynamic_keymap_set_buffer_stream, offset, data.size()));
+        uint8_t sequence = 0;
+        for (size_t position = 0; position < data.size(); position += payload) {
+            report_t report{id_dynamic_keymap_stream_data, sequence++};
+            std::copy(data.begin() + position, data.begin() + std::min(data.size(), position + payload), report.begin() + 2);
+            receive(report);
+        }
+    }
+
+    static std::vector<uint8_t> pattern(size_t length, uint8_t seed) {
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; i++) {
+            data[i] = (uint8_t)(seed + i * 13);
+        }
+        return data;
+    }
+
+    TestDriver driver;
+};
+
+TEST_F(ViaStream, ReadSendsBackToBackReports) {
+    auto expected = pattern(keymap_size, 0x21);
+    dynamic_keymap_set_buffer(0, keymap_size, expected.data());
+
+    receive(header(id_dynamic_keymap_get_buffer_stream, 0, keymap_size));
+
+    // A single request produces every data report, followed by the trailer
+    size_t data_reports = (keymap_size + payload - 1) / payload;
+    ASSERT_EQ(sent_reports.size(), data_reports + 1);
+
+    std::vector<uint8_t> received;
+    for (size_t i = 0; i < data_reports; i++) {
+        EXPECT_EQ(sent_reports[i][0], id_dynamic_keymap_stream_data);
+        EXPECT_EQ(sent_reports[i][1], (uint8_t)i);
+        received.insert(received.end(), sent_reports[i].begin() + 2, sent_reports[i].end());
+    }
+    received.resize(keymap_size);
+    EXPECT_EQ(received, expected);
+
+    expect_trailer(sent_reports.back(), id_dynamic_keymap_get_buffer_stream, 0, keymap_size, id_stream_ok);
+    EXPECT_EQ(trailer_crc(sent_reports.back()), crc16(expected.data(), expected.size()));
+}
+
+TEST_F(ViaStream, WriteIsAcknowledgedOnlyByHeaderAndTrailer) {
+    auto data = pattern(100, 0x42);
+    stream_write(40, data);
+
+    ASSERT_EQ(sent_reports.size(), 2u);
+    expect_trailer(sent_reports[0], id_dynamic_keymap_set_buffer_stream, 40, data.size(), id_stream_ok);
+    expect_trailer(sent_reports[1], id_dynamic_keymap_set_buffer_stream, 40, data.size(), id_stream_ok);
+    EXPECT_EQ(trailer_crc(sent_reports[1]), crc16(data.data(), data.size()));
+
+    std::vector<uint8_t> stored(data.size());
+    dynamic_keymap_get_buffer(40, stored.size(), stored.data());
+    EXPECT_EQ(stored, data);
+}
+
+TEST_F(ViaStream, RejectsRangeOutsideKeymap) {
+    receive(header(id_dynamic_keymap_get_buffer_stream, keymap_size - 10, 20));
+    ASSERT_EQ(sent_reports.size(), 1u);
+    expect_trailer(sent_reports[0], id_dynamic_keymap_get_buffer_stream, keymap_size - 10, 20, id_stream_invalid_range);
+
+    sent_reports.clear();
+    receive(header(id_dynamic_keymap_set_buffer_stream, 0, 0));
+    ASSERT_EQ(sent_reports.size(), 1u);
+    expect_trailer(sent_reports[0], id_dynamic_keymap_set_buffer_stream, 0, 0, id_stream_invalid_range);
+}
+
+TEST_F(ViaStream, WriteAbortsOnSequenceError) {
+    auto original = pattern(keymap_size, 0x00);
+    dynamic_keymap_set_buffer(0, keymap_size, original.data());
+
+    auto data = pattern(3 * payload, 0x99);
+    receive(header(id_dynamic_keymap_set_buffer_stream, 0, data.size()));
+
+    report_t first{id_dynamic_keymap_stream_data, 0};
+    std::copy(data.begin(), data.begin() + payload, first.begin() + 2);
+    receive(first);
+
+    // Skips sequence number 1
+    report_t skipped{id_dynamic_keymap_stream_data, 2};
+    receive(skipped);
+    receive(skipped);
+
+    // Only the header acknowledgement and a single failure trailer are sent
+    ASSERT_EQ(sent_reports.size(), 2u);
+    expect_trailer(sent_reports[1], id_dynamic_keymap_set_buffer_stream, 0, data.size(), id_stream_bad_sequence);
+
+    std::vector<uint8_t> stored(data.size());
+    dynamic_keymap_get_buffer(0, stored.size(), stored.data());
+    EXPECT_TRUE(std::equal(data.begin(), data.begin() + payload, stored.begin()));
+    EXPECT_TRUE(std::equal(original.begin() + payload, original.begin() + data.size(), stored.begin() + payload));
+}
+
+TEST_F(ViaStream, OtherCommandAbortsWrite) {
+    receive(header(id_dynamic_keymap_set_buffer_stream, 0, 2 * payload));
+    receive(report_t{id_get_protocol_version});
+    ASSERT_EQ(sent_reports.size(), 2u);
+    EXPECT_EQ(sent_reports[1][0], id_get_protocol_version);
+
+    // Data for the aborted write is dropped without a response
+    receive(report_t{id_dynamic_keymap_stream_data, 0});
+    EXPECT_EQ(sent_reports.size(), 2u);
+}
+
+TEST_F(ViaStream, MatchesPerReportBuffer) {
+    auto data = pattern(keymap_size, 0x5A);
+    stream_write(0, data);
+
+    // The legacy request/response interface sees the streamed data
+    report_t request{id_dynamic_keymap_get_buffer, 0x00, 0x20, 28};
+    sent_reports.clear();
+    receive(request);
+    ASSERT_EQ(sent_reports.size(), 1u);
+    EXPECT_TRUE(std::equal(data.begin() + 0x20, data.begin() + 0x20 + 28, sent_reports[0].begin() + 4));
+}
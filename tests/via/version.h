@@ -0,0 +1,10 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Stands in for the generated version.h, which isn't produced for tests
+
+#pragma once
+
+#define QMK_VERSION "test"
+#define QMK_BUILDDATE "2023-01-01-00:00:00"
+#define QMK_GIT_HASH "test"
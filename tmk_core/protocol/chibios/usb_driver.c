@@ -25,6 +25,9 @@
 #include <hal.h>
 #include "usb_driver.h"
 #include <string.h>
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle.h"
+#endif
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -447,6 +450,10 @@ void qmkusbDataReceived(USBDriver *usbp, usbep_t ep) {
     (void)qmkusb_start_receive(qmkusbp);
 
     osalSysUnlockFromISR();
+
+#ifdef IDLE_SLEEP_ENABLE
+    idle_wakeup();
+#endif
 }
 
 /**
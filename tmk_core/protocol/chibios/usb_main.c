@@ -39,6 +39,9 @@
 #    include "sleep_led.h"
 #    include "led.h"
 #endif
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle.h"
+#endif
 #include "wait.h"
 #include "usb_device_state.h"
 #include "usb_descriptor.h"
@@ -500,6 +503,10 @@ void usb_event_queue_task(void) {
 /* Handles the USB driver global events
  * TODO: maybe disable some things when connection is lost? */
 static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
+#ifdef IDLE_SLEEP_ENABLE
+    idle_wakeup();
+#endif
+
     switch (event) {
         case USB_EVENT_ADDRESS:
             return;
@@ -604,6 +611,10 @@ static void set_led_transfer_cb(USBDriver *usbp) {
     } else {
         keyboard_led_state = set_report_buf[0];
     }
+
+#ifdef IDLE_SLEEP_ENABLE
+    idle_wakeup();
+#endif
 }
 
 /* Callback for SETUP request on the endpoint 0 (control) */
@@ -125,7 +125,7 @@ void eeconfig_init_user(void) {
     set_unicode_input_mode(CURRY_UNICODE_MODE);
     get_unicode_input_mode();
 #else
-    eeprom_update_byte(EECONFIG_UNICODEMODE, CURRY_UNICODE_MODE);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, CURRY_UNICODE_MODE);
 #endif
     eeconfig_init_keymap();
     keyboard_init();
@@ -2,6 +2,7 @@
 #define LIGHTS_H
 
 #include "eeprom.h"
+#include "eeconfig.h"
 #include "tap_dance.h"
 #include "zer09.h"
 